@@ -0,0 +1,90 @@
+#include "ContratException.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// ArbreFenwick.h
+#ifndef ARBREFENWICK_H
+#define ARBREFENWICK_H
+
+namespace TP {
+
+    /**
+     * @brief arbre de Fenwick (arbre binaire indexé) sur des valeurs positives : modifier une
+     * valeur, lire le total ou trouver la case où tombe un cumul coûtent O(log n).
+     *
+     * la taille grandit au besoin ; l'arbre est alors reconstruit en O(n), ce qui reste amorti
+     * en O(1) par case puisque la taille double.
+     */
+    class ArbreFenwick {
+    public:
+        explicit ArbreFenwick(size_t taille = 0) : m_valeurs(taille, 0), m_arbre(taille + 1, 0), m_total(0) {}
+
+        size_t taille() const { return m_valeurs.size(); }
+        int64_t total() const { return m_total; }
+        int64_t valeur(size_t i) const { return m_valeurs[i]; }
+
+        // \pre valeur >= 0
+        void modifier(size_t i, int64_t valeur) {
+            PRECONDITION(valeur >= 0);
+            if (i >= m_valeurs.size()) {
+                agrandir(max(i + 1, m_valeurs.size() * 2));
+            }
+            int64_t delta = valeur - m_valeurs[i];
+            m_valeurs[i] = valeur;
+            m_total += delta;
+            for (size_t k = i + 1; k < m_arbre.size(); k += k & (~k + 1)) {
+                m_arbre[k] += delta;
+            }
+        }
+
+        /**
+         * case où tombe le cumul : la plus petite case i telle que la somme des cases 0 à i
+         * dépasse strictement cumul.
+         * \pre 0 <= cumul < total()
+         */
+        size_t chercher(int64_t cumul) const {
+            PRECONDITION(cumul >= 0 && cumul < m_total);
+            size_t position = 0;
+            for (size_t pas = bitFort(m_valeurs.size()); pas > 0; pas >>= 1) {
+                size_t suivante = position + pas;
+                if (suivante < m_arbre.size() && m_arbre[suivante] <= cumul) {
+                    position = suivante;
+                    cumul -= m_arbre[suivante];
+                }
+            }
+            return position; // case d'indice position + 1 dans l'arbre, numérotée à partir de 1
+        }
+
+    private:
+        static size_t bitFort(size_t n) {
+            size_t bit = 1;
+            while (bit <= n / 2) {
+                bit <<= 1;
+            }
+            return n == 0 ? 0 : bit;
+        }
+
+        // reconstruction en O(n) : chaque nœud reporte son cumul sur son parent
+        [[gnu::noinline, gnu::cold]] void agrandir(size_t taille) {
+            m_valeurs.resize(taille, 0);
+            m_arbre.assign(taille + 1, 0);
+            for (size_t k = 1; k <= taille; ++k) {
+                m_arbre[k] += m_valeurs[k - 1];
+                size_t parent = k + (k & (~k + 1));
+                if (parent <= taille) {
+                    m_arbre[parent] += m_arbre[k];
+                }
+            }
+        }
+
+        vector<int64_t> m_valeurs;
+        vector<int64_t> m_arbre;    // m_arbre[k] : somme des valeurs des cases ]k - (k & -k), k]
+        int64_t m_total;
+    };
+
+} // namespace TP
+
+#endif // ARBREFENWICK_H
@@ -0,0 +1,51 @@
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+using namespace std;
+
+// Arguments.h
+#ifndef ARGUMENTS_H
+#define ARGUMENTS_H
+
+namespace TP {
+
+    /**
+     * @brief lit un nombre donné en argument de ligne de commande, comme les champs d'une trace
+     * (voir analyserLigneTrace) : le texte entier doit être le nombre, sans blanc ni caractère en
+     * trop, et la valeur doit être dans [min, max].
+     * @return false, sans modifier valeur, si le texte n'est pas un tel nombre.
+     */
+    template<typename T>
+    bool lireNombre(string_view texte, T& valeur, T min = numeric_limits<T>::lowest(),
+                    T max = numeric_limits<T>::max()) {
+        const char* fin = texte.data() + texte.size();
+        T lu{};
+        auto [suite, erreur] = from_chars(texte.data(), fin, lu);
+        // écrit ainsi, le test refuse aussi NaN
+        if (erreur != errc() || suite != fin || !(lu >= min && lu <= max)) {
+            return false;
+        }
+        valeur = lu;
+        return true;
+    }
+
+    /**
+     * @brief lit un compte entier qui peut s'écrire en notation scientifique ("1e9").
+     * @return false, sans modifier valeur, si le texte n'est pas un entier de [min, max].
+     */
+    inline bool lireCompte(string_view texte, uint64_t& valeur, uint64_t min = 0,
+                           uint64_t max = uint64_t(1) << 53) {
+        double lu = 0.0;
+        if (!lireNombre(texte, lu, static_cast<double>(min), static_cast<double>(max)) || lu != floor(lu)) {
+            return false;
+        }
+        valeur = static_cast<uint64_t>(lu);
+        return true;
+    }
+
+} // namespace TP
+
+#endif // ARGUMENTS_H
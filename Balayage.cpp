@@ -0,0 +1,323 @@
+#include "Balayage.h"
+#include "Moteur.h"
+#include "Politiques.h"
+#include "Flux.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include "ContratModule.h"
+
+namespace {
+
+    // rang (à partir de 0) du 99e centile parmi n valeurs triées, méthode du rang le plus proche
+    size_t rangP99(size_t n) {
+        return (99 * n + 99) / 100 - 1;
+    }
+
+    double centile99(vector<int32_t>& valeurs) {
+        if (valeurs.empty()) {
+            return 0.0;
+        }
+        auto it = valeurs.begin() + rangP99(valeurs.size());
+        nth_element(valeurs.begin(), it, valeurs.end());
+        return *it;
+    }
+
+    /**
+     * @brief puits qui relève l'attente et la rotation de chaque processus terminé.
+     *
+     * avec une borne, il demande l'arrêt dès que la mesure finale est sûrement pire que la borne :
+     * une somme partielle divisée par le nombre total de processus minore la moyenne finale, et
+     * le 99e centile dépasse la borne dès que plus de 1 % des valeurs la dépassent.
+     */
+    class PuitsMesure : public TP::PuitsProcessus {
+    public:
+        PuitsMesure(size_t nbProcessus, TP::CritereQuantum critere, const atomic<double>* borne)
+            : m_nbProcessus(nbProcessus), m_critere(critere), m_borne(borne) {
+            m_attentes.reserve(nbProcessus);
+            m_rotations.reserve(nbProcessus);
+        }
+
+        void recevoir(const TP::TableProcessus& table, TP::IdProcessus id) override {
+            int32_t attente = table.attente(id);
+            int32_t rotation = table.fin(id) - table.arrivee(id);
+            m_attentes.push_back(attente);
+            m_rotations.push_back(rotation);
+            m_sommeAttentes += attente;
+            m_sommeRotations += rotation;
+
+            if (m_borne != nullptr) {
+                double borne = m_borne->load(memory_order_relaxed);
+                // la borne ne fait que baisser : une valeur comptée reste au-dessus
+                int32_t valeur = (m_critere == TP::ATTENTE_P99) ? attente : rotation;
+                if (valeur > borne) {
+                    ++m_auDessus;
+                }
+                m_abandon = depasse(borne);
+            }
+        }
+
+        bool arreter() const override { return m_abandon; }
+
+        TP::MesureQuantum mesure(int quantum) {
+            TP::MesureQuantum m{quantum, 0.0, 0.0, 0.0, 0.0, m_abandon};
+            if (!m_abandon && m_nbProcessus > 0) {
+                m.attenteMoyenne = static_cast<double>(m_sommeAttentes) / m_nbProcessus;
+                m.rotationMoyenne = static_cast<double>(m_sommeRotations) / m_nbProcessus;
+                m.attenteP99 = centile99(m_attentes);
+                m.rotationP99 = centile99(m_rotations);
+            }
+            return m;
+        }
+
+    private:
+        bool depasse(double borne) const {
+            switch (m_critere) {
+                case TP::ATTENTE_MOYENNE:
+                    return m_sommeAttentes > borne * m_nbProcessus;
+                case TP::ROTATION_MOYENNE:
+                    return m_sommeRotations > borne * m_nbProcessus;
+                case TP::ATTENTE_P99:
+                case TP::ROTATION_P99:
+                    return m_auDessus >= m_nbProcessus - rangP99(m_nbProcessus);
+            }
+            return false;
+        }
+
+        size_t m_nbProcessus;
+        TP::CritereQuantum m_critere;
+        const atomic<double>* m_borne;   // meilleure mesure connue, nullptr pour tout simuler
+        vector<int32_t> m_attentes;
+        vector<int32_t> m_rotations;
+        int64_t m_sommeAttentes = 0;
+        int64_t m_sommeRotations = 0;
+        size_t m_auDessus = 0;           // valeurs du critère au-dessus de la borne
+        bool m_abandon = false;
+    };
+
+    // avec un instantané de départ, seule la suite de la simulation est simulée ; les processus
+    // terminés avant lui sont mesurés sans être simulés à nouveau
+    TP::MesureQuantum mesurer(const shared_ptr<const TP::TableProcessus>& charge, const string& politique,
+                              int quantum, TP::CritereQuantum critere, const atomic<double>* borne,
+                              const TP::CoutsCommutation& couts, const TP::Instantane* depart = nullptr) {
+        TP::TableProcessus table = TP::TableProcessus::partager(charge);
+        PuitsMesure puits(table.taille(), critere, borne);
+        int temps = 0;
+        int64_t commutation = 0;
+        bool repris = true;
+        bool connue = TP::avecPolitique(politique, table, quantum, [&](auto& file) {
+            TP::MoteurGenerique moteur(table, file);
+            moteur.setCouts(couts);
+            if (depart != nullptr) {
+                repris = moteur.reprendre(*depart, TP::prolonge(politique, quantum, *depart));
+                if (!repris) {
+                    return;
+                }
+                for (const TP::EtatProcessus& e : depart->termines) {
+                    puits.recevoir(table, e.id);
+                }
+                temps = depart->temps;
+            }
+            moteur.executer(puits, temps);
+            commutation = moteur.tempsCommutation();
+        });
+        PRECONDITION(connue && repris);
+        TP::MesureQuantum m = puits.mesure(quantum);
+        if (temps > 0) {
+            m.commutation = static_cast<double>(commutation) / temps;
+        }
+        return m;
+    }
+
+    // abaisse la borne partagée si la mesure est meilleure
+    void abaisser(atomic<double>& borne, double valeur) {
+        double courante = borne.load();
+        while (valeur < courante && !borne.compare_exchange_weak(courante, valeur)) {
+        }
+    }
+
+    // au plus n quanta distincts de [bas, haut], bornes comprises, espacés géométriquement si
+    // l'intervalle couvre plusieurs ordres de grandeur
+    vector<int> grille(int bas, int haut, size_t n) {
+        vector<int> points;
+        bool geometrique = haut >= 4 * bas;
+        for (size_t k = 0; k < n; ++k) {
+            double t = (n == 1) ? 0.0 : static_cast<double>(k) / (n - 1);
+            double q = geometrique ? bas * pow(static_cast<double>(haut) / bas, t) : bas + t * (haut - bas);
+            points.push_back(static_cast<int>(lround(q)));
+        }
+        points.erase(unique(points.begin(), points.end()), points.end());
+        return points;
+    }
+
+} // namespace
+
+double TP::valeurCritere(const MesureQuantum& mesure, CritereQuantum critere) {
+    switch (critere) {
+        case ATTENTE_MOYENNE:
+            return mesure.attenteMoyenne;
+        case ATTENTE_P99:
+            return mesure.attenteP99;
+        case ROTATION_MOYENNE:
+            return mesure.rotationMoyenne;
+        case ROTATION_P99:
+            return mesure.rotationP99;
+    }
+    return 0.0;
+}
+
+bool TP::lireCritere(const string& nom, CritereQuantum& critere) {
+    static const pair<const char*, CritereQuantum> NOMS[] = {
+        {"attente_moyenne", ATTENTE_MOYENNE}, {"attente_p99", ATTENTE_P99},
+        {"rotation_moyenne", ROTATION_MOYENNE}, {"rotation_p99", ROTATION_P99}};
+    for (const auto& [texte, valeur] : NOMS) {
+        if (nom == texte) {
+            critere = valeur;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief simule la politique une fois et mesure l'attente et la rotation des processus.
+ * @param charge processus à simuler, partagés en lecture seule.
+ * @param politique nom de la politique (voir creerPolitique).
+ * @param quantum quantum de temps des politiques à quantum (voir utiliseQuantum).
+ * @param couts coûts des commutations de contexte.
+ */
+TP::MesureQuantum TP::mesurerPolitique(shared_ptr<const TableProcessus> charge, const string& politique,
+                                       int quantum, const CoutsCommutation& couts) {
+    PRECONDITION(charge != nullptr);
+    return mesurer(charge, politique, quantum, ATTENTE_MOYENNE, nullptr, couts);
+}
+
+/**
+ * @brief simule la politique pour chaque quantum.
+ * @param charge processus à simuler, partagés en lecture seule par toutes les simulations.
+ * @param politique nom de la politique (voir creerPolitique).
+ * @param quanta quanta à essayer.
+ * @param pool fils qui exécutent les simulations.
+ * @param couts coûts des commutations de contexte.
+ * \pre chaque quantum est positif
+ */
+vector<TP::MesureQuantum> TP::balayerQuanta(shared_ptr<const TableProcessus> charge, const string& politique,
+                                            const vector<int>& quanta, PoolFils& pool, const CoutsCommutation& couts) {
+    PRECONDITION(charge != nullptr);
+    PRECONDITION(all_of(quanta.begin(), quanta.end(), [](int q) { return q > 0; }));
+
+    vector<MesureQuantum> mesures(quanta.size());
+    pool.executer(quanta.size(), [&](size_t i) {
+        mesures[i] = mesurer(charge, politique, quanta[i], ATTENTE_MOYENNE, nullptr, couts);
+    });
+    return mesures;
+}
+
+/**
+ * @brief simule chaque branche à partir de l'instantané, en parallèle sur le pool.
+ * @param instantane point de départ commun, partagé en lecture seule avec sa charge.
+ * @param branches politique et quantum de chaque branche.
+ * @param pool fils qui exécutent les branches.
+ * @param couts coûts des commutations de contexte des branches.
+ * \pre instantane a une charge
+ * \pre chaque politique est connue (voir creerPolitique)
+ * \pre l'état de la politique de l'instantané est valide, comme celui d'un instantané pris par
+ * Ordonnanceur::instantanes
+ */
+vector<TP::MesureQuantum> TP::mesurerBranches(shared_ptr<const Instantane> instantane, const vector<Branche>& branches,
+                                              PoolFils& pool, const CoutsCommutation& couts) {
+    PRECONDITION(instantane != nullptr && instantane->charge != nullptr);
+
+    vector<MesureQuantum> mesures(branches.size());
+    pool.executer(branches.size(), [&](size_t i) {
+        mesures[i] = mesurer(instantane->charge, branches[i].politique, branches[i].quantum, ATTENTE_MOYENNE, nullptr,
+                             couts, instantane.get());
+    });
+    return mesures;
+}
+
+/**
+ * @brief cherche le meilleur quantum de [qmin, qmax] pour le critère.
+ * @param charge processus à simuler, partagés en lecture seule par toutes les simulations.
+ * @param politique nom de la politique (voir creerPolitique).
+ * @param qmin plus petit quantum essayé.
+ * @param qmax plus grand quantum essayé.
+ * @param critere mesure à minimiser.
+ * @param pool fils qui exécutent les simulations.
+ * @param essais simulations lancées, triées par quantum.
+ * @param couts coûts des commutations de contexte.
+ * \pre 0 < qmin <= qmax
+ */
+TP::MesureQuantum TP::ajusterQuantum(shared_ptr<const TableProcessus> charge, const string& politique,
+                                     int qmin, int qmax, CritereQuantum critere, PoolFils& pool,
+                                     vector<MesureQuantum>& essais, const CoutsCommutation& couts) {
+    PRECONDITION(charge != nullptr);
+    PRECONDITION(0 < qmin && qmin <= qmax);
+
+    // une grille assez fine pour ne pas manquer un creux étroit, et au moins un quantum par fil
+    const size_t parTour = max<size_t>(16, pool.nbFils());
+    atomic<double> borne(numeric_limits<double>::infinity());
+    map<int, MesureQuantum> vus;
+    int bas = qmin;
+    int haut = qmax;
+
+    while (true) {
+        bool dernierTour = static_cast<size_t>(haut - bas) + 1 <= parTour;
+        vector<int> quanta;
+        for (int q : dernierTour ? grille(bas, haut, haut - bas + 1) : grille(bas, haut, parTour)) {
+            if (vus.count(q) == 0) {
+                quanta.push_back(q);
+            }
+        }
+
+        vector<MesureQuantum> mesures(quanta.size());
+        pool.executer(quanta.size(), [&](size_t i) {
+            mesures[i] = mesurer(charge, politique, quanta[i], critere, &borne, couts);
+            if (!mesures[i].abandonnee) {
+                abaisser(borne, valeurCritere(mesures[i], critere));
+            }
+        });
+        for (const MesureQuantum& m : mesures) {
+            vus[m.quantum] = m;
+        }
+        if (dernierTour) {
+            break;
+        }
+
+        // resserrer l'intervalle entre les deux voisins du meilleur quantum essayé
+        auto debut = vus.lower_bound(bas);
+        auto fin = vus.upper_bound(haut);
+        auto meilleur = fin;
+        for (auto it = debut; it != fin; ++it) {
+            if (!it->second.abandonnee
+                && (meilleur == fin || valeurCritere(it->second, critere) < valeurCritere(meilleur->second, critere))) {
+                meilleur = it;
+            }
+        }
+        if (meilleur == fin) {
+            break; // toutes les simulations du tour ont été abandonnées
+        }
+        int nouveauBas = (meilleur == debut) ? meilleur->first : prev(meilleur)->first;
+        int nouveauHaut = (next(meilleur) == fin) ? meilleur->first : next(meilleur)->first;
+        if (nouveauBas == bas && nouveauHaut == haut) {
+            break; // grille trop clairsemée pour resserrer davantage
+        }
+        bas = nouveauBas;
+        haut = nouveauHaut;
+    }
+
+    essais.clear();
+    MesureQuantum meilleure{0, 0.0, 0.0, 0.0, 0.0, true};
+    for (const auto& [q, m] : vus) {
+        essais.push_back(m);
+        if (!m.abandonnee && (meilleure.abandonnee || valeurCritere(m, critere) < valeurCritere(meilleure, critere))) {
+            meilleure = m;
+        }
+    }
+    POSTCONDITION(!meilleure.abandonnee);
+    return meilleure;
+}
@@ -0,0 +1,90 @@
+#include "TableProcessus.h"
+#include "Moteur.h"
+#include "Instantane.h"
+#include "PoolFils.h"
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Balayage.h
+#ifndef BALAYAGE_H
+#define BALAYAGE_H
+
+namespace TP {
+
+    // critère minimisé par l'ajustement du quantum
+    enum CritereQuantum {
+        ATTENTE_MOYENNE,
+        ATTENTE_P99,
+        ROTATION_MOYENNE,   // rotation : temps entre l'arrivée et la fin d'un processus
+        ROTATION_P99
+    };
+
+    // mesures d'une simulation pour un quantum
+    struct MesureQuantum {
+        int quantum;
+        double attenteMoyenne;
+        double attenteP99;
+        double rotationMoyenne;
+        double rotationP99;
+        bool abandonnee;    // simulation interrompue : elle ne pouvait plus battre le meilleur quantum
+        double commutation = 0.0;   // part du temps simulé perdue en commutations (voir CoutsCommutation)
+    };
+
+    double valeurCritere(const MesureQuantum& mesure, CritereQuantum critere);
+
+    // "attente_moyenne", "attente_p99", "rotation_moyenne" ou "rotation_p99"
+    bool lireCritere(const string& nom, CritereQuantum& critere);
+
+    // simule une fois la politique sur la charge, partagée en lecture seule, et la mesure
+    MesureQuantum mesurerPolitique(shared_ptr<const TableProcessus> charge, const string& politique, int quantum,
+                                   const CoutsCommutation& couts = {});
+
+    /**
+     * @brief simule la politique une fois par quantum, en parallèle sur le pool.
+     *
+     * toutes les simulations partagent la même charge en lecture seule (TableProcessus::partager).
+     * Avec des coûts de commutation, un petit quantum paie plus de commutations : les mesures
+     * tiennent compte du débit perdu.
+     * @return une mesure par quantum, dans l'ordre de quanta.
+     */
+    vector<MesureQuantum> balayerQuanta(shared_ptr<const TableProcessus> charge, const string& politique,
+                                        const vector<int>& quanta, PoolFils& pool, const CoutsCommutation& couts = {});
+
+    // branche simulée à partir d'un instantané
+    struct Branche {
+        string politique;
+        int quantum;
+    };
+
+    /**
+     * @brief simule des branches repartant du même instantané, chacune avec sa politique et son
+     * quantum (voir MoteurGenerique::reprendre) ; une branche de la politique et du quantum de
+     * l'instantané prolonge exactement sa simulation.
+     *
+     * la charge et l'instantané sont partagés en lecture seule par toutes les branches ; chacune
+     * n'alloue que les colonnes que sa simulation modifie, et ne simule que la suite de l'instantané.
+     * @return une mesure par branche, dans l'ordre de branches ; l'attente et la rotation comptent
+     * tous les processus, ceux terminés avant l'instantané compris.
+     */
+    vector<MesureQuantum> mesurerBranches(shared_ptr<const Instantane> instantane, const vector<Branche>& branches,
+                                          PoolFils& pool, const CoutsCommutation& couts = {});
+
+    /**
+     * @brief cherche le quantum de [qmin, qmax] qui minimise le critère.
+     *
+     * chaque tour simule en parallèle une grille de quanta, puis resserre l'intervalle autour
+     * du meilleur ; le dernier tour essaie tous les quanta restants. La recherche est locale :
+     * elle suppose la mesure à peu près unimodale entre deux points de la grille. Une simulation
+     * est abandonnée dès que sa mesure ne peut plus descendre sous celle du meilleur quantum connu.
+     * @param essais toutes les simulations lancées, triées par quantum.
+     * @return la mesure du meilleur quantum.
+     */
+    MesureQuantum ajusterQuantum(shared_ptr<const TableProcessus> charge, const string& politique,
+                                 int qmin, int qmax, CritereQuantum critere, PoolFils& pool,
+                                 vector<MesureQuantum>& essais, const CoutsCommutation& couts = {});
+
+} // namespace TP
+
+#endif // BALAYAGE_H
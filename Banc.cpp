@@ -0,0 +1,299 @@
+#include "ContratException.h"
+#include "Arguments.h"
+#include "Generateur.h"
+#include "Moteur.h"
+#include "Multiprocesseur.h"
+#include "Politiques.h"
+#include "TableProcessus.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ContratModule.h"
+using namespace std;
+
+/**
+ * \file Banc.cpp
+ * \brief banc d'essai des politiques d'ordonnancement.
+ *
+ * chaque cas (politique, nombre de processus) est mesuré dans un processus fils créé par fork() :
+ * le pic de mémoire résidente (getrusage) est ainsi celui du cas seul, et un cas ne profite pas
+ * de la mémoire déjà chauffée par le précédent. Les allocations sont comptées en remplaçant
+ * l'opérateur new global de l'exécutable.
+ */
+
+namespace {
+
+    atomic<size_t> g_allocations{0};
+
+} // namespace
+
+void* operator new(size_t taille) {
+    g_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(taille == 0 ? 1 : taille)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+namespace {
+
+    // mesures d'un cas, transmises du fils au père par un tube
+    struct Mesure {
+        double secondes;
+        size_t elections;
+        size_t allocations;
+        long rssMaxKo;
+        bool valide;
+    };
+
+    struct Options {
+        vector<size_t> tailles = {1000, 10000, 100000, 1000000, 10000000};
+        vector<string> politiques = TP::nomsPolitiques();
+        int quantum = 4;
+        uint64_t graine = 1;
+        string format = "texte";  // texte, csv ou json
+        bool virtuel = false;     // moteur à politique choisie à l'exécution plutôt que spécialisé
+        int processeurs = 1;      // au-delà d'un, moteur multiprocesseur avec une file par processeur
+        long rssMaxKo = 0;        // pic de mémoire au-delà duquel un cas échoue, 0 pour aucune limite
+    };
+
+    /**
+     * @brief charge de travail de référence : arrivées de Poisson, durées exponentielles de moyenne
+     * 10 et charge de 90 % ; types et priorités uniformes. Les pids suivent l'ordre d'arrivée.
+     */
+    void genererCharge(size_t n, uint64_t graine, TP::TableProcessus& table) {
+        TP::ParametresCharge parametres;
+        parametres.nbProcessus = n;
+        parametres.graine = graine;
+        parametres.taux = 0.09;
+        parametres.dureeMoyenne = 10.0;
+
+        TP::GenerateurCharge generateur(parametres);
+        TP::LigneTrace l;
+        table.reserver(n);
+        while (generateur.suivant(l)) {
+            table.ajouter(l.pid, l.arrivee, l.duree, l.priorite, l.type);
+        }
+    }
+
+    // mesure un cas dans le processus courant ; la génération de la charge n'est pas chronométrée
+    Mesure mesurerCas(const string& politique, size_t n, const Options& options) {
+        TP::TableProcessus table;
+        genererCharge(n, options.graine, table);
+
+        size_t allocations = g_allocations.load();
+        auto debut = chrono::steady_clock::now();
+        int temps = 0;
+        vector<TP::IdProcessus> termines;
+        size_t elections = 0;
+        if (options.processeurs > 1) {
+            vector<unique_ptr<TP::FilePrete>> files;
+            for (int p = 0; p < options.processeurs; ++p) {
+                files.push_back(TP::creerPolitique(politique, table, options.quantum, n / options.processeurs + 1));
+            }
+            TP::SansEquilibrage equilibreur;
+            TP::MoteurMultiprocesseur moteur(table, std::move(files), equilibreur);
+            termines = moteur.executer(temps);
+            for (size_t p = 0; p < moteur.nbProcesseurs(); ++p) {
+                elections += moteur.statistiques(p).nbElections;
+            }
+        } else if (options.virtuel) {
+            unique_ptr<TP::FilePrete> file = TP::creerPolitique(politique, table, options.quantum);
+            TP::Moteur moteur(table, *file);
+            termines = moteur.executer(temps);
+            elections = moteur.nbElections();
+        } else {
+            TP::avecPolitique(politique, table, options.quantum, [&](auto& file) {
+                TP::MoteurGenerique moteur(table, file);
+                termines = moteur.executer(temps);
+                elections = moteur.nbElections();
+            });
+        }
+        auto fin = chrono::steady_clock::now();
+
+        Mesure m;
+        m.secondes = chrono::duration<double>(fin - debut).count();
+        m.elections = elections;
+        m.allocations = g_allocations.load() - allocations;
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        m.rssMaxKo = usage.ru_maxrss;
+        m.valide = termines.size() == n && (options.rssMaxKo == 0 || m.rssMaxKo <= options.rssMaxKo);
+        return m;
+    }
+
+    // exécute le cas dans un processus fils et récupère ses mesures
+    Mesure mesurerIsole(const string& politique, size_t n, const Options& options) {
+        Mesure m{};
+        int tube[2];
+        if (pipe(tube) != 0) {
+            return m;
+        }
+        cout.flush();
+        pid_t fils = fork();
+        if (fils == 0) {
+            close(tube[0]);
+            Mesure mesure = mesurerCas(politique, n, options);
+            ssize_t ecrits = write(tube[1], &mesure, sizeof mesure);
+            _exit(ecrits == static_cast<ssize_t>(sizeof mesure) ? 0 : 1);
+        }
+        close(tube[1]);
+        if (fils > 0) {
+            if (read(tube[0], &m, sizeof m) != static_cast<ssize_t>(sizeof m)) {
+                m.valide = false;
+            }
+            waitpid(fils, nullptr, 0);
+        }
+        close(tube[0]);
+        return m;
+    }
+
+    // une option dont la valeur est invalide est rapportée avec elle
+    bool lireOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            string option = argv[i];
+            bool valide = true;
+            if (option == "--csv" || option == "--json") {
+                options.format = option.substr(2);
+            } else if (i + 1 < argc && option == "--tailles") {
+                options.tailles.clear();
+                stringstream flux(argv[++i]);
+                string element;
+                uint64_t taille = 0;
+                while (valide && getline(flux, element, ',')) {
+                    valide = TP::lireCompte(element, taille, 1);
+                    options.tailles.push_back(taille);
+                }
+            } else if (i + 1 < argc && option == "--politiques") {
+                options.politiques.clear();
+                stringstream flux(argv[++i]);
+                string element;
+                while (getline(flux, element, ',')) {
+                    options.politiques.push_back(element);
+                }
+            } else if (i + 1 < argc && option == "--quantum") {
+                valide = TP::lireNombre(string_view(argv[++i]), options.quantum, 1);
+            } else if (i + 1 < argc && option == "--moteur") {
+                string moteur = argv[++i];
+                if (moteur != "virtuel" && moteur != "specialise") {
+                    return false;
+                }
+                options.virtuel = (moteur == "virtuel");
+            } else if (i + 1 < argc && option == "--processeurs") {
+                valide = TP::lireNombre(string_view(argv[++i]), options.processeurs, 1);
+            } else if (i + 1 < argc && option == "--rss-max") {
+                valide = TP::lireNombre(string_view(argv[++i]), options.rssMaxKo, 0L);
+            } else if (i + 1 < argc && option == "--graine") {
+                valide = TP::lireNombre(string_view(argv[++i]), options.graine);
+            } else {
+                return false;
+            }
+            if (!valide) {
+                cerr << "erreur : option " << option << " " << argv[i] << " invalide." << endl;
+                return false;
+            }
+        }
+        const vector<string>& connus = TP::nomsPolitiques();
+        for (const string& p : options.politiques) {
+            if (find(connus.begin(), connus.end(), p) == connus.end()) {
+                return false;
+            }
+        }
+        return options.quantum > 0 && options.processeurs > 0 && options.rssMaxKo >= 0;
+    }
+
+} // namespace
+
+/**
+ * @brief fonction principale du banc d'essai
+ *
+ * options : --tailles 1e3,1e5 --politiques rr,sjf --quantum 4 --graine 1, et --csv ou --json
+ * pour une sortie lisible par un programme (comparaison entre deux versions). --moteur virtuel
+ * mesure le moteur à politique choisie à l'exécution au lieu du moteur spécialisé.
+ * --processeurs 256 mesure le moteur multiprocesseur avec une file par processeur, et --rss-max
+ * fait échouer un cas dont le pic de mémoire dépasse la limite en Ko : la mémoire des files doit
+ * suivre les processus présents, pas le nombre de processeurs fois la taille de la table.
+ *
+ * @return 0 si tous les cas sont mesurés (sous la limite de mémoire), 1 sinon
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!lireOptions(argc, argv, options)) {
+        cerr << "usage : " << argv[0] << " [--tailles n1,n2,...] [--politiques p1,p2,...] [--quantum q]"
+             << " [--graine g] [--moteur specialise|virtuel] [--processeurs n] [--rss-max ko] [--csv | --json]"
+             << endl;
+        return 1;
+    }
+#ifndef __OPTIMIZE__
+    cerr << "attention : banc compile sans optimisation (CMAKE_BUILD_TYPE=Release recommande)" << endl;
+#endif
+#if CONTRAT_NIVEAU_EFFECTIF > 0
+    cerr << "attention : contrats verifies (niveau " << CONTRAT_NIVEAU_EFFECTIF << "), leur cout est inclus dans les mesures"
+         << endl;
+#endif
+
+    if (options.format == "csv") {
+        cout << "politique,processus,secondes,ns_processus,ns_election,elections,rss_max_ko,allocations\n";
+    } else if (options.format == "json") {
+        cout << "[\n";
+    } else {
+        cout << left << setw(22) << "politique" << right << setw(10) << "processus" << setw(12) << "temps (ms)"
+             << setw(14) << "ns/processus" << setw(14) << "ns/election" << setw(14) << "RSS max (Ko)"
+             << setw(13) << "allocations" << "\n";
+    }
+
+    bool succes = true;
+    bool premier = true;
+    for (size_t n : options.tailles) {
+        for (const string& politique : options.politiques) {
+            Mesure m = mesurerIsole(politique, n, options);
+            succes = succes && m.valide;
+            double nsProcessus = m.secondes * 1e9 / max<size_t>(n, 1);
+            double nsElection = m.secondes * 1e9 / max<size_t>(m.elections, 1);
+
+            if (options.format == "csv") {
+                cout << politique << ',' << n << ',' << m.secondes << ',' << nsProcessus << ',' << nsElection << ','
+                     << m.elections << ',' << m.rssMaxKo << ',' << m.allocations << "\n";
+            } else if (options.format == "json") {
+                cout << (premier ? "" : ",\n") << "  {\"politique\": \"" << politique << "\", \"processus\": " << n
+                     << ", \"secondes\": " << m.secondes << ", \"ns_processus\": " << nsProcessus
+                     << ", \"ns_election\": " << nsElection << ", \"elections\": " << m.elections
+                     << ", \"rss_max_ko\": " << m.rssMaxKo << ", \"allocations\": " << m.allocations
+                     << ", \"valide\": " << (m.valide ? "true" : "false") << "}";
+            } else {
+                cout << left << setw(22) << politique << right << setw(10) << n << fixed << setprecision(1)
+                     << setw(12) << m.secondes * 1e3 << setw(14) << nsProcessus << setw(14) << nsElection
+                     << setw(14) << m.rssMaxKo << setw(13) << m.allocations << (m.valide ? "" : "  ECHEC") << "\n";
+                cout.unsetf(ios::floatfield);
+            }
+            cout.flush();
+            premier = false;
+        }
+    }
+    if (options.format == "json") {
+        cout << "\n]\n";
+    }
+    return succes ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#include "Campagne.h"
+#include "ChargeurTrace.h"
+#include "TraceBinaire.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include "ContratModule.h"
+
+namespace {
+
+    bool estTraceConnue(const filesystem::path& chemin) {
+        return chemin.extension() == ".txt" || chemin.extension() == ".pssb";
+    }
+
+    // charge une trace texte ou binaire ; les chargements sont déjà répartis entre les fils
+    bool charger(const string& chemin, TP::TableProcessus& table, size_t& nbRejetees, string& erreur) {
+        if (TP::estTraceBinaire(chemin)) {
+            return TP::chargerTraceBinaire(chemin, table, erreur);
+        }
+        vector<TP::ErreurLigne> erreurs;
+        if (!TP::chargerTrace(chemin, table, erreurs, 1)) {
+            erreur = "impossible d'ouvrir le fichier";
+            return false;
+        }
+        nbRejetees = erreurs.size();
+        return true;
+    }
+
+    // champ CSV entre guillemets, guillemets doublés
+    string champCsv(const string& texte) {
+        string champ = "\"";
+        for (char c : texte) {
+            champ += c;
+            if (c == '"') {
+                champ += '"';
+            }
+        }
+        return champ + "\"";
+    }
+
+    string chaineJson(const string& texte) {
+        string chaine = "\"";
+        for (char c : texte) {
+            switch (c) {
+                case '"':
+                    chaine += "\\\"";
+                    break;
+                case '\\':
+                    chaine += "\\\\";
+                    break;
+                case '\n':
+                    chaine += "\\n";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[8];
+                        snprintf(code, sizeof code, "\\u%04x", c);
+                        chaine += code;
+                    } else {
+                        chaine += c;
+                    }
+            }
+        }
+        return chaine + "\"";
+    }
+
+} // namespace
+
+bool TP::listerTraces(const string& chemin, vector<string>& traces) {
+    error_code erreur;
+    if (filesystem::is_directory(chemin, erreur)) {
+        for (const filesystem::directory_entry& entree : filesystem::directory_iterator(chemin, erreur)) {
+            if (entree.is_regular_file() && estTraceConnue(entree.path())) {
+                traces.push_back(entree.path().string());
+            }
+        }
+        sort(traces.begin(), traces.end());
+        return !erreur;
+    }
+
+    ifstream manifeste(chemin);
+    if (!manifeste) {
+        return false;
+    }
+    filesystem::path repertoire = filesystem::path(chemin).parent_path();
+    string ligne;
+    while (getline(manifeste, ligne)) {
+        size_t debut = ligne.find_first_not_of(" \t\r");
+        if (debut == string::npos || ligne[debut] == '#') {
+            continue;
+        }
+        size_t fin = ligne.find_last_not_of(" \t\r");
+        filesystem::path trace = ligne.substr(debut, fin - debut + 1);
+        traces.push_back((trace.is_absolute() ? trace : repertoire / trace).string());
+    }
+    return true;
+}
+
+/**
+ * @brief simule chaque politique sur chaque trace.
+ * @param traces chemins des traces texte ou binaires.
+ * @param politiques noms des politiques (voir creerPolitique).
+ * @param quantum quantum de temps des politiques à quantum (voir utiliseQuantum).
+ * @param pool fils qui exécutent les chargements et les simulations.
+ * @param couts coûts des commutations de contexte.
+ */
+vector<TP::ResultatCampagne> TP::executerCampagne(const vector<string>& traces, const vector<string>& politiques,
+                                                  int quantum, PoolFils& pool, const CoutsCommutation& couts) {
+    const size_t nbPolitiques = politiques.size();
+    vector<ResultatCampagne> resultats(traces.size() * nbPolitiques);
+    bool classer = any_of(politiques.begin(), politiques.end(),
+                          [](const string& p) { return p == "sjf" || p == "srtf"; });
+
+    pool.executer(traces.size(), [&](size_t t) {
+        auto table = make_shared<TableProcessus>();
+        size_t nbRejetees = 0;
+        string erreur;
+        if (charger(traces[t], *table, nbRejetees, erreur) && table->estVide()) {
+            erreur = "aucun processus";
+        }
+        if (classer && erreur.empty()) {
+            table->classerPids(); // une seule fois, avant le partage entre les simulations
+        }
+
+        shared_ptr<const TableProcessus> charge = std::move(table);
+        for (size_t p = 0; p < nbPolitiques; ++p) {
+            ResultatCampagne& r = resultats[t * nbPolitiques + p];
+            r.trace = traces[t];
+            r.politique = politiques[p];
+            r.nbProcessus = charge->taille();
+            r.nbRejetees = nbRejetees;
+            r.mesure = {quantum, 0.0, 0.0, 0.0, 0.0, false};
+            r.dureeMs = 0.0;
+            r.erreur = erreur;
+            if (erreur.empty()) {
+                pool.soumettre([&r, charge, quantum, &couts] {
+                    auto debut = chrono::steady_clock::now();
+                    r.mesure = mesurerPolitique(charge, r.politique, quantum, couts);
+                    r.dureeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - debut).count();
+                });
+            }
+        }
+    });
+    return resultats;
+}
+
+void TP::ecrireCsv(ostream& sortie, const vector<ResultatCampagne>& resultats) {
+    sortie << "trace,politique,quantum,processus,lignes_rejetees,attente_moyenne,attente_p99,"
+              "rotation_moyenne,rotation_p99,commutation,duree_ms,erreur\n";
+    for (const ResultatCampagne& r : resultats) {
+        sortie << champCsv(r.trace) << ',' << r.politique << ',' << r.mesure.quantum << ',' << r.nbProcessus
+               << ',' << r.nbRejetees << ',' << r.mesure.attenteMoyenne << ',' << r.mesure.attenteP99 << ','
+               << r.mesure.rotationMoyenne << ',' << r.mesure.rotationP99 << ',' << r.mesure.commutation << ','
+               << r.dureeMs << ','
+               << champCsv(r.erreur) << '\n';
+    }
+}
+
+void TP::ecrireJson(ostream& sortie, const vector<ResultatCampagne>& resultats) {
+    sortie << "[\n";
+    for (size_t i = 0; i < resultats.size(); ++i) {
+        const ResultatCampagne& r = resultats[i];
+        sortie << "  {\"trace\": " << chaineJson(r.trace) << ", \"politique\": " << chaineJson(r.politique)
+               << ", \"quantum\": " << r.mesure.quantum << ", \"processus\": " << r.nbProcessus
+               << ", \"lignes_rejetees\": " << r.nbRejetees;
+        if (r.erreur.empty()) {
+            sortie << ", \"attente_moyenne\": " << r.mesure.attenteMoyenne
+                   << ", \"attente_p99\": " << r.mesure.attenteP99
+                   << ", \"rotation_moyenne\": " << r.mesure.rotationMoyenne
+                   << ", \"rotation_p99\": " << r.mesure.rotationP99
+                   << ", \"commutation\": " << r.mesure.commutation << ", \"duree_ms\": " << r.dureeMs;
+        } else {
+            sortie << ", \"erreur\": " << chaineJson(r.erreur);
+        }
+        sortie << "}" << (i + 1 < resultats.size() ? "," : "") << "\n";
+    }
+    sortie << "]\n";
+}
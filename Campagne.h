@@ -0,0 +1,50 @@
+#include "Balayage.h"
+#include "PoolFils.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Campagne.h
+#ifndef CAMPAGNE_H
+#define CAMPAGNE_H
+
+namespace TP {
+
+    // résultat d'une politique sur une trace
+    struct ResultatCampagne {
+        string trace;
+        string politique;
+        size_t nbProcessus;
+        size_t nbRejetees;     // lignes invalides de la trace
+        MesureQuantum mesure;
+        double dureeMs;        // temps de calcul de la simulation
+        string erreur;         // vide si la simulation a eu lieu
+    };
+
+    /**
+     * @brief liste les traces d'une campagne.
+     * @param chemin répertoire (ses fichiers .txt et .pssb, triés par nom) ou manifeste (un chemin
+     * par ligne, relatif au répertoire du manifeste ; les lignes vides et commençant par # sont ignorées).
+     * @return false si le chemin ne peut pas être lu.
+     */
+    bool listerTraces(const string& chemin, vector<string>& traces);
+
+    /**
+     * @brief simule chaque politique sur chaque trace, toutes les paires en parallèle.
+     *
+     * une tâche par trace charge celle-ci une seule fois, puis soumet au pool une simulation par
+     * politique qui partage la trace en lecture seule ; les fils inoccupés volent ces simulations.
+     * @return un résultat par paire, dans l'ordre trace puis politique.
+     * \pre chaque politique est connue de creerPolitique
+     */
+    vector<ResultatCampagne> executerCampagne(const vector<string>& traces, const vector<string>& politiques,
+                                              int quantum, PoolFils& pool, const CoutsCommutation& couts = {});
+
+    void ecrireCsv(ostream& sortie, const vector<ResultatCampagne>& resultats);
+    void ecrireJson(ostream& sortie, const vector<ResultatCampagne>& resultats);
+
+} // namespace TP
+
+#endif // CAMPAGNE_H
@@ -0,0 +1,230 @@
+#include "ChargeurTrace.h"
+#include "FichierMappe.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include "ContratModule.h"
+
+namespace {
+
+    // en deçà de cette taille par fil, le découpage coûte plus qu'il ne rapporte
+    constexpr size_t TAILLE_MIN_MORCEAU = 1 << 20;
+
+    // ligne analysée ; le pid pointe directement dans le fichier projeté, les rafales dans
+    // celles du morceau
+    struct LigneLue {
+        TP::LigneTrace champs;
+        size_t hachage; // calculé par le fil d'analyse, la fusion n'a plus qu'à sonder l'index
+        size_t debutRafales;
+    };
+
+    // résultat de l'analyse d'un morceau du fichier
+    struct Morceau {
+        string_view texte;
+        vector<LigneLue> lignes;
+        vector<int32_t> rafales;  // rafales des lignes mises bout à bout
+        vector<pair<size_t, string_view>> erreurs; // numéro de ligne local au morceau, texte
+        size_t nbLignes = 0;
+    };
+
+    bool estBlanc(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    const char* sauterBlancs(const char* p, const char* fin) {
+        while (p < fin && estBlanc(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    bool lireEntier(const char*& p, const char* fin, int& valeur) {
+        p = sauterBlancs(p, fin);
+        auto [suite, erreur] = from_chars(p, fin, valeur);
+        if (erreur != errc() || (suite < fin && !estBlanc(*suite))) {
+            return false;
+        }
+        p = suite;
+        return true;
+    }
+
+    // vrai si la colonne qui commence en p est une liste de rafales "a,b,..."
+    bool estListe(const char* p, const char* fin) {
+        for (; p < fin && !estBlanc(*p); ++p) {
+            if (*p == ',') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool lireListe(const char*& p, const char* fin, vector<int32_t>& valeurs) {
+        while (true) {
+            int32_t valeur;
+            auto [suite, erreur] = from_chars(p, fin, valeur);
+            if (erreur != errc()) {
+                return false;
+            }
+            valeurs.push_back(valeur);
+            p = suite;
+            if (p == fin || estBlanc(*p)) {
+                return true;
+            }
+            if (*p++ != ',') {
+                return false;
+            }
+        }
+    }
+
+    void analyserMorceau(Morceau& morceau) {
+        const char* p = morceau.texte.data();
+        const char* fin = p + morceau.texte.size();
+        morceau.lignes.reserve(morceau.texte.size() / 16);
+        vector<int32_t> rafales;
+
+        while (p < fin) {
+            const char* eol = static_cast<const char*>(memchr(p, '\n', fin - p));
+            if (eol == nullptr) {
+                eol = fin;
+            }
+            string_view ligne(p, eol - p);
+            ++morceau.nbLignes;
+
+            LigneLue lue;
+            if (TP::analyserLigneTrace(ligne, lue.champs, rafales)) {
+                lue.hachage = TP::TableProcessus::hacherPid(lue.champs.pid);
+                lue.debutRafales = morceau.rafales.size();
+                morceau.rafales.insert(morceau.rafales.end(), rafales.begin(), rafales.end());
+                morceau.lignes.push_back(lue);
+            } else if (!TP::estLigneVide(ligne)) {
+                morceau.erreurs.emplace_back(morceau.nbLignes, ligne);
+            }
+            p = eol + 1;
+        }
+    }
+
+    // découpe le texte en n morceaux dont chaque frontière suit un saut de ligne
+    vector<Morceau> decouper(string_view texte, size_t n) {
+        vector<Morceau> morceaux;
+        size_t debut = 0;
+        for (size_t k = 1; k <= n && debut < texte.size(); ++k) {
+            size_t fin = (k == n) ? texte.size() : max(debut, texte.size() * k / n);
+            if (fin < texte.size()) {
+                size_t eol = texte.find('\n', fin);
+                fin = (eol == string_view::npos) ? texte.size() : eol + 1;
+            }
+            Morceau m;
+            m.texte = texte.substr(debut, fin - debut);
+            morceaux.push_back(std::move(m));
+            debut = fin;
+        }
+        return morceaux;
+    }
+
+} // namespace
+
+/**
+ * @brief analyse "pid arrivee duree restant priorite type [echeance] [rafales]" ; l'échéance,
+ * facultative, est un délai relatif à l'arrivée (0 ou absente : aucune échéance). Les rafales,
+ * facultatives, se reconnaissent à leurs virgules : "4,10,5,20,3" est une rafale processeur de 4,
+ * une E/S de 10, une rafale de 5, une E/S de 20 et une dernière rafale de 3, les rafales
+ * processeur totalisant la durée. Les colonnes suivantes sont ignorées.
+ * @param ligne texte de la ligne, sans le saut de ligne.
+ * @param lue champs lus ; le pid pointe dans ligne, les rafales dans le tampon.
+ * @param rafales tampon des rafales, vidé puis rempli.
+ * @return false si la ligne est mal formée ou si une valeur est hors de son domaine.
+ */
+bool TP::analyserLigneTrace(string_view ligne, LigneTrace& lue, vector<int32_t>& rafales) {
+    const char* p = ligne.data();
+    const char* fin = p + ligne.size();
+
+    p = sauterBlancs(p, fin);
+    const char* debutPid = p;
+    while (p < fin && !estBlanc(*p)) {
+        ++p;
+    }
+    if (p == debutPid) {
+        return false;
+    }
+    lue.pid = string_view(debutPid, p - debutPid);
+
+    int restant;
+    int type;
+    if (!lireEntier(p, fin, lue.arrivee) || !lireEntier(p, fin, lue.duree) || !lireEntier(p, fin, restant)
+        || !lireEntier(p, fin, lue.priorite) || !lireEntier(p, fin, type)) {
+        return false;
+    }
+    lue.echeance = 0;
+    rafales.clear();
+    p = sauterBlancs(p, fin);
+    if (p < fin && !estListe(p, fin)) {
+        if (!lireEntier(p, fin, lue.echeance)) {
+            return false;
+        }
+        p = sauterBlancs(p, fin);
+    }
+    if (p < fin && estListe(p, fin) && !lireListe(p, fin, rafales)) {
+        return false;
+    }
+    if (lue.arrivee < 0 || lue.duree <= 0 || lue.priorite < 0 || type < 1 || type > 4 || lue.echeance < 0
+        || !TableProcessus::rafalesValides(rafales, lue.duree)) {
+        return false;
+    }
+    lue.type = static_cast<TypeProcessus>(type - 1);
+    lue.rafales = rafales;
+    return true;
+}
+
+bool TP::estLigneVide(string_view ligne) {
+    return all_of(ligne.begin(), ligne.end(), estBlanc);
+}
+
+bool TP::chargerTrace(const string& chemin, TableProcessus& table, vector<ErreurLigne>& erreurs,
+                      unsigned nbThreads) {
+    FichierMappe fichier(chemin);
+    if (!fichier.estOuvert()) {
+        return false;
+    }
+
+    string_view texte = fichier.contenu();
+    size_t n = nbThreads;
+    if (n == 0) {
+        n = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), texte.size() / TAILLE_MIN_MORCEAU));
+    }
+
+    vector<Morceau> morceaux = decouper(texte, n);
+    if (morceaux.size() == 1) {
+        analyserMorceau(morceaux.front());
+    } else {
+        vector<thread> fils;
+        for (Morceau& m : morceaux) {
+            fils.emplace_back(analyserMorceau, ref(m));
+        }
+        for (thread& f : fils) {
+            f.join();
+        }
+    }
+
+    // fusion dans l'ordre du fichier ; l'internement des pids reste séquentiel
+    size_t total = 0;
+    for (const Morceau& m : morceaux) {
+        total += m.lignes.size();
+    }
+    table.reserver(table.taille() + total);
+
+    size_t premiereLigne = 0;
+    for (const Morceau& m : morceaux) {
+        for (const LigneLue& l : m.lignes) {
+            const LigneTrace& c = l.champs;
+            table.ajouter(c.pid, l.hachage, c.arrivee, c.duree, c.priorite, c.type, c.echeance,
+                          span<const int32_t>(m.rafales).subspan(l.debutRafales, c.rafales.size()));
+        }
+        for (const auto& [numero, ligne] : m.erreurs) {
+            erreurs.push_back({premiereLigne + numero, string(ligne)});
+        }
+        premiereLigne += m.nbLignes;
+    }
+    return true;
+}
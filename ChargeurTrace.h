@@ -0,0 +1,58 @@
+#include "TableProcessus.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+// ChargeurTrace.h
+#ifndef CHARGEURTRACE_H
+#define CHARGEURTRACE_H
+
+namespace TP {
+
+    // ligne rejetée au chargement
+    struct ErreurLigne {
+        size_t numero;   // numéro de la ligne dans le fichier, à partir de 1
+        string contenu;  // texte de la ligne
+    };
+
+    // champs d'une ligne de trace valide ; le pid pointe dans le texte analysé
+    struct LigneTrace {
+        string_view pid;
+        int arrivee;
+        int duree;
+        int priorite;
+        TypeProcessus type;
+        int echeance = 0;   // délai relatif à l'arrivée, 0 sans échéance
+        // durées alternées processeur, E/S, ..., processeur ; vide pour une seule rafale
+        span<const int32_t> rafales;
+    };
+
+    // analyse une ligne de trace texte ; partagée par le chargeur et le mode flux. Les rafales
+    // sont lues dans un tampon réutilisé d'une ligne à l'autre, où pointe lue.rafales
+    bool analyserLigneTrace(string_view ligne, LigneTrace& lue, vector<int32_t>& rafales);
+    bool estLigneVide(string_view ligne);
+
+    /**
+     * @brief charge une trace texte au format "pid arrivee duree restant priorite type [echeance]
+     * [rafales]".
+     *
+     * le fichier est projeté en mémoire, découpé en morceaux aux frontières de lignes et
+     * analysé en parallèle avec std::from_chars ; les morceaux sont ensuite fusionnés dans
+     * l'ordre du fichier. Les lignes invalides sont ignorées et rapportées dans erreurs.
+     *
+     * @param chemin chemin du fichier de trace.
+     * @param table table où les processus sont ajoutés.
+     * @param erreurs lignes rejetées, dans l'ordre du fichier.
+     * @param nbThreads nombre de fils d'analyse, 0 pour le choisir selon la machine et la taille.
+     * @return false si le fichier ne peut pas être ouvert.
+     */
+    bool chargerTrace(const string& chemin, TableProcessus& table, vector<ErreurLigne>& erreurs,
+                      unsigned nbThreads = 0);
+
+} // namespace TP
+
+#endif // CHARGEURTRACE_H
@@ -0,0 +1,112 @@
+#include "Chronologie.h"
+#include <string>
+#include <string_view>
+#include "ContratModule.h"
+
+namespace {
+
+    // tranche en cours sur un processeur pendant l'export
+    struct TrancheOuverte {
+        bool ouverte = false;
+        uint64_t processus = 0;
+        int32_t debut = 0;
+    };
+
+    void ecrireChaineJson(ostream& sortie, string_view texte) {
+        sortie << '"';
+        for (char c : texte) {
+            if (c == '"' || c == '\\') {
+                sortie << '\\';
+            }
+            if (static_cast<unsigned char>(c) >= 0x20) {
+                sortie << c;
+            }
+        }
+        sortie << '"';
+    }
+
+    void ecrireNom(ostream& sortie, const TP::TableProcessus* table, uint64_t processus) {
+        if (table != nullptr && !table->estFlux() && processus < table->taille()) {
+            ecrireChaineJson(sortie, table->pid(static_cast<TP::IdProcessus>(processus)));
+        } else {
+            sortie << "\"#" << processus << '"';
+        }
+    }
+
+    const char* cause(TP::TypeEnregistrement type) {
+        switch (type) {
+            case TP::QUANTUM_EXPIRE:
+                return "quantum";
+            case TP::PREEMPTE:
+                return "preemption";
+            case TP::TERMINE:
+                return "terminaison";
+            case TP::BLOQUE:
+                return "entree_sortie";
+            default:
+                return "";
+        }
+    }
+
+} // namespace
+
+/**
+ * @brief Constructeur de la chronologie.
+ * @param capacite nombre d'enregistrements gardés, 0 pour tous ; la place est réservée d'avance.
+ */
+TP::Chronologie::Chronologie(size_t capacite) : m_capacite(capacite), m_debut(0), m_nbPerdus(0) {
+    m_enregistrements.reserve(capacite);
+}
+
+void TP::Chronologie::ecrireTraceChrome(ostream& sortie, const TableProcessus* table) const {
+    constexpr int64_t MICROSECONDES = 1000; // une unité de temps de la simulation
+
+    vector<TrancheOuverte> tranches;
+    sortie << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool premier = true;
+    auto separer = [&]() {
+        sortie << (premier ? "\n" : ",\n");
+        premier = false;
+    };
+
+    for (size_t i = 0; i < taille(); ++i) {
+        const Enregistrement& e = (*this)[i];
+        if (e.processeur >= tranches.size()) {
+            for (size_t p = tranches.size(); p <= e.processeur; ++p) {
+                separer();
+                sortie << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 0, \"tid\": " << p
+                       << ", \"args\": {\"name\": \"CPU " << p << "\"}}";
+            }
+            tranches.resize(e.processeur + 1);
+        }
+        TrancheOuverte& t = tranches[e.processeur];
+
+        switch (e.type) {
+            case ELU:
+                t = {true, e.processus, e.temps};
+                break;
+            case QUANTUM_EXPIRE:
+            case PREEMPTE:
+            case TERMINE:
+            case BLOQUE:
+                if (t.ouverte && t.processus == e.processus) {
+                    separer();
+                    sortie << "{\"ph\": \"X\", \"name\": ";
+                    ecrireNom(sortie, table, e.processus);
+                    sortie << ", \"pid\": 0, \"tid\": " << e.processeur << ", \"ts\": " << t.debut * MICROSECONDES
+                           << ", \"dur\": " << (static_cast<int64_t>(e.temps) - t.debut) * MICROSECONDES
+                           << ", \"args\": {\"fin\": \"" << cause(e.type) << "\"}}";
+                }
+                t.ouverte = false;
+                break;
+            case MIGRE:
+                separer();
+                sortie << "{\"ph\": \"i\", \"s\": \"t\", \"name\": \"migration\", \"pid\": 0, \"tid\": " << e.processeur
+                       << ", \"ts\": " << static_cast<int64_t>(e.temps) * MICROSECONDES << ", \"args\": {\"processus\": ";
+                ecrireNom(sortie, table, e.processus);
+                sortie << "}}";
+                break;
+        }
+    }
+    sortie << "\n]}\n";
+}
@@ -0,0 +1,87 @@
+#include "TableProcessus.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+using namespace std;
+
+// Chronologie.h
+#ifndef CHRONOLOGIE_H
+#define CHRONOLOGIE_H
+
+namespace TP {
+
+    // ce qui arrive au processus d'un enregistrement
+    enum TypeEnregistrement : uint8_t {
+        ELU,                // début d'une tranche d'exécution
+        QUANTUM_EXPIRE,     // fin de tranche, retour dans la file prête
+        PREEMPTE,           // fin de tranche imposée par un processus plus prioritaire
+        TERMINE,            // fin de la dernière tranche
+        MIGRE,              // processus prêt déplacé vers le processeur de l'enregistrement
+        BLOQUE              // fin de rafale processeur, le processus commence une E/S
+    };
+
+    // enregistrement de taille fixe : aucune chaîne n'est formatée pendant la simulation
+    struct Enregistrement {
+        int32_t temps;
+        uint16_t processeur;
+        TypeEnregistrement type;
+        uint64_t processus;     // identifiant dans la table, ou numéro d'admission en mode flux
+    };
+
+    /**
+     * @brief chronologie d'une simulation : chaque élection, fin de tranche, préemption,
+     * blocage en E/S, terminaison et migration, dans l'ordre où le moteur les traite.
+     *
+     * sans capacité, tout est gardé dans un tampon qui grandit ; avec une capacité, le tampon est
+     * circulaire et ne garde que les derniers enregistrements. La mise en forme n'a lieu qu'à
+     * l'export.
+     */
+    class Chronologie {
+    public:
+        // capacite : nombre d'enregistrements gardés, 0 pour tous
+        explicit Chronologie(size_t capacite = 0);
+
+        void ajouter(int temps, size_t processeur, TypeEnregistrement type, uint64_t processus) {
+            Enregistrement e{temps, static_cast<uint16_t>(processeur), type, processus};
+            if (m_capacite == 0 || m_enregistrements.size() < m_capacite) {
+                m_enregistrements.push_back(e);
+                return;
+            }
+            m_enregistrements[m_debut] = e;
+            if (++m_debut == m_capacite) {
+                m_debut = 0;
+            }
+            ++m_nbPerdus;
+        }
+
+        size_t taille() const { return m_enregistrements.size(); }
+        // enregistrements écrasés par le tampon circulaire
+        uint64_t nbPerdus() const { return m_nbPerdus; }
+        // i-ème enregistrement gardé, du plus ancien au plus récent
+        const Enregistrement& operator[](size_t i) const {
+            size_t j = m_debut + i;
+            return m_enregistrements[j < m_enregistrements.size() ? j : j - m_enregistrements.size()];
+        }
+
+        /**
+         * @brief écrit la chronologie au format Chrome trace (JSON lu par Perfetto et
+         * chrome://tracing) : une ligne par processeur, une tranche par exécution.
+         *
+         * une unité de temps de la simulation devient une milliseconde. Les tranches commencées
+         * avant le premier enregistrement gardé sont omises.
+         * @param table table simulée, pour nommer les processus par leur pid ; nullptr, ou une
+         * table en mode flux, les nomme par leur numéro.
+         */
+        void ecrireTraceChrome(ostream& sortie, const TableProcessus* table) const;
+
+    private:
+        size_t m_capacite;
+        vector<Enregistrement> m_enregistrements;
+        size_t m_debut;         // case du plus ancien enregistrement une fois le tampon plein
+        uint64_t m_nbPerdus;
+    };
+
+} // namespace TP
+
+#endif // CHRONOLOGIE_H
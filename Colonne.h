@@ -0,0 +1,97 @@
+#include <cstddef>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Colonne.h
+#ifndef COLONNE_H
+#define COLONNE_H
+
+namespace TP {
+
+    /**
+     * @brief colonne en lecture d'une table : soit possédée (vecteur qui grandit à l'ajout),
+     * soit empruntée à une mémoire externe, par exemple un fichier projeté, sans copie.
+     */
+    template<typename T>
+    class Colonne {
+    public:
+        Colonne() = default;
+
+        Colonne(const Colonne& autre) : m_possede(autre.m_possede) {
+            m_donnees = autre.estEmpruntee() ? autre.m_donnees : m_possede.data();
+            m_taille = autre.m_taille;
+        }
+
+        Colonne& operator=(const Colonne& autre) {
+            if (this != &autre) {
+                m_possede = autre.m_possede;
+                m_donnees = autre.estEmpruntee() ? autre.m_donnees : m_possede.data();
+                m_taille = autre.m_taille;
+            }
+            return *this;
+        }
+
+        // le tampon d'un vecteur déplacé ne change pas d'adresse
+        Colonne(Colonne&& autre) noexcept
+            : m_possede(std::move(autre.m_possede)), m_donnees(autre.m_donnees), m_taille(autre.m_taille) {
+            autre.m_donnees = nullptr;
+            autre.m_taille = 0;
+        }
+
+        Colonne& operator=(Colonne&& autre) noexcept {
+            if (this != &autre) {
+                m_possede = std::move(autre.m_possede);
+                m_donnees = autre.m_donnees;
+                m_taille = autre.m_taille;
+                autre.m_donnees = nullptr;
+                autre.m_taille = 0;
+            }
+            return *this;
+        }
+
+        void push_back(const T& valeur) {
+            m_possede.push_back(valeur);
+            m_donnees = m_possede.data();
+            m_taille = m_possede.size();
+        }
+
+        void append(const T* valeurs, size_t n) {
+            m_possede.insert(m_possede.end(), valeurs, valeurs + n);
+            m_donnees = m_possede.data();
+            m_taille = m_possede.size();
+        }
+
+        // écriture d'une case existante d'une colonne possédée
+        void remplacer(size_t i, const T& valeur) {
+            m_possede[i] = valeur;
+        }
+
+        void reserve(size_t n) {
+            m_possede.reserve(n);
+            m_donnees = m_possede.data();
+        }
+
+        // remplace le contenu par une vue sur une mémoire qui doit survivre à la colonne
+        void emprunter(const T* donnees, size_t taille) {
+            vector<T>().swap(m_possede);
+            m_donnees = donnees;
+            m_taille = taille;
+        }
+
+        bool estEmpruntee() const { return m_taille > 0 && m_donnees != m_possede.data(); }
+
+        const T& operator[](size_t i) const { return m_donnees[i]; }
+        const T* data() const { return m_donnees; }
+        size_t size() const { return m_taille; }
+        bool empty() const { return m_taille == 0; }
+
+    private:
+        vector<T> m_possede;
+        const T* m_donnees = nullptr;
+        size_t m_taille = 0;
+    };
+
+} // namespace TP
+
+#endif // COLONNE_H
@@ -7,7 +7,16 @@
  * la sauvegarde des renseignements de l'erreur.  Cette classe et sa
  * hiérarchie sont intéressantes lors de l'utilisation des exceptions.
  *
- * En release, définir la constante NDEBUG pour désactiver les Macros
+ * Le niveau de vérification est donné par CONTRAT_NIVEAU :
+ *   0  aucune vérification ;
+ *   1  bornes : PRECONDITION et POSTCONDITION seulement, pour garder en production
+ *      les vérifications aux frontières des fonctions sans leur coût d'audit ;
+ *   2  audit : en plus, ASSERTION, INVARIANT et INVARIANTS() après chaque modification.
+ * Sans CONTRAT_NIVEAU, le niveau est 0 si NDEBUG est défini et 2 sinon. Ce niveau global est
+ * celui de tout le code des en-têtes (fonctions inline et patrons) : une même définition doit
+ * être compilée de la même façon dans tous les fichiers qui l'incluent. CONTRAT_NIVEAU_MODULE,
+ * défini pour un fichier source seulement (voir CONTRAT_MODULES dans CMakeLists.txt), ne change
+ * que le code propre à ce fichier, écrit après l'inclusion de ContratModule.h.
  *
  * <pre>
  * Classes:
@@ -107,30 +116,49 @@ public:
 
 // --- Définition des macros de contrôle de la théorie du contrat
 
-#if !defined(NDEBUG)
-// --- Mode debug
+#if defined(CONTRAT_NIVEAU)
+#define CONTRAT_NIVEAU_EFFECTIF CONTRAT_NIVEAU
+#elif defined(NDEBUG)
+#define CONTRAT_NIVEAU_EFFECTIF 0
+#else
+#define CONTRAT_NIVEAU_EFFECTIF 2
+#endif
 
-#define INVARIANTS() \
-      verifieInvariant()
+#if CONTRAT_NIVEAU_EFFECTIF < 0 || CONTRAT_NIVEAU_EFFECTIF > 2
+#error "CONTRAT_NIVEAU doit valoir 0, 1 ou 2"
+#endif
+
+#if CONTRAT_NIVEAU_EFFECTIF >= 1
+// --- Niveau bornes : préconditions et postconditions
 
-#define ASSERTION(f)     \
-      if (!(f)) throw AssertionException(__FILE__,__LINE__, #f);
 #define PRECONDITION(f)  \
       if (!(f)) throw PreconditionException(__FILE__, __LINE__, #f);
 #define POSTCONDITION(f) \
       if (!(f)) throw PostconditionException(__FILE__, __LINE__, #f);
-#define INVARIANT(f)   \
-      if (!(f)) throw InvariantException(__FILE__,__LINE__, #f);
 
-// --- LE MODE RELEASE
 #else
 
 #define PRECONDITION(f);
 #define POSTCONDITION(f);
+
+#endif  // --- if CONTRAT_NIVEAU_EFFECTIF >= 1
+
+#if CONTRAT_NIVEAU_EFFECTIF >= 2
+// --- Niveau audit : assertions et invariants
+
+#define INVARIANTS() \
+      verifieInvariant()
+
+#define ASSERTION(f)     \
+      if (!(f)) throw AssertionException(__FILE__,__LINE__, #f);
+#define INVARIANT(f)   \
+      if (!(f)) throw InvariantException(__FILE__,__LINE__, #f);
+
+#else
+
 #define INVARIANTS();
 #define INVARIANT(f);
 #define ASSERTION(f);
 
-#endif  // --- if !defined (NDEBUG)
+#endif  // --- if CONTRAT_NIVEAU_EFFECTIF >= 2
 #endif  // --- ifndef CONTRATEXCEPTION_H_DEJA_INCLU
-
@@ -0,0 +1,52 @@
+/**
+ * \file   ContratModule.h
+ * \brief  Niveau des contrats propre à un fichier source
+ *
+ * À inclure après tous les autres en-têtes d'un fichier source. Si CONTRAT_NIVEAU_MODULE est
+ * défini pour ce fichier (voir CONTRAT_MODULES dans CMakeLists.txt), les macros de
+ * ContratException.h sont redéfinies à ce niveau pour la suite du fichier seulement : le code
+ * des en-têtes, partagé avec les autres fichiers, reste au niveau global.
+ */
+
+#ifndef CONTRATMODULE_H_DEJA_INCLU
+#define CONTRATMODULE_H_DEJA_INCLU
+
+#include "ContratException.h"
+
+#if defined(CONTRAT_NIVEAU_MODULE)
+
+#if CONTRAT_NIVEAU_MODULE < 0 || CONTRAT_NIVEAU_MODULE > 2
+#error "CONTRAT_NIVEAU_MODULE doit valoir 0, 1 ou 2"
+#endif
+
+#undef PRECONDITION
+#undef POSTCONDITION
+#undef INVARIANTS
+#undef INVARIANT
+#undef ASSERTION
+
+#if CONTRAT_NIVEAU_MODULE >= 1
+#define PRECONDITION(f)  \
+      if (!(f)) throw PreconditionException(__FILE__, __LINE__, #f);
+#define POSTCONDITION(f) \
+      if (!(f)) throw PostconditionException(__FILE__, __LINE__, #f);
+#else
+#define PRECONDITION(f);
+#define POSTCONDITION(f);
+#endif
+
+#if CONTRAT_NIVEAU_MODULE >= 2
+#define INVARIANTS() \
+      verifieInvariant()
+#define ASSERTION(f)     \
+      if (!(f)) throw AssertionException(__FILE__,__LINE__, #f);
+#define INVARIANT(f)   \
+      if (!(f)) throw InvariantException(__FILE__,__LINE__, #f);
+#else
+#define INVARIANTS();
+#define INVARIANT(f);
+#define ASSERTION(f);
+#endif
+
+#endif  // --- if defined(CONTRAT_NIVEAU_MODULE)
+#endif  // --- ifndef CONTRATMODULE_H_DEJA_INCLU
@@ -0,0 +1,212 @@
+#include "Echeances.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "ContratModule.h"
+
+namespace {
+
+    // processus à échéance vu par le test de faisabilité
+    struct Travail {
+        int64_t arrivee;
+        int64_t echeance;   // absolue
+        int64_t duree;
+    };
+
+    /**
+     * arbre de segments sur des valeurs : ajout d'une constante à un suffixe et maximum d'un
+     * suffixe, en O(log n). Chaque nœud garde le maximum de son intervalle, ajouts compris ;
+     * les ajouts qui couvrent tout un nœud n'y sont notés qu'une fois.
+     */
+    class ArbreMaximum {
+    public:
+        explicit ArbreMaximum(const vector<int64_t>& valeurs)
+            : m_taille(valeurs.size()), m_max(4 * valeurs.size(), 0), m_ajouts(4 * valeurs.size(), 0) {
+            construire(1, 0, m_taille, valeurs);
+        }
+
+        // ajoute delta aux valeurs d'indice debut et plus
+        void ajouterSuffixe(size_t debut, int64_t delta) { ajouter(1, 0, m_taille, debut, delta); }
+
+        // maximum des valeurs d'indice debut et plus, et indice où il est atteint
+        // \pre debut < taille
+        pair<int64_t, size_t> maximumSuffixe(size_t debut) const { return maximum(1, 0, m_taille, debut); }
+
+    private:
+        void construire(size_t noeud, size_t gauche, size_t droite, const vector<int64_t>& valeurs) {
+            if (droite - gauche == 1) {
+                m_max[noeud] = valeurs[gauche];
+                return;
+            }
+            size_t milieu = (gauche + droite) / 2;
+            construire(2 * noeud, gauche, milieu, valeurs);
+            construire(2 * noeud + 1, milieu, droite, valeurs);
+            m_max[noeud] = max(m_max[2 * noeud], m_max[2 * noeud + 1]);
+        }
+
+        void ajouter(size_t noeud, size_t gauche, size_t droite, size_t debut, int64_t delta) {
+            if (droite <= debut) {
+                return;
+            }
+            if (gauche >= debut) {
+                m_max[noeud] += delta;
+                m_ajouts[noeud] += delta;
+                return;
+            }
+            size_t milieu = (gauche + droite) / 2;
+            ajouter(2 * noeud, gauche, milieu, debut, delta);
+            ajouter(2 * noeud + 1, milieu, droite, debut, delta);
+            m_max[noeud] = m_ajouts[noeud] + max(m_max[2 * noeud], m_max[2 * noeud + 1]);
+        }
+
+        pair<int64_t, size_t> maximum(size_t noeud, size_t gauche, size_t droite, size_t debut) const {
+            if (gauche >= debut) {
+                // tout le nœud : descente vers une feuille maximale
+                int64_t valeur = m_max[noeud];
+                while (droite - gauche > 1) {
+                    size_t milieu = (gauche + droite) / 2;
+                    if (m_max[2 * noeud] >= m_max[2 * noeud + 1]) {
+                        noeud = 2 * noeud;
+                        droite = milieu;
+                    } else {
+                        noeud = 2 * noeud + 1;
+                        gauche = milieu;
+                    }
+                }
+                return {valeur, gauche};
+            }
+            size_t milieu = (gauche + droite) / 2;
+            pair<int64_t, size_t> meilleur = maximum(2 * noeud + 1, milieu, droite, debut);
+            if (debut < milieu) {
+                meilleur = max(meilleur, maximum(2 * noeud, gauche, milieu, debut),
+                               [](const auto& a, const auto& b) { return a.first < b.first; });
+            }
+            meilleur.first += m_ajouts[noeud];
+            return meilleur;
+        }
+
+        size_t m_taille;
+        vector<int64_t> m_max;
+        vector<int64_t> m_ajouts;   // ajouts qui couvrent tout le nœud
+    };
+
+    void ecrireCompte(ostream& sortie, const string& nom, const TP::CompteEcheances& compte) {
+        if (compte.nbEcheances == 0) {
+            return;
+        }
+        const TP::Histogramme& r = compte.retards;
+        sortie << "  " << left << setw(12) << nom << right << " : " << compte.nbManquees << " / " << compte.nbEcheances
+               << " manquees (" << fixed << setprecision(2) << 100.0 * compte.tauxManquees() << " %)";
+        sortie.unsetf(ios::floatfield);
+        if (r.nombre() > 0) {
+            sortie << ", retard " << r.centile(0.50) << " / " << r.centile(0.95) << " / " << r.centile(0.99) << " / "
+                   << r.max();
+        }
+        sortie << "\n";
+    }
+
+} // namespace
+
+// PuitsEcheances
+
+void TP::PuitsEcheances::recevoir(const TableProcessus& table, IdProcessus id) {
+    int64_t echeance = table.echeanceAbsolue(id);
+    if (echeance == SANS_ECHEANCE) {
+        ++m_nbSansEcheance;
+        return;
+    }
+    int64_t retard = table.fin(id) - echeance;
+    for (CompteEcheances* c : {&m_tous, &m_parType[table.type(id)]}) {
+        ++c->nbEcheances;
+        if (retard > 0) {
+            ++c->nbManquees;
+            c->retards.ajouter(retard);
+        }
+    }
+}
+
+void TP::PuitsEcheances::fusionner(const PuitsEcheances& autre) {
+    auto fusionnerCompte = [](CompteEcheances& c, const CompteEcheances& a) {
+        c.nbEcheances += a.nbEcheances;
+        c.nbManquees += a.nbManquees;
+        c.retards.fusionner(a.retards);
+    };
+    fusionnerCompte(m_tous, autre.m_tous);
+    for (size_t t = 0; t < m_parType.size(); ++t) {
+        fusionnerCompte(m_parType[t], autre.m_parType[t]);
+    }
+    m_nbSansEcheance += autre.m_nbSansEcheance;
+}
+
+void TP::ecrireEcheances(ostream& sortie, const PuitsEcheances& echeances) {
+    streamsize precision = sortie.precision();
+    sortie << "echeances manquees, retard p50 / p95 / p99 / max :\n";
+    ecrireCompte(sortie, "tous", echeances.tous());
+    for (int type = SYSTEME; type <= UTILISATEUR; ++type) {
+        ecrireCompte(sortie, "type " + to_string(type + 1), echeances.parType(static_cast<TypeProcessus>(type)));
+    }
+    if (echeances.nbSansEcheance() > 0) {
+        sortie << "  " << echeances.nbSansEcheance() << " processus sans echeance\n";
+    }
+    sortie.precision(precision);
+}
+
+// faisabilité
+
+TP::Faisabilite TP::verifierFaisabilite(const TableProcessus& table, unsigned nbProcesseurs) {
+    PRECONDITION(nbProcesseurs > 0 && nbProcesseurs <= UINT16_MAX);
+
+    Faisabilite resultat;
+    vector<Travail> travaux;
+    for (IdProcessus id = 0; id < table.taille(); ++id) {
+        if (table.echeance(id) == 0) {
+            continue;
+        }
+        Travail t{table.arrivee(id), table.echeanceAbsolue(id), table.duree(id)};
+        if (resultat.faisable && t.duree > t.echeance - t.arrivee) {
+            // un processus n'occupe qu'un processeur à la fois
+            resultat = {false, 0, t.arrivee, t.echeance, t.duree, t.echeance - t.arrivee};
+        }
+        travaux.push_back(t);
+    }
+    resultat.nbEcheances = travaux.size();
+    if (!resultat.faisable || travaux.empty()) {
+        return resultat;
+    }
+
+    // valeur initiale de chaque échéance d : -capacité(d), la demande s'y ajoute au fil du balayage
+    const int64_t m = nbProcesseurs;
+    vector<int64_t> echeances(travaux.size());
+    transform(travaux.begin(), travaux.end(), echeances.begin(), [](const Travail& t) { return t.echeance; });
+    sort(echeances.begin(), echeances.end());
+    echeances.erase(unique(echeances.begin(), echeances.end()), echeances.end());
+    vector<int64_t> valeurs(echeances.size());
+    transform(echeances.begin(), echeances.end(), valeurs.begin(), [m](int64_t d) { return -m * d; });
+    ArbreMaximum arbre(valeurs);
+
+    sort(travaux.begin(), travaux.end(), [](const Travail& a, const Travail& b) { return a.arrivee > b.arrivee; });
+    for (size_t i = 0; i < travaux.size();) {
+        int64_t debut = travaux[i].arrivee;
+        for (; i < travaux.size() && travaux[i].arrivee == debut; ++i) {
+            size_t position = lower_bound(echeances.begin(), echeances.end(), travaux[i].echeance) - echeances.begin();
+            arbre.ajouterSuffixe(position, travaux[i].duree);
+        }
+        // seules les échéances après debut bornent une fenêtre ; chaque processus ajouté est dû
+        // après son arrivée, donc après debut.
+        // demande(d) - m × d > -m × debut  <=>  demande(d) > m × (d - debut)
+        size_t premiere = upper_bound(echeances.begin(), echeances.end(), debut) - echeances.begin();
+        auto [valeur, position] = arbre.maximumSuffixe(premiere);
+        if (valeur > -m * debut) {
+            int64_t fin = echeances[position];
+            resultat.faisable = false;
+            resultat.debut = debut;
+            resultat.fin = fin;
+            resultat.demande = valeur + m * fin;
+            resultat.capacite = m * (fin - debut);
+            return resultat;
+        }
+    }
+    return resultat;
+}
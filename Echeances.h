@@ -0,0 +1,83 @@
+#include "Flux.h"
+#include "Latences.h"
+#include "TableProcessus.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+using namespace std;
+
+// Echeances.h
+#ifndef ECHEANCES_H
+#define ECHEANCES_H
+
+namespace TP {
+
+    // échéances d'une catégorie de processus : combien en avaient une, combien l'ont manquée, et de combien
+    struct CompteEcheances {
+        uint64_t nbEcheances = 0;
+        uint64_t nbManquees = 0;
+        Histogramme retards;        // retard (fin - échéance) des processus en retard
+
+        double tauxManquees() const {
+            return nbEcheances == 0 ? 0.0 : static_cast<double>(nbManquees) / nbEcheances;
+        }
+    };
+
+    /**
+     * @brief puits qui compte, au fil des terminaisons, les échéances tenues et manquées, pour
+     * tous les processus et par type, et tient la distribution des retards.
+     *
+     * un processus terminé exactement à son échéance la tient. Les processus sans échéance ne
+     * sont que comptés. La mémoire est fixe ; des puits de simulations parallèles se fusionnent.
+     */
+    class PuitsEcheances : public PuitsProcessus {
+    public:
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+        void fusionner(const PuitsEcheances& autre);
+
+        const CompteEcheances& tous() const { return m_tous; }
+        const CompteEcheances& parType(TypeProcessus type) const { return m_parType[type]; }
+        uint64_t nbSansEcheance() const { return m_nbSansEcheance; }
+
+    private:
+        CompteEcheances m_tous;
+        array<CompteEcheances, 4> m_parType;
+        uint64_t m_nbSansEcheance = 0;
+    };
+
+    // écrit, pour tous les processus et pour chaque type qui en a, les échéances manquées et
+    // p50 / p95 / p99 / max de leur retard
+    void ecrireEcheances(ostream& sortie, const PuitsEcheances& echeances);
+
+    /**
+     * @brief résultat du test de faisabilité ; si la charge est infaisable, la fenêtre
+     * [debut, fin] demande plus de travail que les processeurs ne peuvent en fournir.
+     */
+    struct Faisabilite {
+        bool faisable = true;
+        size_t nbEcheances = 0;
+        int64_t debut = 0;
+        int64_t fin = 0;
+        int64_t demande = 0;        // durées des processus arrivés et dus dans la fenêtre
+        int64_t capacite = 0;       // temps processeur que ces processus peuvent y recevoir
+    };
+
+    /**
+     * @brief test de la demande processeur : pour toute fenêtre [a, d] allant d'une arrivée à une
+     * échéance, les processus arrivés au plus tôt en a et dus au plus tard en d doivent tenir
+     * dans nbProcesseurs × (d - a) ; chaque processus doit aussi tenir seul dans son délai.
+     *
+     * sur un processeur, le critère est exact : la charge est faisable si et seulement si EDF
+     * préemptif tient toutes les échéances. Sur plusieurs processeurs, ou sans préemption, il
+     * n'est que nécessaire. Les processus sans échéance sont ignorés. Les arrivées sont balayées
+     * de la plus tardive à la plus précoce ; un arbre de segments sur les échéances triées tient
+     * le maximum de demande(d) - capacité(d), soit O(n log n) en tout.
+     * \pre 0 < nbProcesseurs <= UINT16_MAX
+     */
+    Faisabilite verifierFaisabilite(const TableProcessus& table, unsigned nbProcesseurs = 1);
+
+} // namespace TP
+
+#endif // ECHEANCES_H
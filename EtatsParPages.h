@@ -0,0 +1,109 @@
+#include "ContratException.h"
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// EtatsParPages.h
+#ifndef ETATSPARPAGES_H
+#define ETATSPARPAGES_H
+
+namespace TP {
+
+    /**
+     * @brief état d'une politique pour chaque indice de processus qu'elle connaît, rangé par pages
+     * allouées seulement autour des indices occupés.
+     *
+     * un indice est occupé d'occuper() à liberer() ; un indice libre vaut la valeur par défaut.
+     * Comme les positions de TasIndexe, une page dont tous les indices sont libres est recyclée :
+     * la mémoire suit le nombre de processus que la file connaît à un instant, et non la taille de
+     * la table, ce qui compte avec une file par processeur.
+     */
+    template<typename T>
+    class EtatsParPages {
+    public:
+        explicit EtatsParPages(const T& defaut = T{}) : m_defaut(defaut) {}
+
+        bool occupe(size_t indice) const {
+            size_t page = indice >> BITS_PAGE;
+            return page < m_pages.size() && m_pages[page] != nullptr && m_pages[page]->occupes[indice & MASQUE];
+        }
+
+        // valeur d'un indice, la valeur par défaut s'il est libre
+        const T& operator[](size_t indice) const { return occupe(indice) ? valeur(indice) : m_defaut; }
+
+        T& operator[](size_t indice) {
+            PRECONDITION(occupe(indice));
+            return valeur(indice);
+        }
+
+        // occupe un indice libre à la valeur par défaut, en allouant (ou en reprenant) sa page au besoin
+        T& occuper(size_t indice) {
+            PRECONDITION(!occupe(indice));
+            size_t page = indice >> BITS_PAGE;
+            if (page >= m_pages.size()) {
+                m_pages.resize(page + 1);
+            }
+            if (m_pages[page] == nullptr) {
+                if (m_pagesLibres.empty()) {
+                    m_pages[page] = make_unique<Page>();
+                } else {
+                    m_pages[page] = std::move(m_pagesLibres.back());
+                    m_pagesLibres.pop_back();
+                }
+            }
+            Page& p = *m_pages[page];
+            p.occupes[indice & MASQUE] = true;
+            ++p.nbOccupes;
+            return p.valeurs[indice & MASQUE] = m_defaut;
+        }
+
+        // une page vidée est gardée pour être réutilisée
+        void liberer(size_t indice) {
+            PRECONDITION(occupe(indice));
+            size_t page = indice >> BITS_PAGE;
+            Page& p = *m_pages[page];
+            p.occupes[indice & MASQUE] = false;
+            if (--p.nbOccupes == 0) {
+                m_pagesLibres.push_back(std::move(m_pages[page]));
+            }
+        }
+
+        // appelle f(indice, valeur) pour chaque indice occupé, par indice croissant
+        template<typename Fonction>
+        void parcourir(Fonction f) const {
+            for (size_t page = 0; page < m_pages.size(); ++page) {
+                if (m_pages[page] != nullptr) {
+                    for (size_t i = 0; i <= MASQUE; ++i) {
+                        if (m_pages[page]->occupes[i]) {
+                            f((page << BITS_PAGE) | i, m_pages[page]->valeurs[i]);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t BITS_PAGE = 8;
+        static constexpr size_t MASQUE = (size_t(1) << BITS_PAGE) - 1;
+
+        struct Page {
+            T valeurs[size_t(1) << BITS_PAGE];
+            bitset<size_t(1) << BITS_PAGE> occupes;
+            uint32_t nbOccupes = 0;
+        };
+
+        const T& valeur(size_t indice) const { return m_pages[indice >> BITS_PAGE]->valeurs[indice & MASQUE]; }
+        T& valeur(size_t indice) { return m_pages[indice >> BITS_PAGE]->valeurs[indice & MASQUE]; }
+
+        vector<unique_ptr<Page>> m_pages;     // nulles si aucun indice n'y est occupé
+        vector<unique_ptr<Page>> m_pagesLibres;
+        T m_defaut;
+    };
+
+} // namespace TP
+
+#endif // ETATSPARPAGES_H
@@ -0,0 +1,67 @@
+#include "FichierMappe.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include "ContratModule.h"
+
+/**
+ * @brief projette le fichier en mémoire.
+ *
+ * un fichier vide est considéré comme ouvert, avec un contenu vide.
+ * @param chemin chemin du fichier à projeter.
+ */
+TP::FichierMappe::FichierMappe(const string& chemin) {
+    int fd = ::open(chemin.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat infos;
+    if (::fstat(fd, &infos) == 0) {
+        m_taille = static_cast<size_t>(infos.st_size);
+        if (m_taille == 0) {
+            m_ouvert = true;
+        } else {
+            void* adresse = ::mmap(nullptr, m_taille, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (adresse != MAP_FAILED) {
+                ::madvise(adresse, m_taille, MADV_SEQUENTIAL);
+                m_donnees = static_cast<const char*>(adresse);
+                m_ouvert = true;
+            } else {
+                m_taille = 0;
+            }
+        }
+    }
+    ::close(fd); // la projection reste valide après la fermeture du descripteur
+}
+
+TP::FichierMappe::~FichierMappe() {
+    liberer();
+}
+
+TP::FichierMappe::FichierMappe(FichierMappe&& autre) noexcept
+    : m_donnees(std::exchange(autre.m_donnees, nullptr)),
+      m_taille(std::exchange(autre.m_taille, 0)),
+      m_ouvert(std::exchange(autre.m_ouvert, false)) {
+}
+
+TP::FichierMappe& TP::FichierMappe::operator=(FichierMappe&& autre) noexcept {
+    if (this != &autre) {
+        liberer();
+        m_donnees = std::exchange(autre.m_donnees, nullptr);
+        m_taille = std::exchange(autre.m_taille, 0);
+        m_ouvert = std::exchange(autre.m_ouvert, false);
+    }
+    return *this;
+}
+
+void TP::FichierMappe::liberer() {
+    if (m_donnees != nullptr) {
+        ::munmap(const_cast<char*>(m_donnees), m_taille);
+    }
+    m_donnees = nullptr;
+    m_taille = 0;
+    m_ouvert = false;
+}
@@ -0,0 +1,46 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+using namespace std;
+
+// FichierMappe.h
+#ifndef FICHIERMAPPE_H
+#define FICHIERMAPPE_H
+
+namespace TP {
+
+    /**
+     * @brief fichier projeté en mémoire en lecture seule (mmap).
+     *
+     * le contenu est paginé à la demande par le noyau, sans copie dans un tampon du programme.
+     * La projection est libérée à la destruction.
+     */
+    class FichierMappe {
+    public:
+        FichierMappe() = default;
+        explicit FichierMappe(const string& chemin);
+        ~FichierMappe();
+
+        FichierMappe(const FichierMappe&) = delete;
+        FichierMappe& operator=(const FichierMappe&) = delete;
+        FichierMappe(FichierMappe&& autre) noexcept;
+        FichierMappe& operator=(FichierMappe&& autre) noexcept;
+
+        // faux si le fichier n'a pas pu être ouvert ou projeté
+        bool estOuvert() const { return m_ouvert; }
+
+        const char* donnees() const { return m_donnees; }
+        size_t taille() const { return m_taille; }
+        string_view contenu() const { return {m_donnees, m_taille}; }
+
+    private:
+        void liberer();
+
+        const char* m_donnees = nullptr;
+        size_t m_taille = 0;
+        bool m_ouvert = false;
+    };
+
+} // namespace TP
+
+#endif // FICHIERMAPPE_H
@@ -0,0 +1,79 @@
+#include "ContratException.h"
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// FileCirculaire.h
+#ifndef FILECIRCULAIRE_H
+#define FILECIRCULAIRE_H
+
+namespace TP {
+
+    /**
+     * @brief file FIFO dans un tampon circulaire préalloué.
+     *
+     * la capacité est arrondie à une puissance de deux pour remplacer le modulo par un masque ;
+     * ajouter et extraire ne font aucune allocation tant que la capacité initiale suffit.
+     * Au-delà, le tampon double de taille (cas du mode flux, où le nombre de processus
+     * n'est pas connu d'avance).
+     */
+    template<typename T>
+    class FileCirculaire {
+    public:
+        explicit FileCirculaire(size_t capacite) : m_debut(0), m_taille(0) {
+            size_t arrondie = 1;
+            while (arrondie < capacite) {
+                arrondie <<= 1;
+            }
+            m_tampon.resize(arrondie);
+            m_masque = arrondie - 1;
+        }
+
+        bool estVide() const { return m_taille == 0; }
+        size_t taille() const { return m_taille; }
+        size_t capacite() const { return m_tampon.size(); }
+
+        // i-ème élément à partir du premier
+        const T& operator[](size_t i) const {
+            PRECONDITION(i < m_taille);
+            return m_tampon[(m_debut + i) & m_masque];
+        }
+
+        void ajouter(const T& element) {
+            if (m_taille == m_tampon.size()) {
+                agrandir();
+            }
+            m_tampon[(m_debut + m_taille) & m_masque] = element;
+            ++m_taille;
+        }
+
+        T extraire() {
+            PRECONDITION(m_taille > 0);
+            T element = m_tampon[m_debut];
+            m_debut = (m_debut + 1) & m_masque;
+            --m_taille;
+            return element;
+        }
+
+    private:
+        // double la capacité en remettant les éléments dans l'ordre à partir de la case 0 ;
+        // gardé hors ligne pour ne pas alourdir ajouter() là où il est inséré
+        [[gnu::noinline, gnu::cold]] void agrandir() {
+            vector<T> tampon(m_tampon.size() * 2);
+            for (size_t i = 0; i < m_taille; ++i) {
+                tampon[i] = m_tampon[(m_debut + i) & m_masque];
+            }
+            m_tampon.swap(tampon);
+            m_masque = m_tampon.size() - 1;
+            m_debut = 0;
+        }
+
+        vector<T> m_tampon;
+        size_t m_masque;
+        size_t m_debut;   // case du premier élément
+        size_t m_taille;  // nombre d'éléments dans la file
+    };
+
+} // namespace TP
+
+#endif // FILECIRCULAIRE_H
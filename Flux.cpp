@@ -0,0 +1,114 @@
+#include "Flux.h"
+#include <algorithm>
+#include "ContratModule.h"
+
+// SourceTexte
+
+/**
+ * @brief Constructeur de la source texte.
+ * @param entree trace texte au format "pid arrivee duree restant priorite type [echeance] [rafales]".
+ * @param erreurs flux où sont rapportées les lignes invalides.
+ */
+TP::SourceTexte::SourceTexte(istream& entree, ostream& erreurs)
+    : m_entree(entree), m_erreurs(erreurs), m_numero(0), m_nbErreurs(0), m_nbHorsOrdre(0),
+      m_derniereArrivee(0) {
+}
+
+/**
+ * @brief lit la prochaine ligne valide de la trace.
+ * @param processus champs de la ligne ; le pid et les rafales pointent dans les tampons de la source.
+ * @return false à la fin de la trace.
+ */
+bool TP::SourceTexte::suivant(LigneTrace& processus) {
+    while (getline(m_entree, m_ligne)) {
+        ++m_numero;
+        if (analyserLigneTrace(m_ligne, processus, m_rafales)) {
+            if (processus.arrivee >= m_derniereArrivee) {
+                m_derniereArrivee = processus.arrivee;
+                return true;
+            }
+            ++m_nbHorsOrdre;
+            m_erreurs << "ligne " << m_numero << " ignoree : arrivee " << processus.arrivee << " avant "
+                      << m_derniereArrivee << " (la trace doit etre triee par arrivee)\n";
+        } else if (!estLigneVide(m_ligne)) {
+            ++m_nbErreurs;
+            m_erreurs << "ligne " << m_numero << " ignoree : " << m_ligne << "\n";
+        }
+    }
+    return false;
+}
+
+// PuitsTexte
+
+TP::PuitsTexte::PuitsTexte(ostream& sortie) : m_sortie(sortie), m_nbTermines(0), m_attenteTotale(0) {
+}
+
+void TP::PuitsTexte::recevoir(const TableProcessus& table, IdProcessus id) {
+    m_sortie << table.pid(id) << " arrivee : " << table.arrivee(id) << " Duree : " << table.duree(id)
+             << " temps d'attente : " << table.attente(id) << " Priorite : " << table.priorite(id)
+             << " Type : " << (table.type(id) + 1) << "\n";
+    ++m_nbTermines;
+    m_attenteTotale += table.attente(id);
+}
+
+double TP::PuitsTexte::attenteMoyenne() const {
+    return m_nbTermines == 0 ? 0.0 : static_cast<double>(m_attenteTotale) / m_nbTermines;
+}
+
+// PuitsCollecte
+
+TP::PuitsCollecte::PuitsCollecte(size_t prevus) {
+    m_terminaisons.reserve(prevus);
+}
+
+void TP::PuitsCollecte::recevoir(const TableProcessus& table, IdProcessus id) {
+    m_terminaisons.push_back(table.terminaison(id));
+}
+
+// PuitsStatistiques
+
+void TP::PuitsStatistiques::recevoir(const TableProcessus& table, IdProcessus id) {
+    Terminaison t = table.terminaison(id);
+    ++m_nbTermines;
+    m_attenteTotale += t.attente;
+    m_entreesSortiesTotale += t.entreesSorties;
+    m_rotationTotale += t.fin - t.arrivee;
+    m_reponseTotale += t.premierDemarrage - t.arrivee;
+    m_tranchesTotales += t.nbTranches;
+    m_attenteMax = max(m_attenteMax, t.attente);
+    m_finMax = max(m_finMax, t.fin);
+}
+
+// PuitsStatistiquesParType
+
+void TP::PuitsStatistiquesParType::recevoir(const TableProcessus& table, IdProcessus id) {
+    m_tous.recevoir(table, id);
+    m_parType[table.type(id)].recevoir(table, id);
+}
+
+// PuitsCsv
+
+TP::PuitsCsv::PuitsCsv(ostream& sortie) : m_sortie(sortie) {
+    m_sortie << "pid,arrivee,duree,premier_demarrage,fin,attente,tranches,entrees_sorties\n";
+}
+
+void TP::PuitsCsv::recevoir(const TableProcessus& table, IdProcessus id) {
+    Terminaison t = table.terminaison(id);
+    m_sortie << table.pid(id) << ',' << t.arrivee << ',' << t.duree << ',' << t.premierDemarrage << ',' << t.fin
+             << ',' << t.attente << ',' << t.nbTranches << ',' << t.entreesSorties << '\n';
+}
+
+// PuitsMultiple
+
+TP::PuitsMultiple::PuitsMultiple(vector<PuitsProcessus*> puits) : m_puits(std::move(puits)) {
+}
+
+void TP::PuitsMultiple::recevoir(const TableProcessus& table, IdProcessus id) {
+    for (PuitsProcessus* puits : m_puits) {
+        puits->recevoir(table, id);
+    }
+}
+
+bool TP::PuitsMultiple::arreter() const {
+    return any_of(m_puits.begin(), m_puits.end(), [](const PuitsProcessus* puits) { return puits->arreter(); });
+}
@@ -0,0 +1,205 @@
+#include "ChargeurTrace.h"
+#include "TableProcessus.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Flux.h
+#ifndef FLUX_H
+#define FLUX_H
+
+namespace TP {
+
+    /**
+     * @brief source des processus du mode flux, lus un à un dans l'ordre d'arrivée.
+     *
+     * le moteur ne lit le processus suivant qu'au moment où le précédent arrive dans le système ;
+     * une trace de longueur quelconque est ainsi simulée sans être chargée.
+     */
+    class SourceProcessus {
+    public:
+        virtual ~SourceProcessus() = default;
+
+        // lit le processus suivant, dont le pid et les rafales restent valides jusqu'au prochain
+        // appel ; false à la fin du flux
+        virtual bool suivant(LigneTrace& processus) = 0;
+    };
+
+    /**
+     * @brief destination des processus terminés, reçus dès leur terminaison.
+     *
+     * en mode flux, la case du processus est recyclée au retour de recevoir() : le puits doit
+     * copier ce qu'il veut garder, par exemple table.terminaison(id).
+     */
+    class PuitsProcessus {
+    public:
+        virtual ~PuitsProcessus() = default;
+
+        virtual void recevoir(const TableProcessus& table, IdProcessus id) = 0;
+
+        // consulté après chaque réception : vrai pour interrompre la simulation
+        virtual bool arreter() const { return false; }
+    };
+
+    /**
+     * @brief lit une trace texte ligne à ligne depuis un flux d'entrée.
+     *
+     * les lignes invalides sont rapportées sur le flux d'erreurs avec leur numéro, puis ignorées.
+     * La trace doit être triée par arrivée : le moteur ne remonte pas le temps, une ligne dont
+     * l'arrivée précède celle de la dernière ligne gardée est donc rapportée de même et ignorée.
+     */
+    class SourceTexte : public SourceProcessus {
+    public:
+        SourceTexte(istream& entree, ostream& erreurs);
+
+        bool suivant(LigneTrace& processus) override;
+
+        size_t nbErreurs() const { return m_nbErreurs; }
+        size_t nbHorsOrdre() const { return m_nbHorsOrdre; }
+
+    private:
+        istream& m_entree;
+        ostream& m_erreurs;
+        string m_ligne;          // tampon réutilisé d'une ligne à l'autre
+        vector<int32_t> m_rafales;
+        size_t m_numero;         // numéro de la dernière ligne lue
+        size_t m_nbErreurs;
+        size_t m_nbHorsOrdre;
+        int m_derniereArrivee;
+    };
+
+    // écrit chaque processus terminé au format de l'affichage des résultats et cumule l'attente
+    class PuitsTexte : public PuitsProcessus {
+    public:
+        explicit PuitsTexte(ostream& sortie);
+
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+        size_t nbTermines() const { return m_nbTermines; }
+        double attenteMoyenne() const;
+
+    private:
+        ostream& m_sortie;
+        size_t m_nbTermines;
+        int64_t m_attenteTotale;
+    };
+
+    // ignore les processus terminés, pour ne mesurer que la simulation
+    class PuitsNul : public PuitsProcessus {
+    public:
+        void recevoir(const TableProcessus&, IdProcessus) override {}
+    };
+
+    // garde le compte rendu de chaque processus terminé, dans l'ordre de terminaison
+    class PuitsCollecte : public PuitsProcessus {
+    public:
+        // prevus : nombre de processus attendus, pour réserver la place
+        explicit PuitsCollecte(size_t prevus = 0);
+
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+        const vector<Terminaison>& terminaisons() const { return m_terminaisons; }
+
+    private:
+        vector<Terminaison> m_terminaisons;
+    };
+
+    /**
+     * @brief cumule les mesures des processus terminés en mémoire constante, quel que soit leur
+     * nombre.
+     *
+     * rotation : de l'arrivée à la fin ; réponse : de l'arrivée à la première élection ;
+     * l'attente est celle du processeur, le temps passé en E/S est compté à part.
+     */
+    class PuitsStatistiques : public PuitsProcessus {
+    public:
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+        size_t nbTermines() const { return m_nbTermines; }
+        double attenteMoyenne() const { return moyenne(m_attenteTotale); }
+        double entreesSortiesMoyenne() const { return moyenne(m_entreesSortiesTotale); }
+        double rotationMoyenne() const { return moyenne(m_rotationTotale); }
+        double reponseMoyenne() const { return moyenne(m_reponseTotale); }
+        double tranchesMoyennes() const { return moyenne(m_tranchesTotales); }
+        int attenteMax() const { return m_attenteMax; }
+        int finMax() const { return m_finMax; }
+
+    private:
+        double moyenne(int64_t total) const {
+            return m_nbTermines == 0 ? 0.0 : static_cast<double>(total) / m_nbTermines;
+        }
+
+        size_t m_nbTermines = 0;
+        int64_t m_attenteTotale = 0;
+        int64_t m_entreesSortiesTotale = 0;
+        int64_t m_rotationTotale = 0;
+        int64_t m_reponseTotale = 0;
+        int64_t m_tranchesTotales = 0;
+        int m_attenteMax = 0;
+        int m_finMax = 0;
+    };
+
+    // les mesures de PuitsStatistiques pour tous les processus et pour chaque type
+    class PuitsStatistiquesParType : public PuitsProcessus {
+    public:
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+        const PuitsStatistiques& tous() const { return m_tous; }
+        const PuitsStatistiques& parType(TypeProcessus type) const { return m_parType[type]; }
+
+    private:
+        PuitsStatistiques m_tous;
+        array<PuitsStatistiques, 4> m_parType;
+    };
+
+    // écrit le compte rendu de chaque processus terminé, une ligne CSV par processus
+    class PuitsCsv : public PuitsProcessus {
+    public:
+        // écrit la ligne d'en-tête
+        explicit PuitsCsv(ostream& sortie);
+
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+    private:
+        ostream& m_sortie;
+    };
+
+    // remet chaque processus terminé à plusieurs puits ; s'arrête dès que l'un d'eux le demande
+    class PuitsMultiple : public PuitsProcessus {
+    public:
+        explicit PuitsMultiple(vector<PuitsProcessus*> puits);
+
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+        bool arreter() const override;
+
+    private:
+        vector<PuitsProcessus*> m_puits;
+    };
+
+    /**
+     * @brief remet chaque compte rendu à une fonction appelée comme visiteur(terminaison, pid),
+     * sans rien garder ; le pid n'est valide que pendant l'appel.
+     */
+    template<typename Visiteur>
+    class PuitsVisiteur : public PuitsProcessus {
+    public:
+        explicit PuitsVisiteur(Visiteur visiteur) : m_visiteur(std::move(visiteur)) {}
+
+        void recevoir(const TableProcessus& table, IdProcessus id) override {
+            m_visiteur(table.terminaison(id), table.pid(id));
+        }
+
+    private:
+        Visiteur m_visiteur;
+    };
+
+} // namespace TP
+
+#endif // FLUX_H
@@ -0,0 +1,275 @@
+#include "Generateur.h"
+#include "TraceBinaire.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <numeric>
+#include "ContratModule.h"
+
+namespace {
+
+    vector<double> cumuler(const vector<double>& poids) {
+        vector<double> cumuls(poids.size());
+        partial_sum(poids.begin(), poids.end(), cumuls.begin());
+        return cumuls;
+    }
+
+} // namespace
+
+/**
+ * @brief Constructeur du générateur.
+ * @param parametres lois et paramètres de la charge.
+ * \pre taux > 0, dureeMoyenne >= 1, formePareto > 1, dureeMax >= 1, laxite >= 0
+ * \pre entreesSorties >= 0, dureeEntreeSortie > 0
+ * \pre les poids sont positifs et au moins un est non nul
+ */
+TP::GenerateurCharge::GenerateurCharge(const ParametresCharge& parametres)
+    : m_parametres(parametres), m_alea(parametres.graine), m_numero(0), m_temps(0.0), m_enRafale(false),
+      m_finEtat(0.0), m_deborde(false), m_pid{'p'} {
+    PRECONDITION(parametres.taux > 0.0);
+    PRECONDITION(parametres.dureeMoyenne >= 1.0);
+    PRECONDITION(parametres.formePareto > 1.0);
+    PRECONDITION(parametres.dureeMax >= 1);
+    PRECONDITION(parametres.laxite >= 0.0);
+    PRECONDITION(parametres.entreesSorties >= 0.0 && parametres.dureeEntreeSortie > 0.0);
+    PRECONDITION(parametres.arrivees != RAFALES
+                 || (parametres.facteurRafale > 0.0 && parametres.dureeRafale > 0.0 && parametres.dureeCalme > 0.0));
+
+    const vector<double> types(parametres.poidsTypes.begin(), parametres.poidsTypes.end());
+    for (const vector<double>* poids : {&parametres.poidsPriorites, &types}) {
+        PRECONDITION(all_of(poids->begin(), poids->end(), [](double p) { return p >= 0.0; }));
+        PRECONDITION(accumulate(poids->begin(), poids->end(), 0.0) > 0.0);
+    }
+    m_cumulsPriorites = cumuler(parametres.poidsPriorites);
+    m_cumulsTypes = cumuler(types);
+
+    if (parametres.arrivees == RAFALES) {
+        m_finEtat = exponentielle(1.0 / parametres.dureeCalme);
+    }
+}
+
+/**
+ * @brief produit le processus suivant de la charge.
+ * @param processus champs du processus ; le pid pointe dans le générateur.
+ * @return false quand tous les processus ont été produits.
+ */
+bool TP::GenerateurCharge::suivant(LigneTrace& processus) {
+    if (m_numero == m_parametres.nbProcessus || m_deborde) {
+        return false;
+    }
+    m_temps = prochaineArrivee();
+    if (m_temps > INT32_MAX) {
+        m_deborde = true;
+        return false;
+    }
+
+    char* fin = to_chars(m_pid + 1, m_pid + sizeof m_pid, m_numero).ptr;
+    processus.pid = string_view(m_pid, fin - m_pid);
+    processus.arrivee = static_cast<int>(m_temps);
+    processus.duree = tirerDuree();
+    processus.priorite = static_cast<int>(choisir(m_cumulsPriorites));
+    processus.type = static_cast<TypeProcessus>(choisir(m_cumulsTypes));
+    processus.echeance = tirerEcheance(processus.duree);
+    tirerRafales(processus.duree);
+    processus.rafales = m_rafales;
+    ++m_numero;
+    return true;
+}
+
+uint64_t TP::GenerateurCharge::octetsPids(uint64_t n) {
+    uint64_t octets = n; // le 'p' de chaque pid
+    for (uint64_t debut = 0, fin = 10, chiffres = 1; debut < n; debut = fin, fin *= 10, ++chiffres) {
+        octets += (min(fin, n) - debut) * chiffres;
+    }
+    return octets;
+}
+
+// réel uniforme de [0, 1) à partir des 53 bits de poids fort
+double TP::GenerateurCharge::uniforme() {
+    return (m_alea() >> 11) * 0x1.0p-53;
+}
+
+double TP::GenerateurCharge::exponentielle(double taux) {
+    return -log1p(-uniforme()) / taux;
+}
+
+// loi normale centrée réduite (Box-Muller)
+double TP::GenerateurCharge::normale() {
+    double u = 1.0 - uniforme(); // dans (0, 1]
+    double v = uniforme();
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+size_t TP::GenerateurCharge::choisir(const vector<double>& cumuls) {
+    double cible = uniforme() * cumuls.back();
+    return min<size_t>(upper_bound(cumuls.begin(), cumuls.end(), cible) - cumuls.begin(), cumuls.size() - 1);
+}
+
+/**
+ * @brief instant de la prochaine arrivée.
+ *
+ * en rafales, le taux change à chaque fin de période ; la loi exponentielle étant sans mémoire,
+ * un intervalle qui franchit la fin de la période est simplement tiré à nouveau depuis cette fin.
+ */
+double TP::GenerateurCharge::prochaineArrivee() {
+    if (m_parametres.arrivees == POISSON) {
+        return m_temps + exponentielle(m_parametres.taux);
+    }
+    double temps = m_temps;
+    while (true) {
+        double taux = m_enRafale ? m_parametres.taux * m_parametres.facteurRafale : m_parametres.taux;
+        double candidat = temps + exponentielle(taux);
+        if (candidat <= m_finEtat) {
+            return candidat;
+        }
+        temps = m_finEtat;
+        m_enRafale = !m_enRafale;
+        m_finEtat += exponentielle(1.0 / (m_enRafale ? m_parametres.dureeRafale : m_parametres.dureeCalme));
+    }
+}
+
+// durée de moyenne dureeMoyenne selon la loi choisie, arrondie et tronquée à [1, dureeMax]
+int TP::GenerateurCharge::tirerDuree() {
+    double moyenne = m_parametres.dureeMoyenne;
+    double duree = 0.0;
+    switch (m_parametres.durees) {
+        case EXPONENTIELLE:
+            duree = exponentielle(1.0 / moyenne);
+            break;
+        case PARETO: {
+            double alpha = m_parametres.formePareto;
+            double minimum = moyenne * (alpha - 1.0) / alpha;
+            duree = minimum / pow(1.0 - uniforme(), 1.0 / alpha);
+            break;
+        }
+        case LOGNORMALE: {
+            double sigma = m_parametres.sigmaLognormale;
+            duree = exp(log(moyenne) - sigma * sigma / 2.0 + sigma * normale());
+            break;
+        }
+    }
+    return static_cast<int>(clamp(round(duree), 1.0, static_cast<double>(m_parametres.dureeMax)));
+}
+
+// sans laxité, aucun tirage : les traces déjà générées avec une graine restent identiques
+int TP::GenerateurCharge::tirerEcheance(int duree) {
+    if (m_parametres.laxite == 0.0) {
+        return 0;
+    }
+    double marge = 2.0 * m_parametres.laxite * uniforme();
+    return static_cast<int>(min(ceil(duree * (1.0 + marge)), static_cast<double>(INT32_MAX)));
+}
+
+/**
+ * @brief tire les rafales du processus : un nombre géométrique d'E/S, au plus duree - 1, coupe la
+ * durée en rafales processeur d'au moins une unité, au prorata de poids exponentiels.
+ *
+ * sans E/S demandées, aucun tirage : les traces déjà générées avec une graine restent identiques.
+ */
+void TP::GenerateurCharge::tirerRafales(int duree) {
+    m_rafales.clear();
+    if (m_parametres.entreesSorties == 0.0) {
+        return;
+    }
+    // P(k) = (1 - q) q^k, de moyenne q / (1 - q) = entreesSorties
+    double q = m_parametres.entreesSorties / (1.0 + m_parametres.entreesSorties);
+    double k = floor(log1p(-uniforme()) / log(q));
+    int nbEntreesSorties = static_cast<int>(min(k, static_cast<double>(duree - 1)));
+    if (nbEntreesSorties <= 0) {
+        return;
+    }
+
+    m_poidsRafales.resize(nbEntreesSorties + 1);
+    double total = 0.0;
+    for (double& poids : m_poidsRafales) {
+        poids = exponentielle(1.0);
+        total += poids;
+    }
+    // bornes cumulées arrondies : les rafales font exactement duree
+    int64_t surplus = duree - (nbEntreesSorties + 1);
+    double cumul = 0.0;
+    int64_t borne = 0;
+    for (int i = 0; i <= nbEntreesSorties; ++i) {
+        cumul += m_poidsRafales[i];
+        int64_t suivante = (i == nbEntreesSorties) ? surplus : llround(surplus * cumul / total);
+        suivante = clamp(suivante, borne, surplus);
+        m_rafales.push_back(static_cast<int32_t>(1 + suivante - borne));
+        borne = suivante;
+        if (i < nbEntreesSorties) {
+            double es = exponentielle(1.0 / m_parametres.dureeEntreeSortie);
+            m_rafales.push_back(static_cast<int32_t>(clamp(round(es), 1.0, static_cast<double>(m_parametres.dureeMax))));
+        }
+    }
+}
+
+/**
+ * @brief écrit la charge au format texte, par blocs, en mémoire constante.
+ * @return false si l'écriture a échoué ou si les arrivées ont dépassé INT32_MAX.
+ */
+bool TP::ecrireChargeTexte(const ParametresCharge& parametres, ostream& sortie) {
+    constexpr size_t TAILLE_BLOC = 1 << 20;
+    constexpr size_t LIGNE_MAX = 96;
+
+    GenerateurCharge generateur(parametres);
+    string bloc(TAILLE_BLOC + LIGNE_MAX, '\0');
+    char* p = bloc.data();
+    LigneTrace l;
+    while (generateur.suivant(l)) {
+        // une longue liste de rafales peut dépasser la marge d'une ligne : le bloc est vidé avant
+        size_t ligne = LIGNE_MAX + 12 * l.rafales.size();
+        if (static_cast<size_t>(p - bloc.data()) + ligne > bloc.size()) {
+            sortie.write(bloc.data(), p - bloc.data());
+            if (ligne > bloc.size()) {
+                bloc.resize(ligne);
+            }
+            p = bloc.data();
+        }
+        p = copy(l.pid.begin(), l.pid.end(), p);
+        *p++ = ' ';
+        p = to_chars(p, p + 12, l.arrivee).ptr;
+        *p++ = ' ';
+        p = to_chars(p, p + 12, l.duree).ptr;
+        *p++ = ' ';
+        *p++ = '0';
+        *p++ = ' ';
+        p = to_chars(p, p + 12, l.priorite).ptr;
+        *p++ = ' ';
+        *p++ = static_cast<char>('1' + l.type);
+        if (l.echeance != 0) {
+            *p++ = ' ';
+            p = to_chars(p, p + 12, l.echeance).ptr;
+        }
+        for (size_t i = 0; i < l.rafales.size(); ++i) {
+            *p++ = (i == 0) ? ' ' : ',';
+            p = to_chars(p, p + 12, l.rafales[i]).ptr;
+        }
+        *p++ = '\n';
+        if (static_cast<size_t>(p - bloc.data()) >= TAILLE_BLOC) {
+            sortie.write(bloc.data(), p - bloc.data());
+            p = bloc.data();
+        }
+    }
+    sortie.write(bloc.data(), p - bloc.data());
+    return static_cast<bool>(sortie.flush()) && !generateur.aDeborde();
+}
+
+/**
+ * @brief écrit la charge en trace binaire, en mémoire constante.
+ * @return false si l'écriture a échoué ou si les arrivées ont dépassé INT32_MAX.
+ * \pre nbProcessus < UINT32_MAX
+ */
+bool TP::ecrireChargeBinaire(const ParametresCharge& parametres, const string& chemin) {
+    EcrivainTraceBinaire ecrivain(chemin, parametres.nbProcessus, GenerateurCharge::octetsPids(parametres.nbProcessus),
+                                  parametres.entreesSorties > 0.0);
+    if (!ecrivain.estOuvert()) {
+        return false;
+    }
+    GenerateurCharge generateur(parametres);
+    LigneTrace l;
+    while (generateur.suivant(l)) {
+        ecrivain.ajouter(l.pid, l.arrivee, l.duree, l.priorite, l.type, l.echeance, l.rafales);
+    }
+    return ecrivain.terminer() && !generateur.aDeborde();
+}
@@ -0,0 +1,111 @@
+#include "Flux.h"
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Generateur.h
+#ifndef GENERATEUR_H
+#define GENERATEUR_H
+
+namespace TP {
+
+    enum LoiArrivees {
+        POISSON,        // intervalles exponentiels de taux constant
+        RAFALES         // Poisson modulé : périodes calmes et rafales de taux plus élevé, en alternance
+    };
+
+    enum LoiDurees {
+        EXPONENTIELLE,
+        PARETO,         // queue lourde : quelques processus très longs
+        LOGNORMALE
+    };
+
+    // paramètres d'une charge synthétique ; les temps sont en unités de la simulation
+    struct ParametresCharge {
+        uint64_t nbProcessus = 1000;
+        uint64_t graine = 1;
+
+        LoiArrivees arrivees = POISSON;
+        double taux = 0.1;                  // arrivées par unité de temps (hors rafale)
+        double facteurRafale = 10.0;        // taux d'une rafale / taux
+        double dureeRafale = 50.0;          // durée moyenne d'une rafale
+        double dureeCalme = 500.0;          // durée moyenne entre deux rafales
+
+        LoiDurees durees = EXPONENTIELLE;
+        double dureeMoyenne = 10.0;
+        double formePareto = 1.5;           // alpha > 1 ; plus il est petit, plus la queue est lourde
+        double sigmaLognormale = 1.0;
+        int dureeMax = 1000000;             // les durées tirées sont tronquées à [1, dureeMax]
+
+        // 0 : aucune échéance ; sinon, échéance relative = durée × (1 + marge), la marge étant
+        // tirée uniformément dans [0, 2 × laxite] (de moyenne laxite)
+        double laxite = 0.0;
+
+        // nombre moyen d'E/S par processus (loi géométrique), 0 pour une seule rafale processeur ;
+        // la durée est alors coupée en rafales aléatoires d'au moins une unité
+        double entreesSorties = 0.0;
+        double dureeEntreeSortie = 20.0;    // durée moyenne d'une E/S (exponentielle, tronquée à [1, dureeMax])
+
+        vector<double> poidsPriorites = {1, 1, 1, 1, 1, 1}; // poids de la priorité 0, 1, ...
+        array<double, 4> poidsTypes = {1, 1, 1, 1};          // poids de SYSTEME à UTILISATEUR
+    };
+
+    /**
+     * @brief générateur de charge synthétique reproductible : une même graine donne la même trace.
+     *
+     * les processus sont produits un à un dans l'ordre d'arrivée, en mémoire constante ; le
+     * générateur est aussi une source du mode flux. Les tirages n'utilisent que mt19937_64 et
+     * des transformations explicites (pas les lois de <random>, dont le résultat dépend de la
+     * bibliothèque standard), pour que la trace ne dépende pas du compilateur.
+     */
+    class GenerateurCharge : public SourceProcessus {
+    public:
+        explicit GenerateurCharge(const ParametresCharge& parametres);
+
+        // processus suivant, pid "p<numéro>" ; false après nbProcessus processus
+        bool suivant(LigneTrace& processus) override;
+
+        // vrai si la génération s'est arrêtée parce que les arrivées dépassaient INT32_MAX
+        bool aDeborde() const { return m_deborde; }
+
+        // longueur totale des pids de n processus générés
+        static uint64_t octetsPids(uint64_t n);
+
+    private:
+        double uniforme();
+        double exponentielle(double taux);
+        double normale();
+        size_t choisir(const vector<double>& cumuls);
+        double prochaineArrivee();
+        int tirerDuree();
+        int tirerEcheance(int duree);
+        void tirerRafales(int duree);
+
+        ParametresCharge m_parametres;
+        mt19937_64 m_alea;
+        vector<double> m_cumulsPriorites;
+        vector<double> m_cumulsTypes;
+        uint64_t m_numero;
+        double m_temps;
+        bool m_enRafale;
+        double m_finEtat;                   // fin de la période calme ou de la rafale en cours
+        bool m_deborde;
+        char m_pid[24];
+        vector<int32_t> m_rafales;          // rafales du dernier processus, vide s'il n'a pas d'E/S
+        vector<double> m_poidsRafales;
+    };
+
+    // écrit la charge au format texte "pid arrivee duree restant priorite type", suivi de
+    // l'échéance si laxite > 0 et des rafales du processus s'il a des E/S
+    bool ecrireChargeTexte(const ParametresCharge& parametres, ostream& sortie);
+
+    // écrit la charge en trace binaire (voir TraceBinaire.h)
+    bool ecrireChargeBinaire(const ParametresCharge& parametres, const string& chemin);
+
+} // namespace TP
+
+#endif // GENERATEUR_H
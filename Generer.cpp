@@ -0,0 +1,189 @@
+#include "Generateur.h"
+#include "Arguments.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ContratModule.h"
+using namespace std;
+
+/**
+ * \file Generer.cpp
+ * \brief générateur de traces synthétiques en ligne de commande.
+ */
+
+namespace {
+
+    // liste de poids séparés par des virgules
+    bool lirePoids(const string& texte, vector<double>& poids) {
+        poids.clear();
+        stringstream flux(texte);
+        string element;
+        while (getline(flux, element, ',')) {
+            double p = 0.0;
+            if (!TP::lireNombre(element, p, 0.0)) {
+                return false;
+            }
+            poids.push_back(p);
+        }
+        return !poids.empty();
+    }
+
+    struct Options {
+        TP::ParametresCharge parametres;
+        bool binaire = false;
+        string sortie = "-";
+    };
+
+    // lit la valeur d'une option ; false si l'option est inconnue ou sa valeur invalide
+    bool lireOption(const string& option, const string& valeur, Options& options) {
+        TP::ParametresCharge& p = options.parametres;
+        if (option == "--processus") {
+            return TP::lireCompte(valeur, p.nbProcessus);
+        }
+        if (option == "--graine") {
+            return TP::lireNombre(valeur, p.graine);
+        }
+        if (option == "--arrivees") {
+            if (valeur != "poisson" && valeur != "rafales") {
+                return false;
+            }
+            p.arrivees = (valeur == "poisson") ? TP::POISSON : TP::RAFALES;
+            return true;
+        }
+        if (option == "--taux") {
+            return TP::lireNombre(valeur, p.taux);
+        }
+        if (option == "--rafales") {
+            // facteur,duree_rafale,duree_calme
+            vector<double> r;
+            if (!lirePoids(valeur, r) || r.size() != 3) {
+                return false;
+            }
+            p.facteurRafale = r[0];
+            p.dureeRafale = r[1];
+            p.dureeCalme = r[2];
+            return true;
+        }
+        if (option == "--durees") {
+            if (valeur == "exponentielle") {
+                p.durees = TP::EXPONENTIELLE;
+            } else if (valeur == "pareto") {
+                p.durees = TP::PARETO;
+            } else if (valeur == "lognormale") {
+                p.durees = TP::LOGNORMALE;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (option == "--duree-moyenne") {
+            return TP::lireNombre(valeur, p.dureeMoyenne);
+        }
+        if (option == "--forme") {
+            return TP::lireNombre(valeur, p.formePareto);
+        }
+        if (option == "--sigma") {
+            return TP::lireNombre(valeur, p.sigmaLognormale);
+        }
+        if (option == "--duree-max") {
+            return TP::lireNombre(valeur, p.dureeMax);
+        }
+        if (option == "--laxite") {
+            return TP::lireNombre(valeur, p.laxite);
+        }
+        if (option == "--es") {
+            // nombre_moyen,duree_moyenne
+            vector<double> es;
+            if (!lirePoids(valeur, es) || es.size() != 2) {
+                return false;
+            }
+            p.entreesSorties = es[0];
+            p.dureeEntreeSortie = es[1];
+            return true;
+        }
+        if (option == "--priorites") {
+            return lirePoids(valeur, p.poidsPriorites);
+        }
+        if (option == "--types") {
+            vector<double> types;
+            if (!lirePoids(valeur, types) || types.size() != p.poidsTypes.size()) {
+                return false;
+            }
+            copy(types.begin(), types.end(), p.poidsTypes.begin());
+            return true;
+        }
+        if (option == "--sortie") {
+            options.sortie = valeur;
+            return true;
+        }
+        return false;
+    }
+
+    // une option invalide est rapportée avec sa valeur
+    bool lireOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            string option = argv[i];
+            if (option == "--binaire") {
+                options.binaire = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            string valeur = argv[++i];
+            if (!lireOption(option, valeur, options)) {
+                cerr << "erreur : option " << option << " " << valeur << " invalide." << endl;
+                return false;
+            }
+        }
+
+        const TP::ParametresCharge& p = options.parametres;
+        double somme = 0.0;
+        for (double poids : p.poidsPriorites) {
+            somme += poids;
+        }
+        double sommeTypes = p.poidsTypes[0] + p.poidsTypes[1] + p.poidsTypes[2] + p.poidsTypes[3];
+        return p.taux > 0.0 && p.dureeMoyenne >= 1.0 && p.formePareto > 1.0 && p.sigmaLognormale >= 0.0
+               && p.dureeMax >= 1 && p.laxite >= 0.0 && p.facteurRafale > 0.0 && p.dureeRafale > 0.0
+               && p.dureeCalme > 0.0 && p.dureeEntreeSortie > 0.0
+               && somme > 0.0 && sommeTypes > 0.0 && !(options.binaire && options.sortie == "-");
+    }
+
+} // namespace
+
+/**
+ * @brief fonction principale du générateur
+ *
+ * écrit une trace synthétique sur la sortie standard (ou dans --sortie), qui peut être
+ * redirigée directement vers le mode flux du simulateur.
+ *
+ * @return 0 si la trace est écrite en entier, 1 sinon
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!lireOptions(argc, argv, options)) {
+        cerr << "usage : " << argv[0] << " [--processus n] [--graine g] [--arrivees poisson|rafales] [--taux t]"
+             << " [--rafales facteur,duree,calme] [--durees exponentielle|pareto|lognormale] [--duree-moyenne m]"
+             << " [--forme alpha] [--sigma s] [--duree-max d] [--laxite l] [--es nombre,duree] [--priorites p0,p1,...] [--types s,i,b,u]"
+             << " [--binaire] [--sortie fichier]" << endl;
+        return 1;
+    }
+
+    bool succes;
+    if (options.binaire) {
+        succes = TP::ecrireChargeBinaire(options.parametres, options.sortie);
+    } else if (options.sortie == "-") {
+        ios::sync_with_stdio(false);
+        succes = TP::ecrireChargeTexte(options.parametres, cout);
+    } else {
+        ofstream fichier(options.sortie, ios::binary);
+        succes = fichier && TP::ecrireChargeTexte(options.parametres, fichier);
+    }
+    if (!succes) {
+        cerr << "Erreur : trace incomplete (ecriture impossible ou arrivees au-dela de " << INT32_MAX << ")" << endl;
+        return 1;
+    }
+    return 0;
+}
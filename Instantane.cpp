@@ -0,0 +1,224 @@
+#include "Instantane.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include "ContratModule.h"
+
+namespace {
+
+    constexpr char MAGIE[4] = {'P', 'S', 'S', 'I'};
+
+    // FNV-1a 64 bits
+    constexpr uint64_t FNV_BASE = 14695981039346656037ull;
+    constexpr uint64_t FNV_PREMIER = 1099511628211ull;
+
+    void hacher(uint64_t& empreinte, const void* donnees, size_t octets) {
+        const unsigned char* octet = static_cast<const unsigned char*>(donnees);
+        for (size_t i = 0; i < octets; ++i) {
+            empreinte = (empreinte ^ octet[i]) * FNV_PREMIER;
+        }
+    }
+
+    // vrai si l'état relu est cohérent avec la charge et l'instant de l'instantané
+    bool etatValide(const TP::EtatProcessus& e, const TP::TableProcessus& charge, int64_t temps, bool termine) {
+        if (e.id >= charge.taille() || e.restant < 0 || e.restant > charge.duree(e.id)
+            || 2 * uint64_t(e.rafaleCourante) > charge.entreesSorties(e.id).size()) {
+            return false;
+        }
+        if (termine) {
+            return e.restant == 0 && e.fin <= temps;
+        }
+        return e.restant > 0 && (e.reveil == -1 || e.reveil >= temps);
+    }
+
+} // namespace
+
+/**
+ * @brief empreinte des colonnes d'entrée d'une table : arrivées, durées, priorités, types,
+ * échéances et E/S, dans l'ordre des identifiants.
+ */
+uint64_t TP::empreinteCharge(const TableProcessus& table) {
+    ColonnesTrace c = table.colonnes();
+    uint64_t empreinte = FNV_BASE;
+    uint64_t n = c.nbProcessus;
+    hacher(empreinte, &n, sizeof(n));
+    hacher(empreinte, c.arrivee, c.nbProcessus * sizeof(int32_t));
+    hacher(empreinte, c.duree, c.nbProcessus * sizeof(int32_t));
+    hacher(empreinte, c.priorite, c.nbProcessus * sizeof(int32_t));
+    hacher(empreinte, c.type, c.nbProcessus * sizeof(uint8_t));
+    for (size_t id = 0; id < c.nbProcessus; ++id) {
+        int32_t echeance = c.echeance != nullptr ? c.echeance[id] : 0;
+        hacher(empreinte, &echeance, sizeof(echeance));
+    }
+    if (c.debutsRafales != nullptr) {
+        hacher(empreinte, c.debutsRafales, (c.nbProcessus + 1) * sizeof(uint64_t));
+        hacher(empreinte, c.rafales, c.nbValeursRafales * sizeof(int32_t));
+    }
+    return empreinte;
+}
+
+/**
+ * @brief écrit un instantané ; sa charge n'est pas écrite, seulement son empreinte.
+ * @param instantane instantané à écrire, avec sa charge.
+ * @param chemin chemin du fichier à créer.
+ * @return false si le fichier ne peut pas être écrit.
+ * \pre instantane.charge n'est pas nulle
+ */
+bool TP::ecrireInstantane(const Instantane& instantane, const string& chemin) {
+    static_assert(endian::native == endian::little, "le format d'instantane est petit-boutiste");
+    static_assert(sizeof(EtatProcessus) == 9 * sizeof(int32_t), "EtatProcessus est ecrit tel quel");
+    PRECONDITION(instantane.charge != nullptr);
+
+    EnTeteInstantane entete{};
+    memcpy(entete.magie, MAGIE, sizeof(MAGIE));
+    entete.version = VERSION_INSTANTANE;
+    entete.nbProcessus = instantane.charge->taille();
+    entete.empreinte = empreinteCharge(*instantane.charge);
+    entete.temps = instantane.temps;
+    entete.nbAdmis = instantane.nbAdmis;
+    entete.nbTermines = instantane.termines.size();
+    entete.nbEnCours = instantane.enCours.size();
+    entete.dernier = instantane.dernier;
+    entete.surcoutElu = instantane.surcoutElu;
+    entete.nbElections = instantane.nbElections;
+    entete.tempsOccupe = instantane.tempsOccupe;
+    entete.tempsCommutation = instantane.tempsCommutation;
+    instantane.politique.copy(entete.politique, sizeof(entete.politique) - 1);
+    entete.quantum = instantane.quantum;
+    entete.trancheElu = instantane.trancheElu;
+    entete.rehaussement = instantane.rehaussement;
+    entete.nbEtatPolitique = instantane.etatPolitique.size();
+
+    ofstream sortie(chemin, ios::binary | ios::trunc);
+    if (!sortie) {
+        return false;
+    }
+    sortie.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    sortie.write(reinterpret_cast<const char*>(instantane.termines.data()),
+                 static_cast<streamsize>(instantane.termines.size() * sizeof(EtatProcessus)));
+    sortie.write(reinterpret_cast<const char*>(instantane.enCours.data()),
+                 static_cast<streamsize>(instantane.enCours.size() * sizeof(EtatProcessus)));
+    sortie.write(reinterpret_cast<const char*>(instantane.etatPolitique.data()),
+                 static_cast<streamsize>(instantane.etatPolitique.size() * sizeof(int64_t)));
+    return static_cast<bool>(sortie.flush());
+}
+
+/**
+ * @brief relit un instantané et le rattache à sa charge.
+ *
+ * le contenu est validé : chaque processus appartient à la charge, chaque processus arrivé
+ * apparaît une seule fois, et les compteurs sont cohérents avec l'instant ; l'instantané peut
+ * ensuite être repris sans autre vérification, sauf l'état de la politique, que seule la file
+ * qui le relit peut valider (MoteurGenerique::reprendre).
+ * @param chemin fichier écrit par ecrireInstantane.
+ * @param charge charge relue depuis la trace de la simulation.
+ * @param instantane reçoit l'instantané.
+ * @param erreur reçoit la cause d'un échec.
+ * @return false si le fichier est illisible ou invalide, ou si la charge n'est pas la sienne.
+ * \pre charge n'est pas nulle
+ */
+bool TP::chargerInstantane(const string& chemin, shared_ptr<const TableProcessus> charge, Instantane& instantane,
+                           string& erreur) {
+    PRECONDITION(charge != nullptr);
+
+    ifstream entree(chemin, ios::binary);
+    if (!entree) {
+        erreur = "impossible d'ouvrir le fichier";
+        return false;
+    }
+    EnTeteInstantane entete{};
+    if (!entree.read(reinterpret_cast<char*>(&entete), sizeof(entete))) {
+        erreur = "en-tete tronque";
+        return false;
+    }
+    if (memcmp(entete.magie, MAGIE, sizeof(MAGIE)) != 0) {
+        erreur = "signature invalide";
+        return false;
+    }
+    if (entete.version != VERSION_INSTANTANE) {
+        erreur = "version " + to_string(entete.version) + " non prise en charge";
+        return false;
+    }
+    if (entete.nbProcessus != charge->taille() || entete.empreinte != empreinteCharge(*charge)) {
+        erreur = "la trace n'est pas celle de l'instantane";
+        return false;
+    }
+    if (entete.temps < 0 || entete.temps > INT32_MAX || entete.nbAdmis > entete.nbProcessus
+        || entete.nbTermines + entete.nbEnCours != entete.nbAdmis
+        || (entete.dernier != AUCUN_PROCESSUS && entete.dernier >= entete.nbProcessus)
+        || entete.surcoutElu < 0 || entete.surcoutElu > INT32_MAX
+        || (entete.surcoutElu > 0 && entete.dernier == AUCUN_PROCESSUS)
+        || entete.quantum < 0 || entete.quantum > INT32_MAX || entete.trancheElu < 0 || entete.trancheElu > INT32_MAX
+        || (entete.trancheElu > 0 && entete.nbEnCours == 0)
+        || (entete.rehaussement != -1 && (entete.rehaussement < entete.temps || entete.rehaussement > INT32_MAX))) {
+        erreur = "compteurs invalides";
+        return false;
+    }
+    // l'état d'une politique tient en quelques mots par processus arrivé, plus celui d'un générateur
+    // pseudo-aléatoire
+    if (memchr(entete.politique, '\0', sizeof(entete.politique)) == nullptr
+        || entete.nbEtatPolitique > 8 * entete.nbAdmis + 1024) {
+        erreur = "etat de la politique invalide";
+        return false;
+    }
+
+    Instantane lu;
+    lu.temps = static_cast<int>(entete.temps);
+    lu.charge = std::move(charge);
+    lu.nbAdmis = entete.nbAdmis;
+    lu.dernier = static_cast<IdProcessus>(entete.dernier);
+    lu.surcoutElu = static_cast<int>(entete.surcoutElu);
+    lu.nbElections = entete.nbElections;
+    lu.tempsOccupe = entete.tempsOccupe;
+    lu.tempsCommutation = entete.tempsCommutation;
+    lu.politique = entete.politique;
+    lu.quantum = static_cast<int>(entete.quantum);
+    lu.trancheElu = static_cast<int>(entete.trancheElu);
+    lu.rehaussement = entete.rehaussement;
+    lu.termines.resize(entete.nbTermines);
+    lu.enCours.resize(entete.nbEnCours);
+    lu.etatPolitique.resize(entete.nbEtatPolitique);
+    if (!entree.read(reinterpret_cast<char*>(lu.termines.data()),
+                     static_cast<streamsize>(lu.termines.size() * sizeof(EtatProcessus)))
+        || !entree.read(reinterpret_cast<char*>(lu.enCours.data()),
+                        static_cast<streamsize>(lu.enCours.size() * sizeof(EtatProcessus)))
+        || !entree.read(reinterpret_cast<char*>(lu.etatPolitique.data()),
+                        static_cast<streamsize>(lu.etatPolitique.size() * sizeof(int64_t)))) {
+        erreur = "processus tronques";
+        return false;
+    }
+    // l'élu qui poursuit sa tranche est le premier processus en cours, et il n'est pas en E/S
+    if (lu.trancheElu > 0 && (lu.enCours.front().reveil != -1 || lu.trancheElu > lu.enCours.front().restant)) {
+        erreur = "tranche de l'elu invalide";
+        return false;
+    }
+
+    // les processus arrivés sont exactement les nbAdmis premiers dans l'ordre d'arrivée : un
+    // processus ne peut y figurer qu'une fois
+    vector<bool> vus(lu.charge->taille(), false);
+    for (const vector<EtatProcessus>* liste : {&lu.termines, &lu.enCours}) {
+        bool termine = liste == &lu.termines;
+        for (const EtatProcessus& e : *liste) {
+            if (!etatValide(e, *lu.charge, lu.temps, termine) || vus[e.id]) {
+                erreur = "processus " + to_string(e.id) + " invalide";
+                return false;
+            }
+            vus[e.id] = true;
+        }
+    }
+    vector<IdProcessus> arrivees(lu.charge->taille());
+    for (IdProcessus id = 0; id < arrivees.size(); ++id) {
+        arrivees[id] = id;
+    }
+    stable_sort(arrivees.begin(), arrivees.end(), [&lu](IdProcessus a, IdProcessus b) {
+        return lu.charge->arrivee(a) < lu.charge->arrivee(b);
+    });
+    if (!all_of(arrivees.begin(), arrivees.begin() + lu.nbAdmis, [&vus](IdProcessus id) { return vus[id]; })) {
+        erreur = "processus arrives incoherents avec la trace";
+        return false;
+    }
+    instantane = std::move(lu);
+    return true;
+}
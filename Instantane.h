@@ -0,0 +1,145 @@
+#include "TableProcessus.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Instantane.h
+#ifndef INSTANTANE_H
+#define INSTANTANE_H
+
+namespace TP {
+
+    // état d'un processus arrivé, tel qu'un instantané le garde (format du fichier compris)
+    struct EtatProcessus {
+        IdProcessus id;
+        int32_t restant;
+        int32_t attente;            // fixée à sa terminaison
+        int32_t fin;
+        int32_t premierDemarrage;
+        uint32_t nbTranches;
+        uint32_t rafaleCourante;    // E/S déjà commencées
+        int32_t reveil;             // fin de son E/S s'il est bloqué, -1 sinon
+        int32_t dernierArret;       // instant où il a quitté le processeur, INT32_MIN s'il n'est pas connu
+    };
+
+    /**
+     * @brief instantané d'une simulation à un instant donné, indépendant de la politique.
+     *
+     * il garde l'horloge, les compteurs de chaque processus arrivé, les processus prêts, élu et
+     * bloqués, et les processus déjà terminés. La charge n'y est pas copiée : l'instantané la
+     * partage en lecture seule avec la simulation qui l'a pris et avec toutes ses branches, qui
+     * partagent à leur tour l'instantané lui-même.
+     *
+     * une branche (MoteurGenerique::reprendre) sous la politique et le quantum de l'instantané le
+     * prolonge exactement : la file retrouve son état (niveaux de mlfq, temps virtuels de cfs,
+     * avancées de stride, tirages de la loterie...) et l'élu poursuit sa tranche. Sous une autre
+     * politique, celle-ci prend la main comme un nouvel ordonnanceur : le processus élu est
+     * interrompu, puis les processus prêts lui sont remis comme des arrivées, l'ancien élu d'abord
+     * et les autres dans l'ordre de leur entrée dans l'ancienne file prête.
+     */
+    struct Instantane {
+        int temps = 0;
+        shared_ptr<const TableProcessus> charge;
+        size_t nbAdmis = 0;                     // processus arrivés, les premiers dans l'ordre d'arrivée
+        vector<EtatProcessus> termines;         // dans l'ordre de terminaison
+        vector<EtatProcessus> enCours;          // prêts (l'élu d'abord), puis bloqués
+        IdProcessus dernier = AUCUN_PROCESSUS;  // dernier processus élu
+        int surcoutElu = 0;                     // part de la commutation vers l'élu encore à payer,
+                                                // s'il est réélu le premier
+        uint64_t nbElections = 0;
+        int64_t tempsOccupe = 0;
+        int64_t tempsCommutation = 0;
+
+        string politique;                       // politique qui a pris l'instantané
+        int quantum = 0;                        // son quantum, 0 si elle n'en a pas (voir utiliseQuantum)
+        int trancheElu = 0;                     // reste de la tranche de l'élu après sa commutation,
+                                                // 0 si le processeur est libre
+        int64_t rehaussement = -1;              // instant du rehaussement en attente, -1 s'il n'y en a pas
+        vector<int64_t> etatPolitique;          // état de la file prête (voir FilePrete::sauver)
+    };
+
+    /**
+     * @brief lecture bornée de l'état d'une politique, qui peut venir d'un fichier : une valeur
+     * hors de ses bornes, ou lue après la fin, rend le lecteur invalide et vaut la borne inférieure.
+     */
+    class LecteurEtat {
+    public:
+        explicit LecteurEtat(const vector<int64_t>& etat) : m_etat(etat), m_position(0), m_valide(true) {}
+
+        int64_t lire(int64_t min, int64_t max) {
+            if (m_position == m_etat.size() || m_etat[m_position] < min || m_etat[m_position] > max) {
+                m_valide = false;
+                return min;
+            }
+            return m_etat[m_position++];
+        }
+
+        // la politique a trouvé l'état incohérent
+        void invalider() { m_valide = false; }
+
+        bool valide() const { return m_valide; }
+        bool fini() const { return m_position == m_etat.size(); }
+
+    private:
+        const vector<int64_t>& m_etat;
+        size_t m_position;
+        bool m_valide;
+    };
+
+    /**
+     * @brief en-tête d'un instantané enregistré (format petit-boutiste).
+     *
+     * <pre>
+     * EnTeteInstantane
+     * EtatProcessus termines[nbTermines]
+     * EtatProcessus enCours[nbEnCours]
+     * int64_t etatPolitique[nbEtatPolitique]
+     * </pre>
+     * la charge n'est pas dans le fichier : elle est relue depuis sa trace, reconnue par son
+     * nombre de processus et son empreinte (voir empreinteCharge).
+     */
+    struct EnTeteInstantane {
+        char magie[4];              // "PSSI"
+        uint32_t version;           // VERSION_INSTANTANE
+        uint64_t nbProcessus;
+        uint64_t empreinte;
+        int64_t temps;
+        uint64_t nbAdmis;
+        uint64_t nbTermines;
+        uint64_t nbEnCours;
+        uint64_t dernier;
+        int64_t surcoutElu;
+        uint64_t nbElections;
+        int64_t tempsOccupe;
+        int64_t tempsCommutation;
+        char politique[32];         // terminé par un zéro
+        int64_t quantum;
+        int64_t trancheElu;
+        int64_t rehaussement;
+        uint64_t nbEtatPolitique;
+    };
+
+    constexpr uint32_t VERSION_INSTANTANE = 2;
+
+    // empreinte des colonnes d'entrée de la table (FNV-1a) ; les pids n'y entrent pas
+    uint64_t empreinteCharge(const TableProcessus& table);
+
+    // écrit l'instantané, sans sa charge ; false si le fichier ne peut pas être écrit
+    bool ecrireInstantane(const Instantane& instantane, const string& chemin);
+
+    /**
+     * @brief relit un instantané enregistré par ecrireInstantane.
+     * @param charge la charge de la simulation, relue depuis sa trace ; elle doit avoir
+     * l'empreinte enregistrée.
+     * @return false, avec la cause dans erreur, si le fichier est illisible ou invalide, ou si la
+     * charge n'est pas la sienne.
+     */
+    bool chargerInstantane(const string& chemin, shared_ptr<const TableProcessus> charge, Instantane& instantane,
+                           string& erreur);
+
+} // namespace TP
+
+#endif // INSTANTANE_H
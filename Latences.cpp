@@ -0,0 +1,136 @@
+#include "Latences.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <string>
+#include "ContratModule.h"
+
+// Histogramme
+
+TP::Histogramme::Histogramme() : m_cases(NB_CASES, 0), m_nombre(0), m_somme(0), m_max(0) {
+}
+
+/**
+ * @brief compte une valeur.
+ * \pre 0 <= valeur <= INT32_MAX
+ */
+void TP::Histogramme::ajouter(int64_t valeur) {
+    PRECONDITION(valeur >= 0 && valeur <= INT32_MAX);
+    ++m_cases[indice(static_cast<uint64_t>(valeur))];
+    ++m_nombre;
+    m_somme += valeur;
+    m_max = std::max(m_max, valeur);
+}
+
+void TP::Histogramme::fusionner(const Histogramme& autre) {
+    for (size_t i = 0; i < NB_CASES; ++i) {
+        m_cases[i] += autre.m_cases[i];
+    }
+    m_nombre += autre.m_nombre;
+    m_somme += autre.m_somme;
+    m_max = std::max(m_max, autre.m_max);
+}
+
+/**
+ * \pre 0 < p <= 1
+ */
+int64_t TP::Histogramme::centile(double p) const {
+    PRECONDITION(p > 0.0 && p <= 1.0);
+    if (m_nombre == 0) {
+        return 0;
+    }
+    uint64_t rang = std::max<uint64_t>(1, static_cast<uint64_t>(ceil(p * m_nombre)));
+    uint64_t cumul = 0;
+    for (size_t i = 0; i < NB_CASES; ++i) {
+        cumul += m_cases[i];
+        if (cumul >= rang) {
+            return std::min(plusGrande(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+// plus grande valeur comptée dans une case
+int64_t TP::Histogramme::plusGrande(size_t indice) {
+    if (indice < 2 * DEMI) {
+        return static_cast<int64_t>(indice);
+    }
+    size_t e = indice / DEMI - 1;
+    int64_t mantisse = static_cast<int64_t>(indice - e * DEMI);
+    return ((mantisse + 1) << e) - 1;
+}
+
+// PuitsLatences
+
+TP::PuitsLatences::PuitsLatences(vector<int> bornes) : m_bornes(std::move(bornes)), m_parBande(m_bornes.size() + 1) {
+    PRECONDITION(m_bornes.empty() || m_bornes.front() > 0);
+    PRECONDITION(adjacent_find(m_bornes.begin(), m_bornes.end(), greater_equal<int>()) == m_bornes.end());
+}
+
+void TP::PuitsLatences::recevoir(const TableProcessus& table, IdProcessus id) {
+    Terminaison t = table.terminaison(id);
+    size_t bande = upper_bound(m_bornes.begin(), m_bornes.end(), table.priorite(id)) - m_bornes.begin();
+    for (HistogrammesLatence* h : {&m_tous, &m_parType[table.type(id)], &m_parBande[bande]}) {
+        (*h)[ATTENTE].ajouter(t.attente);
+        (*h)[ROTATION].ajouter(static_cast<int64_t>(t.fin) - t.arrivee);
+        (*h)[REPONSE].ajouter(static_cast<int64_t>(t.premierDemarrage) - t.arrivee);
+    }
+}
+
+void TP::PuitsLatences::fusionner(const PuitsLatences& autre) {
+    PRECONDITION(m_bornes == autre.m_bornes);
+
+    auto fusionnerCategorie = [](HistogrammesLatence& h, const HistogrammesLatence& a) {
+        for (size_t l = 0; l < NB_LATENCES; ++l) {
+            h[l].fusionner(a[l]);
+        }
+    };
+    fusionnerCategorie(m_tous, autre.m_tous);
+    for (size_t t = 0; t < m_parType.size(); ++t) {
+        fusionnerCategorie(m_parType[t], autre.m_parType[t]);
+    }
+    for (size_t b = 0; b < m_parBande.size(); ++b) {
+        fusionnerCategorie(m_parBande[b], autre.m_parBande[b]);
+    }
+}
+
+namespace {
+
+    void ecrireCategorie(ostream& sortie, const string& nom, const TP::HistogrammesLatence& h) {
+        static const char* NOMS[TP::NB_LATENCES] = {"attente", "rotation", "reponse"};
+        if (h[TP::ATTENTE].nombre() == 0) {
+            return;
+        }
+        sortie << nom << " (" << h[TP::ATTENTE].nombre() << " processus)\n";
+        for (size_t l = 0; l < TP::NB_LATENCES; ++l) {
+            sortie << "  " << left << setw(9) << NOMS[l] << right << " : " << h[l].centile(0.50) << " / "
+                   << h[l].centile(0.95) << " / " << h[l].centile(0.99) << " / " << h[l].max() << "\n";
+        }
+    }
+
+} // namespace
+
+void TP::ecrireLatences(ostream& sortie, const PuitsLatences& latences, bool detail) {
+    sortie << "latences p50 / p95 / p99 / max :\n";
+    ecrireCategorie(sortie, "tous", latences.tous());
+    if (!detail) {
+        return;
+    }
+    for (int type = SYSTEME; type <= UTILISATEUR; ++type) {
+        ecrireCategorie(sortie, "type " + to_string(type + 1), latences.parType(static_cast<TypeProcessus>(type)));
+    }
+    const vector<int>& bornes = latences.bornes();
+    for (size_t b = 0; b < latences.nbBandes(); ++b) {
+        int debut = (b == 0) ? 0 : bornes[b - 1];
+        string nom = "priorite " + to_string(debut);
+        if (b < bornes.size()) {
+            if (bornes[b] - 1 > debut) {
+                nom += "-" + to_string(bornes[b] - 1);
+            }
+        } else {
+            nom += "+";
+        }
+        ecrireCategorie(sortie, nom, latences.parBande(b));
+    }
+}
@@ -0,0 +1,119 @@
+#include "Flux.h"
+#include "TableProcessus.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+using namespace std;
+
+// Latences.h
+#ifndef LATENCES_H
+#define LATENCES_H
+
+namespace TP {
+
+    /**
+     * @brief histogramme à précision relative bornée (à la manière de HdrHistogram), pour les
+     * valeurs de 0 à INT32_MAX.
+     *
+     * les valeurs inférieures à 2^BITS_PRECISION ont chacune leur case ; au-delà, chaque
+     * intervalle [2^e, 2^(e+1)) est découpé en 2^(BITS_PRECISION-1) cases de même largeur.
+     * Une valeur est donc connue à 2^(1-BITS_PRECISION) près (0,8 %), en mémoire fixe quel
+     * que soit le nombre de valeurs. Deux histogrammes se fusionnent en additionnant leurs cases.
+     */
+    class Histogramme {
+    public:
+        static constexpr int BITS_PRECISION = 8;
+
+        Histogramme();
+
+        // \pre 0 <= valeur
+        void ajouter(int64_t valeur);
+        void fusionner(const Histogramme& autre);
+
+        uint64_t nombre() const { return m_nombre; }
+        int64_t max() const { return m_max; }
+        double moyenne() const { return m_nombre == 0 ? 0.0 : static_cast<double>(m_somme) / m_nombre; }
+
+        /**
+         * valeur du centile p (0 < p <= 1) : la plus grande valeur de la case où tombe la
+         * ceil(p * nombre)-ième valeur, bornée par le maximum ; 0 si l'histogramme est vide.
+         */
+        int64_t centile(double p) const;
+
+    private:
+        static constexpr size_t DEMI = size_t(1) << (BITS_PRECISION - 1);
+
+        static constexpr size_t indice(uint64_t valeur) {
+            if (valeur < 2 * DEMI) {
+                return valeur;
+            }
+            int e = 64 - __builtin_clzll(valeur) - BITS_PRECISION;
+            return e * DEMI + (valeur >> e);
+        }
+        static int64_t plusGrande(size_t indice);
+
+        // INT32_MAX a pour exposant e = 31 - BITS_PRECISION et pour mantisse 2 * DEMI - 1
+        static constexpr size_t NB_CASES = (33 - BITS_PRECISION) * DEMI;
+
+        vector<uint64_t> m_cases;
+        uint64_t m_nombre;
+        int64_t m_somme;
+        int64_t m_max;
+    };
+
+    // mesures de latence d'un processus terminé
+    enum Latence {
+        ATTENTE,        // temps passé prêt mais non élu
+        ROTATION,       // de l'arrivée à la fin
+        REPONSE         // de l'arrivée à la première élection
+    };
+    constexpr size_t NB_LATENCES = 3;
+
+    // les trois histogrammes de latence d'une catégorie de processus
+    using HistogrammesLatence = array<Histogramme, NB_LATENCES>;
+
+    /**
+     * @brief puits qui tient la distribution de l'attente, de la rotation et de la réponse, pour
+     * tous les processus, par type et par bande de priorité.
+     *
+     * la mémoire est fixée à la construction. Des puits de simulations menées en parallèle se
+     * fusionnent avec fusionner().
+     */
+    class PuitsLatences : public PuitsProcessus {
+    public:
+        /**
+         * bornes : premières priorités des bandes suivant la première ; {1, 3, 5} donne les bandes
+         * 0, 1-2, 3-4 et 5 et plus.
+         * \pre bornes strictement croissantes et positives
+         */
+        explicit PuitsLatences(vector<int> bornes = {1, 3, 5});
+
+        void recevoir(const TableProcessus& table, IdProcessus id) override;
+
+        // \pre mêmes bornes de bandes
+        void fusionner(const PuitsLatences& autre);
+
+        const HistogrammesLatence& tous() const { return m_tous; }
+        const HistogrammesLatence& parType(TypeProcessus type) const { return m_parType[type]; }
+        size_t nbBandes() const { return m_parBande.size(); }
+        const HistogrammesLatence& parBande(size_t bande) const { return m_parBande[bande]; }
+        const vector<int>& bornes() const { return m_bornes; }
+
+    private:
+        vector<int> m_bornes;
+        HistogrammesLatence m_tous;
+        array<HistogrammesLatence, 4> m_parType;
+        vector<HistogrammesLatence> m_parBande;
+    };
+
+    /**
+     * @brief écrit p50, p95, p99 et max de chaque latence, pour tous les processus et, avec le
+     * détail, pour chaque type et chaque bande de priorité qui en a reçu.
+     */
+    void ecrireLatences(ostream& sortie, const PuitsLatences& latences, bool detail);
+
+} // namespace TP
+
+#endif // LATENCES_H
@@ -0,0 +1,18 @@
+#include "Moteur.h"
+#include "Politiques.h"
+#include "ContratModule.h"
+
+// la boucle de simulation est définie dans Moteur.h et instanciée ici, une fois pour la file
+// virtuelle et une fois par file concrète
+template class TP::MoteurGenerique<TP::FilePrete>;
+template class TP::MoteurGenerique<TP::FileFifo>;
+template class TP::MoteurGenerique<TP::FileCourtDabord>;
+template class TP::MoteurGenerique<TP::FilePriorite>;
+template class TP::MoteurGenerique<TP::FileRestantCourt>;
+template class TP::MoteurGenerique<TP::FilePrioritePreemptive>;
+template class TP::MoteurGenerique<TP::FileEcheance>;
+template class TP::MoteurGenerique<TP::FileMultiniveaux>;
+template class TP::MoteurGenerique<TP::FileRetroaction>;
+template class TP::MoteurGenerique<TP::FileEquitable>;
+template class TP::MoteurGenerique<TP::FileLoterie>;
+template class TP::MoteurGenerique<TP::FileStride>;
@@ -0,0 +1,912 @@
+#include "processus.h"
+#include "TableProcessus.h"
+#include "Flux.h"
+#include "Chronologie.h"
+#include "ContratException.h"
+#include "RoueTemporelle.h"
+#include "Instantane.h"
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+using namespace std;
+
+// Moteur.h
+#ifndef MOTEUR_H
+#define MOTEUR_H
+
+template<typename T>
+using File = std::queue<T>;
+
+namespace TP {
+
+    // types d'événements, dans l'ordre de traitement lorsque deux événements ont le même temps
+    enum TypeEvenement {
+        TERMINAISON,        // le processus élu a terminé son exécution
+        BLOCAGE,            // le processus élu a terminé une rafale processeur et commence une E/S
+        FIN_QUANTUM,        // le quantum du processus élu est expiré, il retourne dans la file prête
+        REVEIL,             // des E/S se terminent, leurs processus redeviennent prêts
+        ARRIVEE,            // un processus entre dans le système
+        REEQUILIBRAGE,      // multiprocesseur : équilibrage périodique de la charge des processeurs
+        REHAUSSEMENT,       // rehaussement périodique des priorités de la file prête (voir FilePrete::rehausser)
+        ELECTION            // le processeur est libre, la politique choisit le prochain processus
+    };
+
+    struct Evenement {
+        int temps;          // instant de l'événement
+        TypeEvenement type; // nature de l'événement
+        IdProcessus id;     // processus concerné (sans objet pour ELECTION)
+        unsigned jeton;     // fin de tranche périmée si différent du jeton courant du moteur
+
+        // ordre inversé pour obtenir un tas-min avec std::priority_queue
+        bool operator<(const Evenement& autre) const {
+            if (temps != autre.temps) {
+                return temps > autre.temps;
+            }
+            return type > autre.type;
+        }
+    };
+
+    /**
+     * @brief instant d'une fin de tranche ou d'un réveil à venir, calculé sur 64 bits.
+     *
+     * l'horloge de la simulation est un int : un instant au-delà de INT32_MAX arrête la
+     * simulation par une exception overflow_error, que le programme signale comme une erreur.
+     */
+    inline int instantFutur(int64_t instant) {
+        if (instant > INT32_MAX) {
+            throw overflow_error("la simulation depasse l'instant " + to_string(INT32_MAX));
+        }
+        return static_cast<int>(instant);
+    }
+
+    /**
+     * @brief file des processus prêts, point d'extension de chaque politique d'ordonnancement.
+     *
+     * le moteur s'occupe du temps et des événements ; la politique décide seulement
+     * dans quel ordre les processus prêts sont élus et pour combien de temps.
+     */
+    class FilePrete {
+    public:
+        virtual ~FilePrete() = default;
+
+        // un processus devient prêt (arrivée, fin de quantum ou fin d'E/S)
+        virtual void ajouter(IdProcessus id) = 0;
+
+        // retire et retourne le prochain processus à élire
+        virtual IdProcessus extraire() = 0;
+
+        virtual bool estVide() const = 0;
+
+        // durée maximale d'une tranche pour ce processus, 0 pour l'exécuter jusqu'à la fin
+        virtual int quantum(IdProcessus id) const { return 0; }
+
+        // vrai si le processus qui arrive doit préempter le processus élu
+        virtual bool preempte(IdProcessus courant, IdProcessus arrivant) const { return false; }
+
+        // le processus élu a terminé son exécution
+        virtual void terminer(IdProcessus id) {}
+
+        // le processus élu commence une E/S et reviendra par ajouter() à son réveil ; par défaut,
+        // il quitte la file comme à sa terminaison et revient comme un nouveau processus
+        virtual void bloquer(IdProcessus id) { terminer(id); }
+
+        // le processus bloqué reprend sur un autre processeur (multiprocesseur) : la file oublie ce
+        // qu'elle gardait de lui, il n'y reviendra que comme un nouveau processus
+        virtual void oublier(IdProcessus id) {}
+
+        // retire un processus prêt, jamais le processus élu, pour le migrer vers un autre
+        // processeur ; AUCUN_PROCESSUS si aucun processus n'est prêt
+        virtual IdProcessus ceder() { return estVide() ? AUCUN_PROCESSUS : extraire(); }
+
+        // intervalle des rehaussements périodiques, 0 pour n'en faire aucun ; lu une fois par le moteur
+        virtual int periodeRehaussement() const { return 0; }
+
+        // rehaussement périodique, appelé aux multiples de la période tant que le processeur a du
+        // travail ; le temps restant du processus élu est alors à jour dans la table
+        virtual void rehausser() {}
+
+        // ajoute à etat ce que restaurer() doit relire pour que la file reprenne exactement là où
+        // elle en est (instantané) ; rien par défaut, l'ordre des processus prêts suffisant
+        virtual void sauver(vector<int64_t>& etat) const {}
+
+        /**
+         * reprend l'état sauvé par une file de la même politique : les processus prêts (dans leur
+         * ordre d'entrée dans la file), l'élu qui poursuit sa tranche (AUCUN_PROCESSUS si le
+         * processeur est libre) et les processus en E/S. Par défaut, les processus prêts sont
+         * ajoutés dans l'ordre. false si l'état ne correspond pas à ces processus.
+         */
+        virtual bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                               LecteurEtat& etat) {
+            for (IdProcessus id : prets) {
+                ajouter(id);
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief coût d'une commutation de contexte, payé au début de chaque tranche : le processeur
+     * est occupé sans que le processus élu avance.
+     *
+     * la commutation proprement dite coûte `commutation`, sauf si le processeur réélit le processus
+     * qu'il vient d'interrompre. S'y ajoute le réchauffement du cache : complet pour un processus
+     * qui n'a jamais tourné sur ce processeur, sinon proportionnel au temps écoulé depuis son
+     * dernier arrêt, le cache étant entièrement froid après `refroidissement`. Un processus qui
+     * reprend sur un autre processeur que le précédent paie en plus `migration`. Le modèle est
+     * entier : deux simulations identiques donnent le même résultat.
+     */
+    struct CoutsCommutation {
+        int commutation = 0;
+        int rechauffement = 0;      // cache entièrement froid
+        int refroidissement = 1;    // temps au bout duquel le cache d'un processus est froid
+        int migration = 0;
+
+        bool estNul() const { return commutation == 0 && rechauffement == 0 && migration == 0; }
+
+        /**
+         * surcoût de l'élection d'un processus.
+         * @param memeProcessus le processeur avait exécuté ce processus en dernier.
+         * @param dejaExecute le processus a déjà été élu.
+         * @param ecart temps écoulé depuis son dernier arrêt, si dejaExecute.
+         * @param memeProcesseur il s'était arrêté sur ce processeur, si dejaExecute.
+         * \pre refroidissement > 0
+         */
+        int64_t surcout(bool memeProcessus, bool dejaExecute, int64_t ecart, bool memeProcesseur) const {
+            PRECONDITION(refroidissement > 0);
+            int64_t cout = (memeProcessus && dejaExecute && memeProcesseur) ? 0 : commutation;
+            if (dejaExecute && memeProcesseur) {
+                cout += rechauffement * min<int64_t>(ecart, refroidissement) / refroidissement;
+            } else {
+                cout += rechauffement;
+            }
+            if (dejaExecute && !memeProcesseur) {
+                cout += migration;
+            }
+            return cout;
+        }
+    };
+
+    /**
+     * @brief moteur de simulation à événements discrets commun à toutes les politiques.
+     *
+     * l'horloge saute directement d'un événement au suivant : le coût de la simulation
+     * dépend du nombre d'événements et non de la durée simulée.
+     *
+     * un processus qui termine une rafale processeur attend la fin de son E/S dans une roue
+     * temporelle ; un seul événement REVEIL, au prochain instant de la roue, la représente dans
+     * la file d'événements, qui reste ainsi petite quel que soit le nombre de processus bloqués.
+     *
+     * en mode flux, les processus sont lus à la demande depuis une source et rendus à un puits
+     * dès leur terminaison ; la mémoire dépend du nombre de processus présents à un instant
+     * donné, et non de la longueur de la trace.
+     *
+     * le moteur est paramétré par le type de sa file prête. Avec FilePrete, la politique est
+     * choisie à l'exécution et chaque opération sur la file est un appel virtuel ; avec une file
+     * concrète déclarée final (FileFifo, FileRestantCourt...), le compilateur spécialise la boucle
+     * pour cette politique et peut y insérer ses opérations. Une file concrète n'a rien d'autre à
+     * fournir que l'interface de FilePrete (voir avecPolitique).
+     *
+     * avec des coûts de commutation (setCouts), chaque tranche commence par un surcoût pendant
+     * lequel le processeur est occupé mais le processus élu n'avance pas ; il est compté dans
+     * tempsCommutation() et non dans tempsOccupe().
+     *
+     * executerJusqua() arrête la simulation à un instant donné et capturer() en tire un
+     * instantané ; un autre moteur, sur une copie de la charge, peut en repartir par reprendre(),
+     * sous la même politique ou sous une autre (voir Instantane).
+     */
+    template<typename Politique>
+    class MoteurGenerique {
+    public:
+        MoteurGenerique(TableProcessus& table, Politique& file);
+
+        // simule tous les processus de la table
+        vector<IdProcessus> executer(int& temps);
+
+        // simule tous les processus de la table en les rendant au puits au fil de leur terminaison
+        void executer(PuitsProcessus& puits, int& temps);
+
+        // mode flux : la table doit avoir été créée par TableProcessus::pourFlux()
+        void executer(SourceProcessus& source, PuitsProcessus& puits, int& temps);
+
+        // simule jusqu'à l'instant donné, sans puits ; executer() poursuit ensuite la simulation
+        void executerJusqua(int instant, int& temps);
+
+        // instantané de la simulation arrêtée par executerJusqua(instant), sans sa charge
+        void capturer(int instant, Instantane& instantane) const;
+
+        // repart d'un instantané de la même charge, avant executer() et après setCouts() ; prolonger
+        // si la file est de la politique et du quantum de l'instantané ; false si son état est invalide
+        bool reprendre(const Instantane& instantane, bool prolonger = false);
+
+        // nombre de tranches d'exécution attribuées depuis la construction
+        size_t nbElections() const { return m_nbElections; }
+        // temps pendant lequel le processeur a exécuté un processus depuis la construction
+        int64_t tempsOccupe() const { return m_tempsOccupe; }
+        // temps perdu en commutations de contexte depuis la construction
+        int64_t tempsCommutation() const { return m_tempsCommutation; }
+
+        // coûts des commutations de contexte, nuls par défaut ; à fixer avant executer()
+        void setCouts(const CoutsCommutation& couts) {
+            m_couts = couts;
+            m_avecCouts = !couts.estNul();
+        }
+
+        // enregistre les tranches d'exécution dans la chronologie, nullptr pour ne rien enregistrer
+        void setChronologie(Chronologie* chronologie) { m_chronologie = chronologie; }
+
+        void verifieInvariant() const;
+
+    private:
+        void simuler();
+        void planifierArrivee();
+        void planifierElection();
+        void planifierRehaussement();
+        void planifierReveil();
+        void rendrePret(IdProcessus id);
+        void ajouterPret(IdProcessus id);
+        void elire();
+        void comptabiliser();
+        void preempter();
+        void liberer();
+        void enregistrer(TypeEnregistrement type, IdProcessus id);
+
+        TableProcessus& m_table;          // processus simulés
+        Politique& m_file;                // politique d'ordonnancement
+        vector<IdProcessus> m_arrivees;   // identifiants triés par temps d'arrivée
+        size_t m_prochaineArrivee;        // curseur dans m_arrivees
+        SourceProcessus* m_source;        // mode flux : origine des arrivées, nullptr sinon
+        PuitsProcessus* m_puits;          // destination des processus terminés, nullptr pour m_result
+        priority_queue<Evenement> m_evenements;
+        int m_temps;                      // horloge de la simulation
+        bool m_occupe;                    // un processus est en cours d'exécution
+        IdProcessus m_courant;            // processus élu lorsque m_occupe
+        int m_debutTranche;               // instant depuis lequel m_restant du processus élu est à jour,
+                                          // futur pendant le surcoût d'une commutation
+        int m_finTranche;                 // fin prévue de la tranche du processus élu
+        unsigned m_jeton;                 // incrémenté à chaque préemption pour périmer la fin de tranche
+        bool m_electionPrevue;            // un événement ELECTION est déjà en attente
+        int m_periodeRehaussement;        // période de la file prête, 0 si elle n'en a pas
+        bool m_rehaussementPrevu;         // un événement REHAUSSEMENT est déjà en attente
+        int m_prochainRehaussement;       // son instant, pour l'instantané
+        RoueTemporelle m_bloques;         // processus en E/S, jusqu'à leur réveil
+        int64_t m_prochainReveil;         // instant de l'événement REVEIL en attente, INT64_MAX s'il n'y en a pas
+        vector<uint32_t> m_reveilles;     // tampon des processus réveillés à un même instant
+        size_t m_nbElections;
+        int64_t m_tempsOccupe;
+        CoutsCommutation m_couts;
+        bool m_avecCouts;                 // m_couts n'est pas nul
+        IdProcessus m_dernier;            // dernier processus élu
+        vector<int> m_derniersArrets;     // par processus, instant où il a quitté le processeur
+        int64_t m_tempsCommutation;
+        int m_surcoutRepris;              // voir Instantane::surcoutElu
+        int64_t m_limite;                 // executerJusqua : instant d'arrêt, INT64_MAX sinon
+        bool m_demarre;                   // la première arrivée est planifiée
+        vector<uint64_t> m_ordresPrets;   // executerJusqua : numéro du dernier passage de chaque processus
+        uint64_t m_nbPrets;               // dans la file prête, pour la rendre dans cet ordre à l'instantané
+        size_t m_nbArrivees;              // processus arrivés
+        vector<IdProcessus> m_result;     // processus terminés, dans l'ordre de terminaison (hors mode flux)
+        Chronologie* m_chronologie;       // nullptr si rien n'est enregistré
+    };
+
+    // moteur dont la politique est choisie à l'exécution
+    using Moteur = MoteurGenerique<FilePrete>;
+
+    /**
+     * @brief Constructeur du moteur de simulation.
+     * @param table processus à simuler, modifiés en place pendant la simulation.
+     * @param file file des processus prêts de la politique choisie.
+     * \post les arrivées sont triées par temps d'arrivée, l'ordre du fichier départage les égalités
+     */
+    template<typename Politique>
+    MoteurGenerique<Politique>::MoteurGenerique(TableProcessus& table, Politique& file)
+        : m_table(table), m_file(file), m_prochaineArrivee(0), m_source(nullptr), m_puits(nullptr),
+          m_temps(0), m_occupe(false), m_courant(0), m_debutTranche(0), m_finTranche(0), m_jeton(0),
+          m_electionPrevue(false), m_periodeRehaussement(file.periodeRehaussement()), m_rehaussementPrevu(false),
+          m_prochainRehaussement(0),
+          m_prochainReveil(INT64_MAX), m_nbElections(0), m_tempsOccupe(0), m_avecCouts(false), m_dernier(AUCUN_PROCESSUS),
+          m_tempsCommutation(0), m_surcoutRepris(0), m_limite(INT64_MAX), m_demarre(false), m_nbPrets(0), m_nbArrivees(0), m_chronologie(nullptr) {
+
+        // la file d'événements contient au plus une arrivée, une fin de tranche, un réveil et une
+        // élection, plus les événements périmés : la réserver évite toute allocation en régime permanent
+        vector<Evenement> reserve;
+        reserve.reserve(16);
+        m_evenements = priority_queue<Evenement>(less<Evenement>(), std::move(reserve));
+
+        m_arrivees.reserve(m_table.taille());
+        for (IdProcessus id = 0; id < m_table.taille(); ++id) {
+            m_arrivees.push_back(id);
+        }
+        stable_sort(m_arrivees.begin(), m_arrivees.end(), [this](IdProcessus a, IdProcessus b) {
+            return m_table.arrivee(a) < m_table.arrivee(b);
+        });
+        m_result.reserve(m_table.taille());
+
+        INVARIANTS();
+    }
+
+    /**
+     * @brief exécute la simulation jusqu'à ce que tous les processus soient terminés.
+     * @param temps temps de départ de la simulation, mis à jour avec le temps de fin.
+     * @return identifiants des processus dans l'ordre de leur terminaison.
+     * \pre temps >= 0
+     */
+    template<typename Politique>
+    vector<IdProcessus> MoteurGenerique<Politique>::executer(int& temps) {
+        PRECONDITION(temps >= 0);
+
+        m_temps = temps;
+        m_limite = INT64_MAX;
+        simuler();
+        temps = m_temps;
+
+        INVARIANTS();
+        return m_result;
+    }
+
+    /**
+     * @brief exécute la simulation de tous les processus de la table, chacun étant transmis au puits
+     * dès sa terminaison ; la simulation s'interrompt si le puits le demande.
+     * @param puits reçoit chaque processus au moment de sa terminaison.
+     * @param temps temps de départ de la simulation, mis à jour avec le temps de fin.
+     * \pre temps >= 0
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::executer(PuitsProcessus& puits, int& temps) {
+        PRECONDITION(temps >= 0);
+
+        m_puits = &puits;
+        m_temps = temps;
+        m_limite = INT64_MAX;
+        simuler();
+        temps = m_temps;
+        m_puits = nullptr;
+
+        INVARIANTS();
+    }
+
+    /**
+     * @brief exécute la simulation jusqu'à un instant : les tranches qui se terminent à cet
+     * instant sont traitées, les réveils et les arrivées de cet instant restent en attente.
+     * Les processus terminés sont gardés comme par executer(int&).
+     * @param instant instant d'arrêt ; un appel suivant, ou executer(), reprend de là.
+     * @param temps temps de départ de la simulation, mis à jour avec l'instant du dernier événement traité.
+     * \pre la table n'est pas en mode flux
+     * \pre instant >= temps >= 0
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::executerJusqua(int instant, int& temps) {
+        PRECONDITION(!m_table.estFlux());
+        PRECONDITION(temps >= 0 && instant >= temps);
+
+        if (m_ordresPrets.empty()) {
+            m_ordresPrets.assign(m_table.taille(), 0);
+        }
+        m_temps = temps;
+        m_limite = instant;
+        simuler();
+        temps = m_temps;
+
+        INVARIANTS();
+    }
+
+    /**
+     * @brief instantané de la simulation à l'instant où executerJusqua s'est arrêté.
+     *
+     * la tranche en cours est arrêtée à l'instant : le temps restant du processus élu, le temps
+     * occupé et la part payée de la commutation y sont comptés jusque-là, et le reste de la tranche
+     * est gardé avec l'état de la file pour qu'une branche de la même politique la poursuive. Si
+     * tous les processus sont terminés, l'instantané est daté de la fin de la simulation.
+     * @param instant instant passé au dernier executerJusqua.
+     * @param instantane reçoit l'état ; sa charge est laissée à l'appelant.
+     * \pre executerJusqua(instant) vient d'être appelé
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::capturer(int instant, Instantane& instantane) const {
+        PRECONDITION(m_demarre && instant == m_limite);
+
+        auto etat = [this](IdProcessus id) {
+            bool connu = m_avecCouts && m_table.nbTranches(id) > 0 && id < m_derniersArrets.size();
+            int32_t arret = connu ? m_derniersArrets[id] : INT32_MIN;
+            return EtatProcessus{id, m_table.restant(id), m_table.attente(id), m_table.fin(id),
+                                 m_table.premierDemarrage(id), m_table.nbTranches(id), m_table.rafaleCourante(id),
+                                 -1, arret};
+        };
+
+        shared_ptr<const TableProcessus> charge = std::move(instantane.charge);
+        instantane = Instantane();
+        instantane.charge = std::move(charge);
+        instantane.temps = (m_result.size() == m_table.taille()) ? m_temps : instant;
+        instantane.nbAdmis = m_nbArrivees;
+        instantane.dernier = m_dernier;
+        instantane.nbElections = m_nbElections;
+        instantane.tempsOccupe = m_tempsOccupe;
+        instantane.tempsCommutation = m_tempsCommutation;
+        instantane.rehaussement = m_rehaussementPrevu ? m_prochainRehaussement : -1;
+        m_file.sauver(instantane.etatPolitique);
+
+        instantane.termines.reserve(m_result.size());
+        for (IdProcessus id : m_result) {
+            instantane.termines.push_back(etat(id));
+        }
+        instantane.enCours.reserve(m_nbArrivees - m_result.size());
+        if (m_occupe) {
+            int64_t execute = max<int64_t>(0, int64_t(instant) - m_debutTranche);
+            EtatProcessus elu = etat(m_courant);
+            elu.restant -= static_cast<int32_t>(execute);
+            elu.dernierArret = instant;
+            instantane.enCours.push_back(elu);
+            instantane.tempsOccupe += execute;
+            instantane.surcoutElu = max(0, m_debutTranche - instant);
+            instantane.tempsCommutation -= instantane.surcoutElu;
+            instantane.trancheElu = m_finTranche - max(instant, m_debutTranche);
+        }
+        vector<EtatProcessus> bloques;
+        vector<bool> estBloque(m_table.taille(), false);
+        m_bloques.parcourir([&](uint32_t id, int64_t reveil) {
+            EtatProcessus e = etat(id);
+            e.reveil = static_cast<int32_t>(reveil);
+            bloques.push_back(e);
+            estBloque[id] = true;
+        });
+        size_t premierPret = instantane.enCours.size();
+        for (size_t i = 0; i < m_nbArrivees; ++i) {
+            IdProcessus id = m_arrivees[i];
+            if (!(m_occupe && id == m_courant) && !estBloque[id] && m_table.restant(id) > 0) {
+                instantane.enCours.push_back(etat(id));
+            }
+        }
+        stable_sort(instantane.enCours.begin() + premierPret, instantane.enCours.end(),
+                    [this](const EtatProcessus& a, const EtatProcessus& b) {
+                        return m_ordresPrets[a.id] < m_ordresPrets[b.id];
+                    });
+        instantane.enCours.insert(instantane.enCours.end(), bloques.begin(), bloques.end());
+    }
+
+    /**
+     * @brief repart d'un instantané : la table reprend l'état des processus arrivés et les processus
+     * terminés sont gardés comme par executer(int&).
+     *
+     * pour prolonger la simulation, la file reprend son état et l'élu poursuit sa tranche, avec le
+     * même rehaussement en attente. Sinon, la politique reçoit les processus prêts comme des
+     * arrivées, l'ancien élu d'abord puis les autres dans l'ordre de leur entrée dans l'ancienne
+     * file prête.
+     * @param instantane instantané d'une simulation de la même charge ; executer() poursuit à partir
+     * de instantane.temps.
+     * @param prolonger vrai si la file est de la politique et du quantum qui ont pris l'instantané.
+     * @return false si l'état de la file enregistré ne correspond pas à l'instantané (fichier
+     * altéré) ; le moteur ne doit alors pas être exécuté.
+     * \pre le moteur n'a pas encore simulé
+     * \pre la table a les colonnes d'entrée de instantane.charge
+     */
+    template<typename Politique>
+    bool MoteurGenerique<Politique>::reprendre(const Instantane& instantane, bool prolonger) {
+        PRECONDITION(!m_demarre && !m_table.estFlux());
+        PRECONDITION(instantane.charge != nullptr && instantane.charge->taille() == m_table.taille());
+        PRECONDITION(instantane.nbAdmis == instantane.termines.size() + instantane.enCours.size());
+
+        m_demarre = true;
+        m_temps = instantane.temps;
+        m_prochaineArrivee = instantane.nbAdmis;
+        m_nbArrivees = instantane.nbAdmis;
+        m_dernier = instantane.dernier;
+        m_surcoutRepris = instantane.surcoutElu;
+        m_nbElections = instantane.nbElections;
+        m_tempsOccupe = instantane.tempsOccupe;
+        m_tempsCommutation = instantane.tempsCommutation;
+        if (m_avecCouts) {
+            m_derniersArrets.assign(m_table.taille(), INT32_MIN);
+        }
+
+        auto restaurer = [this](const EtatProcessus& e) {
+            m_table.restaurer(e.id, e.restant, e.attente, e.fin, e.premierDemarrage, e.nbTranches, e.rafaleCourante);
+            if (m_avecCouts) {
+                m_derniersArrets[e.id] = e.dernierArret;
+            }
+        };
+        for (const EtatProcessus& e : instantane.termines) {
+            restaurer(e);
+            m_result.push_back(e.id);
+        }
+        // l'élu qui poursuit sa tranche est le premier processus en cours
+        IdProcessus elu = AUCUN_PROCESSUS;
+        vector<IdProcessus> prets;
+        vector<IdProcessus> bloques;
+        for (const EtatProcessus& e : instantane.enCours) {
+            restaurer(e);
+            if (e.reveil >= 0) {
+                m_bloques.inserer(e.id, e.reveil);
+                bloques.push_back(e.id);
+            } else if (prolonger && instantane.trancheElu > 0 && &e == &instantane.enCours.front()) {
+                elu = e.id;
+            } else {
+                prets.push_back(e.id);
+            }
+        }
+
+        bool valide = true;
+        if (prolonger) {
+            LecteurEtat lecteur(instantane.etatPolitique);
+            valide = m_file.restaurer(prets, elu, bloques, lecteur) && lecteur.valide() && lecteur.fini();
+            if (elu != AUCUN_PROCESSUS) {
+                int finRafale = m_table.finRafale(elu);
+                int rafale = m_table.restant(elu) - finRafale;
+                valide = valide && instantane.trancheElu <= rafale;
+                m_occupe = true;
+                m_courant = elu;
+                m_surcoutRepris = 0;
+                m_debutTranche = instantFutur(int64_t(m_temps) + instantane.surcoutElu);
+                m_finTranche = instantFutur(int64_t(m_debutTranche) + instantane.trancheElu);
+                m_tempsCommutation += instantane.surcoutElu;
+                TypeEvenement fin = (instantane.trancheElu < rafale) ? FIN_QUANTUM
+                                                                     : (finRafale > 0 ? BLOCAGE : TERMINAISON);
+                m_evenements.push({m_finTranche, fin, elu, m_jeton});
+            }
+            if (instantane.rehaussement >= 0) {
+                valide = valide && m_periodeRehaussement > 0;
+                m_evenements.push({static_cast<int>(instantane.rehaussement), REHAUSSEMENT, 0, 0});
+                m_prochainRehaussement = static_cast<int>(instantane.rehaussement);
+                m_rehaussementPrevu = true;
+            }
+        } else {
+            for (IdProcessus id : prets) {
+                m_file.ajouter(id);
+            }
+            planifierRehaussement();
+        }
+        planifierArrivee();
+        planifierReveil();
+        planifierElection();
+
+        INVARIANTS();
+        return valide;
+    }
+
+    /**
+     * @brief exécute la simulation en mode flux jusqu'à épuisement de la source.
+     *
+     * un processus occupe une case de la table de sa lecture jusqu'à sa terminaison ; la case
+     * est ensuite recyclée pour un processus suivant.
+     * @param source processus à simuler, dans l'ordre d'arrivée.
+     * @param puits reçoit chaque processus au moment de sa terminaison.
+     * @param temps temps de départ de la simulation, mis à jour avec le temps de fin.
+     * \pre la table est en mode flux
+     * \pre temps >= 0
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::executer(SourceProcessus& source, PuitsProcessus& puits, int& temps) {
+        PRECONDITION(m_table.estFlux());
+        PRECONDITION(temps >= 0);
+
+        m_source = &source;
+        m_puits = &puits;
+        m_temps = temps;
+        simuler();
+        temps = m_temps;
+        m_source = nullptr;
+        m_puits = nullptr;
+
+        INVARIANTS();
+    }
+
+    /**
+     * @brief boucle principale : traite les événements jusqu'à ce qu'il n'en reste plus,
+     * ou jusqu'à ce que le puits demande l'arrêt.
+     *
+     * flatten insère dans la boucle tout ce qui est visible (file d'événements, file prête
+     * concrète) : avec sept instanciations, GCC laissait sinon priority_queue::push hors ligne.
+     */
+    template<typename Politique>
+    [[gnu::flatten]] void MoteurGenerique<Politique>::simuler() {
+        if (!m_demarre) {
+            m_demarre = true;
+            planifierArrivee();
+        }
+
+        bool arrete = false;
+        while (!m_evenements.empty() && !arrete) {
+            Evenement e = m_evenements.top();
+            if (e.temps >= m_limite && (e.temps > m_limite || e.type > FIN_QUANTUM)) {
+                break; // executerJusqua : la suite appartient à l'appel suivant
+            }
+            m_evenements.pop();
+            if ((e.type == TERMINAISON || e.type == BLOCAGE || e.type == FIN_QUANTUM) && e.jeton != m_jeton) {
+                continue; // tranche interrompue par une préemption
+            }
+            if (e.type == REVEIL && e.temps != m_prochainReveil) {
+                continue; // remplacé par un réveil plus proche
+            }
+            if (e.type == REHAUSSEMENT && !m_occupe && m_file.estVide()) {
+                m_rehaussementPrevu = false; // rien à rehausser : le suivant sera planifié à la prochaine arrivée
+                continue;
+            }
+            m_temps = max(m_temps, e.temps); // l'horloge saute au prochain événement
+
+            switch (e.type) {
+                case ARRIVEE:
+                    ++m_nbArrivees;
+                    rendrePret(e.id);
+                    planifierArrivee();
+                    planifierRehaussement();
+                    planifierElection();
+                    break;
+                case FIN_QUANTUM:
+                    comptabiliser();
+                    liberer();
+                    enregistrer(QUANTUM_EXPIRE, e.id);
+                    ajouterPret(e.id); // retour à la fin de la file prête
+                    planifierElection();
+                    break;
+                case REVEIL:
+                    m_prochainReveil = INT64_MAX;
+                    m_reveilles.clear();
+                    m_bloques.avancer(m_temps, m_reveilles);
+                    for (IdProcessus id : m_reveilles) {
+                        rendrePret(id);
+                    }
+                    planifierReveil();
+                    planifierRehaussement();
+                    planifierElection();
+                    break;
+                case BLOCAGE:
+                    comptabiliser();
+                    liberer();
+                    m_file.bloquer(e.id);
+                    enregistrer(BLOQUE, e.id);
+                    m_bloques.inserer(e.id, int64_t(m_temps) + m_table.commencerEntreeSortie(e.id));
+                    planifierReveil();
+                    planifierElection();
+                    break;
+                case TERMINAISON:
+                    comptabiliser();
+                    liberer();
+                    m_file.terminer(e.id);
+                    enregistrer(TERMINE, e.id);
+                    m_table.setAttente(e.id, m_temps - m_table.arrivee(e.id) - m_table.duree(e.id)
+                                                 - m_table.tempsEntreesSorties(e.id));
+                    m_table.setFin(e.id, m_temps);
+                    if (m_puits != nullptr) {
+                        m_puits->recevoir(m_table, e.id);
+                        arrete = m_puits->arreter();
+                        if (m_table.estFlux()) {
+                            m_table.liberer(e.id);
+                        }
+                    } else {
+                        m_result.push_back(e.id);
+                    }
+                    planifierElection();
+                    break;
+                case REEQUILIBRAGE:
+                    break; // sans objet avec un seul processeur
+                case REHAUSSEMENT:
+                    m_rehaussementPrevu = false;
+                    if (m_occupe) {
+                        comptabiliser();
+                    }
+                    m_file.rehausser();
+                    planifierRehaussement();
+                    break;
+                case ELECTION:
+                    m_electionPrevue = false;
+                    elire();
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief place le prochain processus du flux d'arrivées dans la file d'événements.
+     *
+     * un seul événement ARRIVEE est en attente à la fois, la file d'événements reste donc petite
+     * même pour des millions de processus.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::planifierArrivee() {
+        if (m_source != nullptr) {
+            LigneTrace lue;
+            if (m_source->suivant(lue)) {
+                IdProcessus id = m_table.admettre(lue.pid, lue.arrivee, lue.duree, lue.priorite, lue.type,
+                                                 lue.echeance, lue.rafales);
+                m_evenements.push({max(m_temps, lue.arrivee), ARRIVEE, id, 0});
+            }
+        } else if (m_prochaineArrivee < m_arrivees.size()) {
+            IdProcessus id = m_arrivees[m_prochaineArrivee++];
+            m_evenements.push({max(m_temps, m_table.arrivee(id)), ARRIVEE, id, 0});
+        }
+    }
+
+    /**
+     * @brief planifie une élection si le processeur est libre.
+     *
+     * l'élection est traitée après les arrivées du même instant, la politique voit donc
+     * tous les processus prêts au moment de choisir.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::planifierElection() {
+        if (!m_occupe && !m_electionPrevue && !m_file.estVide()) {
+            m_evenements.push({m_temps, ELECTION, 0, 0});
+            m_electionPrevue = true;
+        }
+    }
+
+    /**
+     * @brief planifie le prochain rehaussement, au premier multiple de la période après l'instant
+     * courant, si la file prête en demande.
+     *
+     * les rehaussements ne sont planifiés que pendant que le processeur a du travail : un
+     * processeur au repos n'a rien à rehausser et ne reçoit pas d'événement.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::planifierRehaussement() {
+        if (m_periodeRehaussement > 0 && !m_rehaussementPrevu) {
+            int64_t prochain = (int64_t(m_temps) / m_periodeRehaussement + 1) * m_periodeRehaussement;
+            if (prochain <= INT32_MAX) {
+                m_prochainRehaussement = static_cast<int>(prochain);
+                m_evenements.push({m_prochainRehaussement, REHAUSSEMENT, 0, 0});
+                m_rehaussementPrevu = true;
+            }
+        }
+    }
+
+    /**
+     * @brief planifie un réveil au prochain instant où la roue des processus bloqués a du travail,
+     * s'il précède le réveil déjà en attente ; celui-ci devient alors périmé.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::planifierReveil() {
+        if (!m_bloques.estVide()) {
+            int64_t prochain = max<int64_t>(m_temps, m_bloques.prochainInstant());
+            if (prochain < m_prochainReveil) {
+                m_evenements.push({instantFutur(prochain), REVEIL, 0, 0});
+                m_prochainReveil = prochain;
+            }
+        }
+    }
+
+    /**
+     * @brief rend un processus prêt (arrivée ou fin d'E/S), en préemptant le processus élu si la
+     * politique le demande.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::rendrePret(IdProcessus id) {
+        ajouterPret(id);
+        if (m_occupe) {
+            comptabiliser();
+            if (m_file.preempte(m_courant, id)) {
+                preempter();
+            }
+        }
+    }
+
+    /**
+     * @brief remet un processus à la politique ; pendant executerJusqua, l'ordre des passages est
+     * noté pour l'instantané.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::ajouterPret(IdProcessus id) {
+        if (!m_ordresPrets.empty()) {
+            m_ordresPrets[id] = m_nbPrets++;
+        }
+        m_file.ajouter(id);
+    }
+
+    /**
+     * @brief élit le prochain processus et planifie la fin de sa tranche d'exécution, au plus
+     * tard à la fin de sa rafale processeur ; la tranche commence après le surcoût de la
+     * commutation.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::elire() {
+        if (m_occupe || m_file.estVide()) {
+            return;
+        }
+
+        IdProcessus id = m_file.extraire();
+        int restant = m_table.restant(id);
+        int finRafale = m_table.finRafale(id);
+        int rafale = restant - finRafale;
+        int quantum = m_file.quantum(id);
+        int tranche = (quantum > 0) ? min(quantum, rafale) : rafale;
+
+        int64_t surcout = 0;
+        if (m_avecCouts) {
+            bool dejaExecute = m_table.nbTranches(id) > 0;
+            int64_t ecart = dejaExecute ? int64_t(m_temps) - m_derniersArrets[id] : 0;
+            surcout = m_couts.surcout(id == m_dernier, dejaExecute, ecart, true);
+            if (m_surcoutRepris > 0) {
+                // première élection après reprendre() : l'élu de l'instantané finit sa commutation
+                surcout += (id == m_dernier) ? m_surcoutRepris : 0;
+                m_surcoutRepris = 0;
+            }
+            m_tempsCommutation += surcout;
+        }
+
+        m_occupe = true;
+        m_courant = id;
+        m_dernier = id;
+        ++m_nbElections;
+        m_debutTranche = instantFutur(m_temps + surcout);
+        m_finTranche = instantFutur(int64_t(m_debutTranche) + tranche);
+        m_table.demarrerTranche(id, m_debutTranche);
+        enregistrer(ELU, id);
+        TypeEvenement fin = (tranche < rafale) ? FIN_QUANTUM : (finRafale > 0 ? BLOCAGE : TERMINAISON);
+        m_evenements.push({m_finTranche, fin, id, m_jeton});
+    }
+
+    /**
+     * @brief met à jour le temps restant du processus élu jusqu'à l'instant courant ; rien
+     * pendant le surcoût d'une commutation.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::comptabiliser() {
+        if (m_temps > m_debutTranche) {
+            m_table.setRestant(m_courant, m_table.restant(m_courant) - (m_temps - m_debutTranche));
+            m_tempsOccupe += m_temps - m_debutTranche;
+            m_debutTranche = m_temps;
+        }
+    }
+
+    /**
+     * @brief interrompt le processus élu et le remet dans la file prête.
+     *
+     * l'événement de fin de sa tranche reste dans la file d'événements mais devient périmé, et la
+     * part du surcoût de commutation qui n'a pas été payée est rendue.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::preempter() {
+        if (m_debutTranche > m_temps) {
+            m_tempsCommutation -= m_debutTranche - m_temps;
+        }
+        liberer();
+        ++m_jeton;
+        enregistrer(PREEMPTE, m_courant);
+        ajouterPret(m_courant);
+    }
+
+    /**
+     * @brief le processus élu quitte le processeur ; avec des coûts de commutation, l'instant est
+     * noté pour le réchauffement de son cache à sa prochaine élection.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::liberer() {
+        m_occupe = false;
+        if (m_avecCouts) {
+            if (m_courant >= m_derniersArrets.size()) {
+                m_derniersArrets.resize(max<size_t>(m_courant + 1, 2 * m_derniersArrets.size()));
+            }
+            m_derniersArrets[m_courant] = m_temps;
+        }
+    }
+
+    /**
+     * @brief ajoute un enregistrement à la chronologie, s'il y en a une.
+     *
+     * en mode flux, les cases de la table sont recyclées : le processus est désigné par son
+     * numéro d'admission.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::enregistrer(TypeEnregistrement type, IdProcessus id) {
+        if (m_chronologie != nullptr) {
+            m_chronologie->ajouter(m_temps, 0, type, m_table.estFlux() ? m_table.rang(id) : id);
+        }
+    }
+
+    /**
+     * \brief Vérifie les invariants du moteur.
+     */
+    template<typename Politique>
+    void MoteurGenerique<Politique>::verifieInvariant() const {
+        INVARIANT(m_temps >= 0);
+        INVARIANT(m_prochaineArrivee <= m_arrivees.size());
+        INVARIANT(m_table.estFlux() || m_nbArrivees <= m_prochaineArrivee);
+        INVARIANT(m_table.estFlux() || m_arrivees.size() == m_table.taille());
+    }
+
+    extern template class MoteurGenerique<FilePrete>;
+
+} // namespace TP
+
+#endif // MOTEUR_H
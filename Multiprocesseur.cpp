@@ -0,0 +1,498 @@
+#include "Multiprocesseur.h"
+#include "ContratException.h"
+#include "Flux.h"
+#include <algorithm>
+#include "ContratModule.h"
+
+// Equilibreur
+
+size_t TP::Equilibreur::placer(const MoteurMultiprocesseur& moteur, IdProcessus) {
+    size_t processeur = m_prochain;
+    m_prochain = (m_prochain + 1) % moteur.nbProcesseurs();
+    return processeur;
+}
+
+void TP::EquilibragePoussee::apresAjout(MoteurMultiprocesseur& moteur, size_t processeur) {
+    size_t cible = moteur.moinsCharge();
+    if (moteur.charge(processeur) >= moteur.charge(cible) + 2) {
+        moteur.migrer(processeur, cible);
+    }
+}
+
+// un processeur au repos est réveillé pour voler le processus qui attend ailleurs
+void TP::EquilibrageVol::apresAjout(MoteurMultiprocesseur& moteur, size_t processeur) {
+    size_t repos = moteur.moinsCharge();
+    if (moteur.charge(repos) == 0 && moteur.charge(processeur) >= 2) {
+        moteur.migrer(processeur, repos);
+    }
+}
+
+void TP::EquilibrageVol::auRepos(MoteurMultiprocesseur& moteur, size_t processeur) {
+    size_t victime = moteur.plusCharge();
+    if (moteur.charge(victime) >= 2) {
+        moteur.migrer(victime, processeur);
+    }
+}
+
+/**
+ * \pre periode > 0
+ */
+TP::EquilibragePeriodique::EquilibragePeriodique(int periode) : m_periode(periode) {
+    PRECONDITION(periode > 0);
+}
+
+// migre du plus chargé vers le moins chargé jusqu'à ce que les charges diffèrent d'au plus un
+void TP::EquilibragePeriodique::reequilibrer(MoteurMultiprocesseur& moteur) {
+    while (moteur.charge(moteur.plusCharge()) >= moteur.charge(moteur.moinsCharge()) + 2) {
+        if (!moteur.migrer(moteur.plusCharge(), moteur.moinsCharge())) {
+            break;
+        }
+    }
+}
+
+unique_ptr<TP::Equilibreur> TP::creerEquilibreur(const string& nom, int periode) {
+    if (nom == "aucun") {
+        return make_unique<SansEquilibrage>();
+    }
+    if (nom == "pousser") {
+        return make_unique<EquilibragePoussee>();
+    }
+    if (nom == "tirer") {
+        return make_unique<EquilibrageVol>();
+    }
+    if (nom == "periodique") {
+        return make_unique<EquilibragePeriodique>(periode);
+    }
+    return nullptr;
+}
+
+const vector<string>& TP::nomsEquilibreurs() {
+    static const vector<string> NOMS = {"aucun", "pousser", "tirer", "periodique"};
+    return NOMS;
+}
+
+// MoteurMultiprocesseur
+
+/**
+ * @brief Constructeur du moteur multiprocesseur.
+ * @param table processus à simuler, modifiés en place pendant la simulation.
+ * @param files file prête de chaque processeur.
+ * @param equilibreur stratégie d'équilibrage de la charge.
+ * \pre au moins un processeur, et aucune file nulle
+ */
+TP::MoteurMultiprocesseur::MoteurMultiprocesseur(TableProcessus& table, vector<unique_ptr<FilePrete>> files,
+                                                 Equilibreur& equilibreur)
+    : m_table(table), m_equilibreur(equilibreur), m_processeurs(files.size()), m_moinsCharges(files.size()),
+      m_plusCharges(files.size()), m_prochaineArrivee(0), m_nbTermines(0), m_puits(nullptr), m_temps(0),
+      m_periodeRehaussement(files.empty() ? 0 : files.front()->periodeRehaussement()), m_rehaussementPrevu(false),
+      m_origineReequilibrage(0), m_reequilibragePrevu(false), m_prochainReveil(INT64_MAX), m_nbMigrations(0), m_avecCouts(false), m_chronologie(nullptr) {
+    PRECONDITION(!files.empty());
+    PRECONDITION(all_of(files.begin(), files.end(), [](const unique_ptr<FilePrete>& f) { return f != nullptr; }));
+
+    for (size_t p = 0; p < files.size(); ++p) {
+        m_processeurs[p].file = std::move(files[p]);
+        m_moinsCharges.inserer(p, {0, p});
+        m_plusCharges.inserer(p, {0, p});
+    }
+
+    vector<EvenementMulti> reserve;
+    reserve.reserve(4 * m_processeurs.size() + 16);
+    m_evenements = priority_queue<EvenementMulti>(less<EvenementMulti>(), std::move(reserve));
+
+    m_arrivees.reserve(m_table.taille());
+    for (IdProcessus id = 0; id < m_table.taille(); ++id) {
+        m_arrivees.push_back(id);
+    }
+    stable_sort(m_arrivees.begin(), m_arrivees.end(), [this](IdProcessus a, IdProcessus b) {
+        return m_table.arrivee(a) < m_table.arrivee(b);
+    });
+    m_result.reserve(m_table.taille());
+
+    INVARIANTS();
+}
+
+/**
+ * @brief exécute la simulation jusqu'à ce que tous les processus soient terminés.
+ * @param temps temps de départ de la simulation, mis à jour avec le temps de fin.
+ * @return identifiants des processus dans l'ordre de leur terminaison.
+ * \pre temps >= 0
+ */
+vector<TP::IdProcessus> TP::MoteurMultiprocesseur::executer(int& temps) {
+    PRECONDITION(temps >= 0);
+
+    m_temps = temps;
+    simuler();
+    temps = m_temps;
+
+    INVARIANTS();
+    return m_result;
+}
+
+/**
+ * @brief exécute la simulation, chaque processus étant transmis au puits dès sa terminaison ;
+ * la simulation s'interrompt si le puits le demande.
+ * @param puits reçoit chaque processus au moment de sa terminaison.
+ * @param temps temps de départ de la simulation, mis à jour avec le temps de fin.
+ * \pre temps >= 0
+ */
+void TP::MoteurMultiprocesseur::executer(PuitsProcessus& puits, int& temps) {
+    PRECONDITION(temps >= 0);
+
+    m_puits = &puits;
+    m_temps = temps;
+    simuler();
+    temps = m_temps;
+    m_puits = nullptr;
+
+    INVARIANTS();
+}
+
+size_t TP::MoteurMultiprocesseur::charge(size_t processeur) const {
+    const Processeur& p = m_processeurs[processeur];
+    return p.nbPrets + (p.occupe ? 1 : 0);
+}
+
+int64_t TP::MoteurMultiprocesseur::tempsOccupe() const {
+    int64_t total = 0;
+    for (const Processeur& p : m_processeurs) {
+        total += p.stats.tempsOccupe;
+    }
+    return total;
+}
+
+int64_t TP::MoteurMultiprocesseur::tempsCommutation() const {
+    int64_t total = 0;
+    for (const Processeur& p : m_processeurs) {
+        total += p.stats.tempsCommutation;
+    }
+    return total;
+}
+
+/**
+ * @brief déplace le prochain processus prêt de la source vers la destination ; il peut y
+ * préempter le processus élu, comme à une arrivée.
+ * @return false si la source n'a aucun processus prêt.
+ * \pre source != destination
+ */
+bool TP::MoteurMultiprocesseur::migrer(size_t source, size_t destination) {
+    PRECONDITION(source != destination);
+
+    Processeur& de = m_processeurs[source];
+    IdProcessus id = de.file->ceder();
+    if (id == AUCUN_PROCESSUS) {
+        return false;
+    }
+    --de.nbPrets;
+    ++de.stats.migrationsSortantes;
+    majCharge(source);
+
+    ++m_processeurs[destination].stats.migrationsEntrantes;
+    ++m_nbMigrations;
+    enregistrer(destination, MIGRE, id);
+    rendrePret(destination, id);
+    majCharge(destination);
+    planifierElection(destination);
+    return true;
+}
+
+/**
+ * @brief boucle principale : traite les événements jusqu'à ce qu'il n'en reste plus,
+ * ou jusqu'à ce que le puits demande l'arrêt.
+ */
+void TP::MoteurMultiprocesseur::simuler() {
+    planifierArrivee();
+    m_origineReequilibrage = m_temps;
+    m_reequilibragePrevu = false;
+    planifierReequilibrage(false);
+
+    bool arrete = false;
+    while (!m_evenements.empty() && !arrete) {
+        EvenementMulti e = m_evenements.top();
+        m_evenements.pop();
+        size_t p = e.processeur;
+        if ((e.type == TERMINAISON || e.type == BLOCAGE || e.type == FIN_QUANTUM) && e.jeton != m_processeurs[p].jeton) {
+            continue; // tranche interrompue par une préemption
+        }
+        if (e.type == REVEIL && e.temps != m_prochainReveil) {
+            continue; // remplacé par un réveil plus proche
+        }
+        if (e.type == REEQUILIBRAGE && (m_nbTermines == m_table.taille() || charge(plusCharge()) == 0)) {
+            // plus rien à équilibrer, ou rien de prêt : ne pas avancer l'horloge pendant le repos,
+            // le rééquilibrage suivant est replanifié à la prochaine arrivée ou au prochain réveil
+            m_reequilibragePrevu = false;
+            continue;
+        }
+        if (e.type == REHAUSSEMENT && charge(plusCharge()) == 0) {
+            m_rehaussementPrevu = false; // tous les processeurs au repos : replanifié à la prochaine arrivée
+            continue;
+        }
+        m_temps = max(m_temps, e.temps);
+        Processeur& cpu = m_processeurs[p];
+
+        switch (e.type) {
+            case ARRIVEE:
+                p = m_equilibreur.placer(*this, e.id);
+                ASSERTION(p < m_processeurs.size());
+                rendrePret(p, e.id);
+                majCharge(p);
+                m_equilibreur.apresAjout(*this, p);
+                planifierArrivee();
+                planifierRehaussement();
+                planifierReequilibrage(true);
+                planifierElection(p);
+                break;
+            case FIN_QUANTUM:
+                comptabiliser(p);
+                liberer(p);
+                enregistrer(p, QUANTUM_EXPIRE, e.id);
+                cpu.file->ajouter(e.id);
+                ++cpu.nbPrets;
+                m_equilibreur.apresAjout(*this, p);
+                planifierElection(p);
+                break;
+            case REVEIL:
+                m_prochainReveil = INT64_MAX;
+                m_reveilles.clear();
+                m_bloques.avancer(m_temps, m_reveilles);
+                for (IdProcessus id : m_reveilles) {
+                    size_t q = m_equilibreur.placer(*this, id);
+                    ASSERTION(q < m_processeurs.size());
+                    if (q != m_derniersProcesseurs[id]) {
+                        m_processeurs[m_derniersProcesseurs[id]].file->oublier(id);
+                    }
+                    rendrePret(q, id);
+                    majCharge(q);
+                    m_equilibreur.apresAjout(*this, q);
+                    planifierElection(q);
+                }
+                planifierReveil();
+                planifierRehaussement();
+                planifierReequilibrage(true);
+                break;
+            case BLOCAGE:
+                comptabiliser(p);
+                liberer(p);
+                cpu.file->bloquer(e.id);
+                enregistrer(p, BLOQUE, e.id);
+                majCharge(p);
+                m_bloques.inserer(e.id, int64_t(m_temps) + m_table.commencerEntreeSortie(e.id));
+                planifierReveil();
+                if (charge(p) == 0) {
+                    m_equilibreur.auRepos(*this, p);
+                }
+                planifierElection(p);
+                break;
+            case TERMINAISON:
+                comptabiliser(p);
+                liberer(p);
+                cpu.file->terminer(e.id);
+                enregistrer(p, TERMINE, e.id);
+                majCharge(p);
+                ++m_nbTermines;
+                m_table.setAttente(e.id, m_temps - m_table.arrivee(e.id) - m_table.duree(e.id)
+                                             - m_table.tempsEntreesSorties(e.id));
+                m_table.setFin(e.id, m_temps);
+                if (m_puits != nullptr) {
+                    m_puits->recevoir(m_table, e.id);
+                    arrete = m_puits->arreter();
+                } else {
+                    m_result.push_back(e.id);
+                }
+                if (charge(p) == 0) {
+                    m_equilibreur.auRepos(*this, p);
+                }
+                planifierElection(p);
+                break;
+            case REEQUILIBRAGE:
+                m_reequilibragePrevu = false;
+                m_equilibreur.reequilibrer(*this);
+                planifierReequilibrage(false);
+                break;
+            case REHAUSSEMENT:
+                m_rehaussementPrevu = false;
+                for (size_t q = 0; q < m_processeurs.size(); ++q) {
+                    if (m_processeurs[q].occupe) {
+                        comptabiliser(q);
+                    }
+                    m_processeurs[q].file->rehausser();
+                }
+                planifierRehaussement();
+                break;
+            case ELECTION:
+                cpu.electionPrevue = false;
+                elire(p);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief place le prochain processus du flux d'arrivées dans la file d'événements ; son
+ * processeur n'est choisi qu'au moment de l'arrivée.
+ */
+void TP::MoteurMultiprocesseur::planifierArrivee() {
+    if (m_prochaineArrivee < m_arrivees.size()) {
+        IdProcessus id = m_arrivees[m_prochaineArrivee++];
+        m_evenements.push({max(m_temps, m_table.arrivee(id)), ARRIVEE, 0, id, 0});
+    }
+}
+
+void TP::MoteurMultiprocesseur::planifierElection(size_t p) {
+    Processeur& cpu = m_processeurs[p];
+    if (!cpu.occupe && !cpu.electionPrevue && !cpu.file->estVide()) {
+        m_evenements.push({m_temps, ELECTION, static_cast<uint32_t>(p), 0, 0});
+        cpu.electionPrevue = true;
+    }
+}
+
+/**
+ * @brief planifie le rééquilibrage suivant, s'il reste des processus à terminer et qu'aucun n'est
+ * déjà prévu.
+ *
+ * les rééquilibrages tombent sur une grille de la période partie du début de la simulation : un
+ * rééquilibrage sauté pendant le repos des processeurs ne décale pas les suivants.
+ * @param maintenantCompris vrai pour accepter l'instant courant s'il est sur la grille (à une
+ * arrivée ou un réveil, que le rééquilibrage suit au même instant).
+ */
+void TP::MoteurMultiprocesseur::planifierReequilibrage(bool maintenantCompris) {
+    int64_t periode = m_equilibreur.periode();
+    if (periode > 0 && !m_reequilibragePrevu && m_nbTermines < m_table.taille()) {
+        int64_t ecoule = int64_t(m_temps) - m_origineReequilibrage;
+        int64_t prochain = m_origineReequilibrage + (maintenantCompris ? (ecoule + periode - 1) / periode
+                                                                          : ecoule / periode + 1) * periode;
+        if (prochain <= INT32_MAX) {
+            m_evenements.push({static_cast<int>(prochain), REEQUILIBRAGE, 0, 0, 0});
+            m_reequilibragePrevu = true;
+        }
+    }
+}
+
+// un seul événement pour tous les processeurs, au premier multiple de la période après l'instant courant
+void TP::MoteurMultiprocesseur::planifierRehaussement() {
+    if (m_periodeRehaussement > 0 && !m_rehaussementPrevu) {
+        int64_t prochain = (int64_t(m_temps) / m_periodeRehaussement + 1) * m_periodeRehaussement;
+        if (prochain <= INT32_MAX) {
+            m_evenements.push({static_cast<int>(prochain), REHAUSSEMENT, 0, 0, 0});
+            m_rehaussementPrevu = true;
+        }
+    }
+}
+
+// un seul événement REVEIL en attente, au prochain instant où la roue a du travail
+void TP::MoteurMultiprocesseur::planifierReveil() {
+    if (!m_bloques.estVide()) {
+        int64_t prochain = max<int64_t>(m_temps, m_bloques.prochainInstant());
+        if (prochain < m_prochainReveil) {
+            m_evenements.push({instantFutur(prochain), REVEIL, 0, 0, 0});
+            m_prochainReveil = prochain;
+        }
+    }
+}
+
+/**
+ * @brief rend un processus prêt sur le processeur, en préemptant le processus élu si la
+ * politique le demande.
+ */
+void TP::MoteurMultiprocesseur::rendrePret(size_t p, IdProcessus id) {
+    Processeur& cpu = m_processeurs[p];
+    cpu.file->ajouter(id);
+    ++cpu.nbPrets;
+    if (cpu.occupe) {
+        comptabiliser(p);
+        if (cpu.file->preempte(cpu.courant, id)) {
+            preempter(p);
+        }
+    }
+}
+
+// la tranche commence après le surcoût de la commutation
+void TP::MoteurMultiprocesseur::elire(size_t p) {
+    Processeur& cpu = m_processeurs[p];
+    if (cpu.occupe || cpu.file->estVide()) {
+        return;
+    }
+
+    IdProcessus id = cpu.file->extraire();
+    --cpu.nbPrets;
+    int finRafale = m_table.finRafale(id);
+    int rafale = m_table.restant(id) - finRafale;
+    int quantum = cpu.file->quantum(id);
+    int tranche = (quantum > 0) ? min(quantum, rafale) : rafale;
+
+    int64_t surcout = 0;
+    if (m_avecCouts) {
+        bool dejaExecute = m_table.nbTranches(id) > 0;
+        bool memeProcesseur = dejaExecute && m_derniersProcesseurs[id] == p;
+        int64_t ecart = dejaExecute ? m_temps - m_derniersArrets[id] : 0;
+        surcout = m_couts.surcout(id == cpu.dernier, dejaExecute, ecart, memeProcesseur);
+        cpu.stats.tempsCommutation += surcout;
+    }
+
+    cpu.occupe = true;
+    cpu.courant = id;
+    cpu.dernier = id;
+    ++cpu.stats.nbElections;
+    cpu.debutTranche = instantFutur(m_temps + surcout);
+    m_table.demarrerTranche(id, cpu.debutTranche);
+    enregistrer(p, ELU, id);
+    TypeEvenement fin = (tranche < rafale) ? FIN_QUANTUM : (finRafale > 0 ? BLOCAGE : TERMINAISON);
+    m_evenements.push({instantFutur(int64_t(cpu.debutTranche) + tranche), fin, static_cast<uint32_t>(p), id, cpu.jeton});
+}
+
+// rien pendant le surcoût d'une commutation
+void TP::MoteurMultiprocesseur::comptabiliser(size_t p) {
+    Processeur& cpu = m_processeurs[p];
+    if (m_temps > cpu.debutTranche) {
+        m_table.setRestant(cpu.courant, m_table.restant(cpu.courant) - (m_temps - cpu.debutTranche));
+        cpu.stats.tempsOccupe += m_temps - cpu.debutTranche;
+        cpu.debutTranche = m_temps;
+    }
+}
+
+// la part du surcoût de commutation qui n'a pas été payée est rendue
+void TP::MoteurMultiprocesseur::preempter(size_t p) {
+    Processeur& cpu = m_processeurs[p];
+    if (cpu.debutTranche > m_temps) {
+        cpu.stats.tempsCommutation -= cpu.debutTranche - m_temps;
+    }
+    liberer(p);
+    ++cpu.jeton;
+    enregistrer(p, PREEMPTE, cpu.courant);
+    cpu.file->ajouter(cpu.courant);
+    ++cpu.nbPrets;
+}
+
+// le processus élu quitte le processeur, noté pour son réveil s'il part en E/S et pour sa
+// prochaine élection ; avec des coûts de commutation, l'instant l'est aussi
+void TP::MoteurMultiprocesseur::liberer(size_t p) {
+    Processeur& cpu = m_processeurs[p];
+    cpu.occupe = false;
+    if (cpu.courant >= m_derniersProcesseurs.size()) {
+        size_t taille = max<size_t>(cpu.courant + 1, 2 * m_derniersProcesseurs.size());
+        m_derniersProcesseurs.resize(taille);
+        if (m_avecCouts) {
+            m_derniersArrets.resize(taille);
+        }
+    }
+    m_derniersProcesseurs[cpu.courant] = static_cast<uint32_t>(p);
+    if (m_avecCouts) {
+        m_derniersArrets[cpu.courant] = m_temps;
+    }
+}
+
+// reporte la charge du processeur dans les deux tas
+void TP::MoteurMultiprocesseur::majCharge(size_t p) {
+    size_t c = charge(p);
+    m_moinsCharges.modifierCle(p, {c, p});
+    m_plusCharges.modifierCle(p, {-static_cast<int64_t>(c), p});
+}
+
+/**
+ * \brief Vérifie les invariants du moteur.
+ */
+void TP::MoteurMultiprocesseur::verifieInvariant() const {
+    INVARIANT(m_temps >= 0);
+    INVARIANT(!m_processeurs.empty());
+    INVARIANT(m_prochaineArrivee <= m_arrivees.size());
+    INVARIANT(m_nbTermines <= m_table.taille());
+}
@@ -0,0 +1,237 @@
+#include "Chronologie.h"
+#include "Moteur.h"
+#include "RoueTemporelle.h"
+#include "TableProcessus.h"
+#include "TasIndexe.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Multiprocesseur.h
+#ifndef MULTIPROCESSEUR_H
+#define MULTIPROCESSEUR_H
+
+namespace TP {
+
+    class PuitsProcessus;
+    class MoteurMultiprocesseur;
+
+    /**
+     * @brief stratégie d'équilibrage de la charge entre processeurs, point d'extension du moteur
+     * multiprocesseur.
+     *
+     * la charge d'un processeur est le nombre de ses processus prêts, plus un s'il exécute un
+     * processus. La stratégie choisit le processeur de chaque arrivée et déplace des processus
+     * prêts avec MoteurMultiprocesseur::migrer().
+     */
+    class Equilibreur {
+    public:
+        virtual ~Equilibreur() = default;
+
+        // processeur qui reçoit un processus arrivé ; par défaut, chacun à tour de rôle
+        virtual size_t placer(const MoteurMultiprocesseur& moteur, IdProcessus id);
+
+        // un processus vient de devenir prêt sur le processeur (arrivée, fin de quantum, préemption)
+        virtual void apresAjout(MoteurMultiprocesseur& moteur, size_t processeur) {}
+
+        // le processeur n'a plus rien à exécuter
+        virtual void auRepos(MoteurMultiprocesseur& moteur, size_t processeur) {}
+
+        // intervalle des rééquilibrages périodiques, 0 pour n'en faire aucun
+        virtual int periode() const { return 0; }
+        virtual void reequilibrer(MoteurMultiprocesseur& moteur) {}
+
+    private:
+        size_t m_prochain = 0;
+    };
+
+    // aucune migration : chaque processus reste sur le processeur où il est arrivé
+    class SansEquilibrage : public Equilibreur {
+    };
+
+    // poussée : un processeur qui reçoit un processus le cède au moins chargé s'il le dépasse de deux
+    class EquilibragePoussee : public Equilibreur {
+    public:
+        void apresAjout(MoteurMultiprocesseur& moteur, size_t processeur) override;
+    };
+
+    // vol : un processeur au repos tire un processus prêt du plus chargé
+    class EquilibrageVol : public Equilibreur {
+    public:
+        void apresAjout(MoteurMultiprocesseur& moteur, size_t processeur) override;
+        void auRepos(MoteurMultiprocesseur& moteur, size_t processeur) override;
+    };
+
+    // rééquilibrage périodique : tous les `periode`, du plus chargé vers le moins chargé
+    class EquilibragePeriodique : public Equilibreur {
+    public:
+        explicit EquilibragePeriodique(int periode);
+
+        int periode() const override { return m_periode; }
+        void reequilibrer(MoteurMultiprocesseur& moteur) override;
+
+    private:
+        int m_periode;
+    };
+
+    /**
+     * @brief crée une stratégie d'équilibrage désignée par son nom : "aucun", "pousser", "tirer"
+     * ou "periodique".
+     * @return nullptr si le nom est inconnu.
+     * \pre periode > 0 pour "periodique"
+     */
+    unique_ptr<Equilibreur> creerEquilibreur(const string& nom, int periode);
+
+    // noms acceptés par creerEquilibreur
+    const vector<string>& nomsEquilibreurs();
+
+    // activité d'un processeur depuis la construction du moteur
+    struct StatistiquesProcesseur {
+        int64_t tempsOccupe = 0;
+        size_t nbElections = 0;
+        size_t migrationsEntrantes = 0;
+        size_t migrationsSortantes = 0;
+        int64_t tempsCommutation = 0;   // surcoûts des commutations de contexte (voir CoutsCommutation)
+    };
+
+    /**
+     * @brief moteur à événements discrets pour plusieurs processeurs, chacun avec sa propre file
+     * prête sous n'importe quelle politique.
+     *
+     * une seule file d'événements ordonne tous les processeurs (à temps et type égaux, par numéro
+     * de processeur). Les charges sont gardées dans deux tas indexés : trouver le processeur le
+     * moins ou le plus chargé coûte O(1) et une variation de charge O(log N), ce qui garde un
+     * événement en O(log N + log n) pour des centaines de processeurs.
+     *
+     * les processus en E/S attendent dans une roue temporelle commune ; à son réveil, un
+     * processus est placé par la stratégie d'équilibrage comme à son arrivée ; s'il change de
+     * processeur, la file de l'ancien l'oublie (FilePrete::oublier).
+     *
+     * avec des coûts de commutation, un processus qui reprend sur un autre processeur que le
+     * précédent y trouve un cache froid et paie la migration.
+     *
+     * avec un seul processeur, la simulation est identique à celle de Moteur.
+     */
+    class MoteurMultiprocesseur {
+    public:
+        // files : une file prête par processeur
+        MoteurMultiprocesseur(TableProcessus& table, vector<unique_ptr<FilePrete>> files, Equilibreur& equilibreur);
+
+        // simule tous les processus de la table
+        vector<IdProcessus> executer(int& temps);
+
+        // simule tous les processus de la table en les rendant au puits au fil de leur terminaison
+        void executer(PuitsProcessus& puits, int& temps);
+
+        // interface des stratégies d'équilibrage
+        size_t nbProcesseurs() const { return m_processeurs.size(); }
+        size_t charge(size_t processeur) const;
+        size_t moinsCharge() const { return m_moinsCharges.sommet(); }
+        size_t plusCharge() const { return m_plusCharges.sommet(); }
+        // migre un processus prêt ; false si la source n'en a aucun
+        bool migrer(size_t source, size_t destination);
+        int temps() const { return m_temps; }
+
+        const StatistiquesProcesseur& statistiques(size_t processeur) const { return m_processeurs[processeur].stats; }
+        size_t nbMigrations() const { return m_nbMigrations; }
+        // temps pendant lequel les processeurs ont exécuté un processus, tous processeurs confondus
+        int64_t tempsOccupe() const;
+        // temps perdu en commutations de contexte, tous processeurs confondus
+        int64_t tempsCommutation() const;
+
+        // coûts des commutations de contexte, nuls par défaut ; à fixer avant executer()
+        void setCouts(const CoutsCommutation& couts) {
+            m_couts = couts;
+            m_avecCouts = !couts.estNul();
+        }
+
+        // enregistre les tranches d'exécution dans la chronologie, nullptr pour ne rien enregistrer
+        void setChronologie(Chronologie* chronologie) { m_chronologie = chronologie; }
+
+        void verifieInvariant() const;
+
+    private:
+        struct EvenementMulti {
+            int temps;
+            TypeEvenement type;
+            uint32_t processeur;
+            IdProcessus id;
+            unsigned jeton;
+
+            // ordre inversé pour obtenir un tas-min avec std::priority_queue
+            bool operator<(const EvenementMulti& autre) const {
+                if (temps != autre.temps) {
+                    return temps > autre.temps;
+                }
+                if (type != autre.type) {
+                    return type > autre.type;
+                }
+                return processeur > autre.processeur;
+            }
+        };
+
+        struct Processeur {
+            unique_ptr<FilePrete> file;
+            size_t nbPrets = 0;
+            bool occupe = false;
+            IdProcessus courant = 0;
+            int debutTranche = 0;         // futur pendant le surcoût d'une commutation
+            unsigned jeton = 0;
+            IdProcessus dernier = AUCUN_PROCESSUS;
+            bool electionPrevue = false;
+            StatistiquesProcesseur stats;
+        };
+
+        void simuler();
+        void planifierArrivee();
+        void planifierElection(size_t p);
+        void planifierReequilibrage(bool maintenantCompris);
+        void planifierRehaussement();
+        void planifierReveil();
+        void rendrePret(size_t p, IdProcessus id);
+        void elire(size_t p);
+        void comptabiliser(size_t p);
+        void preempter(size_t p);
+        void liberer(size_t p);
+        void majCharge(size_t p);
+        void enregistrer(size_t p, TypeEnregistrement type, IdProcessus id) {
+            if (m_chronologie != nullptr) {
+                m_chronologie->ajouter(m_temps, p, type, id);
+            }
+        }
+
+        TableProcessus& m_table;
+        Equilibreur& m_equilibreur;
+        vector<Processeur> m_processeurs;
+        TasIndexe<pair<size_t, size_t>> m_moinsCharges;  // (charge, processeur)
+        TasIndexe<pair<int64_t, size_t>> m_plusCharges;  // (-charge, processeur)
+        vector<IdProcessus> m_arrivees;   // identifiants triés par temps d'arrivée
+        size_t m_prochaineArrivee;
+        size_t m_nbTermines;
+        PuitsProcessus* m_puits;
+        priority_queue<EvenementMulti> m_evenements;
+        int m_temps;
+        int m_periodeRehaussement;        // période des files prêtes, 0 si elles n'en ont pas
+        bool m_rehaussementPrevu;
+        int m_origineReequilibrage;       // instant de départ de la grille des rééquilibrages
+        bool m_reequilibragePrevu;
+        RoueTemporelle m_bloques;         // processus en E/S, jusqu'à leur réveil
+        int64_t m_prochainReveil;         // instant de l'événement REVEIL en attente, INT64_MAX s'il n'y en a pas
+        vector<uint32_t> m_reveilles;
+        size_t m_nbMigrations;
+        CoutsCommutation m_couts;
+        bool m_avecCouts;                 // m_couts n'est pas nul
+        vector<int> m_derniersArrets;     // par processus, instant où il a quitté son dernier processeur
+        vector<uint32_t> m_derniersProcesseurs; // par processus, dernier processeur où il a été élu
+        vector<IdProcessus> m_result;
+        Chronologie* m_chronologie;       // nullptr si rien n'est enregistré
+    };
+
+} // namespace TP
+
+#endif // MULTIPROCESSEUR_H
@@ -1,8 +1,22 @@
-#include "ordonnanceur.h"
+#include "Ordonnanceur.h"
+#include "Politiques.h"
 #include "ContratException.h"
-#include <iostream>
-#include <list>
-#include <map>
+#include <algorithm>
+#include <vector>
+#include "ContratModule.h"
+
+namespace {
+
+    // reconstruire la file résultat dans l'ordre de terminaison donné par le moteur
+    File<Processus> versFile(const TP::TableProcessus& table, const vector<TP::IdProcessus>& termines) {
+        File<Processus> result;
+        for (TP::IdProcessus id : termines) {
+            result.push(table.versProcessus(id));
+        }
+        return result;
+    }
+
+} // namespace
 
 /**
  * @brief ordonnanceur utilisant la méthode First Come First Served (FCFS).
@@ -13,15 +27,9 @@
 File<Processus> TP::Ordonnanceur::fcfs(queue<Processus> f_entree, int& temps) {
     PRECONDITION(temps >= 0); // le temps ne peut pas être négatif
 
-    queue<Processus> result; // file résultat
-    while (!f_entree.empty()) {
-        Processus p = f_entree.front(); // récupérer le premier processus
-        f_entree.pop(); // retirer le processus
-        p.setAttente(temps - p.getArrivee()); // calculer le temps d'attente
-        POSTCONDITION(p.getAttente() >= 0); // le temps d'attente ne peut pas être négatif
-        temps += p.getDuree(); // mettre à jour le temps global
-        result.push(p); // ajouter le processus dans la file résultat
-    }
+    TableProcessus table(std::move(f_entree));
+    FileFifo file(table.taille());
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
     POSTCONDITION(!result.empty());
     return result;
@@ -35,60 +43,32 @@ File<Processus> TP::Ordonnanceur::fcfs(queue<Processus> f_entree, int& temps) {
  */
 File<Processus> TP::Ordonnanceur::fjs(queue<Processus> f_entree, int& temps) {
     PRECONDITION(temps >= 0);
-    // transférer les processus dans une liste pour faciliter le tri
-    list<Processus> liste_processus;
-    while (!f_entree.empty()) {
-        liste_processus.push_back(f_entree.front());
-        f_entree.pop();
-    }
-
-    // trier d'abord par temps d'arrivée puis par durée
-    liste_processus.sort([](const Processus& a, const Processus& b) {
-        if (a.getArrivee() == b.getArrivee()) {
-            if (a.getDuree() == b.getDuree()) {
-                return a.getPid() < b.getPid(); // si les durées sont égales, priorité au pid
-            }
-            return a.getDuree() < b.getDuree(); // priorité à la plus courte durée
-        }
-        return a.getArrivee() < b.getArrivee(); // priorité au processus arrivé en premier
-    });
 
-    queue<Processus> result;
-    list<Processus> file_attente; // processus disponibles à traiter, arrivés à l'instant actuel
+    TableProcessus table(std::move(f_entree));
+    table.classerPids();
+    FileCourtDabord file(table);
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
-    auto it = liste_processus.begin();
-    while (it != liste_processus.end() || !file_attente.empty()) {
-        // ajouter les processus disponibles à l'instant `temps`
-        while (it != liste_processus.end() && it->getArrivee() <= temps) {
-            file_attente.push_back(*it);
-            it = liste_processus.erase(it);
-        }
+    POSTCONDITION(!result.empty());
+    return result;
+}
 
-        // si la file d'attente est vide, avancer dans le temps au prochain processus
-        if (file_attente.empty()) {
-            temps = it->getArrivee(); // avancer le temps au prochain processus
-            file_attente.push_back(*it);
-            it = liste_processus.erase(it);
-        }
+/**
+ * @brief ordonnanceur utilisant la méthode Shortest Remaining Time First (SRTF).
+ *
+ * version préemptive de SJF : un processus qui arrive avec un temps d'exécution plus court
+ * que le temps restant du processus élu prend sa place.
+ * @param f_entree file des processus à ordonnancer.
+ * @param temps temps actuel de la simulation.
+ * @return file des processus ordonnancés.
+ */
+File<Processus> TP::Ordonnanceur::srtf(queue<Processus> f_entree, int& temps) {
+    PRECONDITION(temps >= 0);
 
-        // trier les processus dans la file d'attente par durée
-        file_attente.sort([](const Processus& a, const Processus& b) {
-            if (a.getDuree() == b.getDuree()) {
-                return a.getPid() < b.getPid(); // priorité au pid si égalité de durée
-            }
-            return a.getDuree() < b.getDuree(); // priorité à la plus courte durée
-        });
-
-        // prendre le premier processus de la file d'attente
-        Processus p = file_attente.front();
-        file_attente.pop_front();
-
-        // calculer le temps d'attente et mettre à jour le temps
-        p.setAttente(temps - p.getArrivee());
-        POSTCONDITION(p.getAttente() >= 0);
-        temps += p.getDuree();
-        result.push(p);
-    }
+    TableProcessus table(std::move(f_entree));
+    table.classerPids();
+    FileRestantCourt file(table);
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
     POSTCONDITION(!result.empty());
     return result;
@@ -105,51 +85,9 @@ File<Processus> TP::Ordonnanceur::round_robin(queue<Processus> f_entree, int qua
     PRECONDITION(quantum > 0); // le quantum doit être positif
     PRECONDITION(temps >= 0);  // le temps ne peut pas être négatif
 
-    queue<Processus> result;   // file des processus terminés
-    map<string, int> temps_execution; // stocker le temps d'exécution total de chaque processus
-    queue<Processus> attente_file; // file temporaire pour les processus en attente
-
-    // initialiser la map avec un temps d'exécution de 0 pour chaque processus
-    queue<Processus> copie_file = f_entree;
-    while (!copie_file.empty()) {
-        Processus p = copie_file.front();
-        copie_file.pop();
-        temps_execution[p.getPid()] = 0;
-    }
-
-    while (!f_entree.empty() || !attente_file.empty()) {
-        // ajouter les processus arrivés dans la file d'attente
-        while (!f_entree.empty() && f_entree.front().getArrivee() <= temps) {
-            attente_file.push(f_entree.front());
-            f_entree.pop();
-        }
-
-        if (!attente_file.empty()) {
-            Processus p = attente_file.front();
-            attente_file.pop();
-
-            if (p.getRestant() > quantum) {
-                // exécution partielle du processus (quantum non terminé)
-                p.setAttente(max(temps - p.getArrivee() - temps_execution[p.getPid()], 0));
-                temps_execution[p.getPid()] += quantum;
-                temps += quantum;
-                p.setRestant(p.getRestant() - quantum);
-                attente_file.push(p); // réinsérer dans la file d'attente
-            } else {
-                // exécution complète du processus
-                p.setAttente(max(temps - p.getArrivee() - temps_execution[p.getPid()], 0));
-                temps_execution[p.getPid()] += p.getRestant();
-                temps += p.getRestant();
-                p.setRestant(0); // processus terminé
-                result.push(p);  // ajouter à la file des résultats
-            }
-        } else {
-            // avancer le temps si aucun processus n'est prêt à être exécuté
-            if (!f_entree.empty()) {
-                temps = f_entree.front().getArrivee();
-            }
-        }
-    }
+    TableProcessus table(std::move(f_entree));
+    FileFifo file(table.taille(), quantum);
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
     POSTCONDITION(!result.empty());
     return result;
@@ -164,24 +102,29 @@ File<Processus> TP::Ordonnanceur::round_robin(queue<Processus> f_entree, int qua
 File<Processus> TP::Ordonnanceur::priorite(queue<Processus> f_entree, int& temps) {
     PRECONDITION(temps >= 0); // le temps ne peut pas être négatif
 
-    list<Processus> liste_processus;  // utiliser une liste pour trier facilement
-    while (!f_entree.empty()) {
-        liste_processus.push_back(f_entree.front());
-        f_entree.pop();
-    }
+    TableProcessus table(std::move(f_entree));
+    FilePriorite file(table);
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
-    // trier les processus par priorité décroissante
-    liste_processus.sort([](const Processus& a, const Processus& b) {
-        return a.getPriorite() > b.getPriorite();
-    });
+    POSTCONDITION(!result.empty());
+    return result;
+}
 
-    queue<Processus> result;
-    for (auto& p : liste_processus) {
-        p.setAttente(temps - p.getArrivee()); // calculer le temps d'attente
-        POSTCONDITION(p.getAttente() >= 0);
-        temps += p.getDuree(); // mettre à jour le temps global
-        result.push(p); // ajouter à la file résultat
-    }
+/**
+ * @brief ordonnanceur utilisant la méthode par priorité, préemptive.
+ *
+ * un processus qui arrive avec une priorité strictement supérieure à celle du processus élu
+ * prend sa place.
+ * @param f_entree file des processus à ordonnancer.
+ * @param temps temps actuel de la simulation.
+ * @return file des processus ordonnancés.
+ */
+File<Processus> TP::Ordonnanceur::priorite_preemptive(queue<Processus> f_entree, int& temps) {
+    PRECONDITION(temps >= 0);
+
+    TableProcessus table(std::move(f_entree));
+    FilePrioritePreemptive file(table);
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
     POSTCONDITION(!result.empty());
     return result;
@@ -198,94 +141,150 @@ File<Processus> TP::Ordonnanceur::multiniveaux(queue<Processus> f_entree, int qu
     PRECONDITION(quantum > 0); // le quantum doit être positif
     PRECONDITION(temps >= 0);  // le temps ne peut pas être négatif
 
-    list<Processus> systeme, interactif, batch, utilisateur;
-
-    // séparer les processus en différentes catégories
-    while (!f_entree.empty()) {
-        Processus p = f_entree.front();
-        f_entree.pop();
-        switch (p.getType()) {
-            case SYSTEME:
-                systeme.push_back(p);
-                break;
-            case INTERACTIF:
-                interactif.push_back(p);
-                break;
-            case BATCH:
-                batch.push_back(p);
-                break;
-            case UTILISATEUR:
-                utilisateur.push_back(p);
-                break;
-        }
-    }
+    TableProcessus table(std::move(f_entree));
+    FileMultiniveaux file(table, quantum);
+    queue<Processus> result = versFile(table, MoteurGenerique(table, file).executer(temps));
 
-    // file de résultat
-    queue<Processus> result;
+    POSTCONDITION(!result.empty());
+    return result;
+}
 
-    // traiter les processus système (priorité décroissante)
-    systeme.sort([](const Processus& a, const Processus& b) {
-        return a.getPriorite() > b.getPriorite();
+/**
+ * @brief simule une table de processus sans produire de copie des processus : chaque processus
+ * terminé est remis au puits, qui ne garde que ce dont il a besoin.
+ * @param politique nom de la politique d'ordonnancement.
+ * @param quantum quantum de la politique, ignoré si elle n'en utilise pas (voir utiliseQuantum).
+ * @param table processus à ordonnancer, modifiés en place.
+ * @param puits destination des processus terminés.
+ * @param temps temps actuel de la simulation.
+ * @param chronologie reçoit les tranches d'exécution, nullptr pour ne rien enregistrer.
+ * @param couts coûts des commutations de contexte.
+ * @param tempsCommutation reçoit le temps perdu en commutations, s'il n'est pas nul.
+ * @return false si la politique est inconnue.
+ */
+bool TP::Ordonnanceur::simuler(const string& politique, int quantum, TableProcessus& table, PuitsProcessus& puits,
+                               int& temps, Chronologie* chronologie, const CoutsCommutation& couts,
+                               int64_t* tempsCommutation) {
+    PRECONDITION(temps >= 0);
+    PRECONDITION(!table.estFlux());
+
+    return avecPolitique(politique, table, quantum, [&](auto& file) {
+        MoteurGenerique moteur(table, file);
+        moteur.setChronologie(chronologie);
+        moteur.setCouts(couts);
+        moteur.executer(puits, temps);
+        if (tempsCommutation != nullptr) {
+            *tempsCommutation = moteur.tempsCommutation();
+        }
     });
+}
 
-    for (auto& p : systeme) {
-        p.setAttente(temps - p.getArrivee());
-        temps += p.getDuree(); // mettre à jour le temps après chaque exécution
-        POSTCONDITION(p.getAttente() >= 0);
-        result.push(p);
-    }
-
-    // traiter les processus interactifs avec Round Robin
-    queue<Processus> file_interactif;
-    for (auto& p : interactif) {
-        file_interactif.push(p);
-    }
-
-    while (!file_interactif.empty()) {
-        Processus p = file_interactif.front();
-        file_interactif.pop();
-
-        // calcul du temps d'attente
-        if (p.getRestant() > quantum) {
-            if (temps > p.getArrivee()) {
-                p.setAttente(max(temps - p.getArrivee() - (p.getDuree() - p.getRestant()), 0));
-            }
-            temps += quantum;  // avancer le temps par quantum
-            p.setRestant(p.getRestant() - quantum);  // réduire le temps restant du processus
-            file_interactif.push(p);  // réinsérer dans la file pour le prochain tour
-        } else {
-            if (temps > p.getArrivee()) {
-                p.setAttente(max(temps - p.getArrivee() - (p.getDuree() - p.getRestant()), 0));
-            }
-            temps += p.getRestant();
-            p.setRestant(0);  // processus terminé
-            result.push(p);
+/**
+ * @brief prend des instantanés d'une simulation de la charge, tous pendant la même simulation,
+ * arrêtée après le dernier instant.
+ * @param politique nom de la politique d'ordonnancement jusqu'aux instantanés.
+ * @param quantum quantum de la politique, ignoré si elle n'en utilise pas (voir utiliseQuantum).
+ * @param charge processus à ordonnancer, partagés en lecture seule avec les instantanés.
+ * @param instants instants des instantanés, en ordre croissant.
+ * @param resultat reçoit un instantané par instant.
+ * @param couts coûts des commutations de contexte.
+ * @return false si la politique est inconnue.
+ * \pre charge n'est pas nulle ni en mode flux
+ * \pre les instants sont positifs et croissants
+ */
+bool TP::Ordonnanceur::instantanes(const string& politique, int quantum, shared_ptr<const TableProcessus> charge,
+                                   const vector<int>& instants, vector<shared_ptr<const Instantane>>& resultat,
+                                   const CoutsCommutation& couts) {
+    PRECONDITION(charge != nullptr && !charge->estFlux());
+    PRECONDITION(is_sorted(instants.begin(), instants.end()) && (instants.empty() || instants.front() >= 0));
+
+    TableProcessus table = TableProcessus::partager(charge);
+    return avecPolitique(politique, table, quantum, [&](auto& file) {
+        MoteurGenerique moteur(table, file);
+        moteur.setCouts(couts);
+        int temps = 0;
+        resultat.clear();
+        for (int instant : instants) {
+            moteur.executerJusqua(instant, temps);
+            auto instantane = make_shared<Instantane>();
+            instantane->charge = charge;
+            moteur.capturer(instant, *instantane);
+            instantane->politique = politique;
+            instantane->quantum = utiliseQuantum(politique) ? quantum : 0;
+            resultat.push_back(std::move(instantane));
         }
-    }
-
-    // traiter les processus batch et utilisateur (priorité décroissante)
-    batch.sort([](const Processus& a, const Processus& b) {
-        return a.getPriorite() > b.getPriorite();
     });
+}
 
-    for (auto& p : batch) {
-        p.setAttente(temps - p.getArrivee());  // calculer le temps d'attente
-        temps += p.getDuree();  // avancer le temps après chaque exécution
-        POSTCONDITION(p.getAttente() >= 0);
-        result.push(p);
-    }
-
-    utilisateur.sort([](const Processus& a, const Processus& b) {
-        return a.getPriorite() > b.getPriorite();
+/**
+ * @brief simule une branche à partir d'un instantané. La charge de l'instantané n'est pas copiée :
+ * seules les colonnes que la simulation modifie sont allouées pour la branche. Sous la politique et
+ * le quantum de l'instantané, la branche prolonge exactement sa simulation (voir prolonge).
+ * @param politique nom de la politique d'ordonnancement de la branche.
+ * @param quantum quantum de la politique, ignoré si elle n'en utilise pas (voir utiliseQuantum).
+ * @param instantane point de départ de la branche.
+ * @param puits destination des processus terminés, ceux d'avant l'instantané d'abord.
+ * @param temps reçoit le temps de fin de la branche.
+ * @param couts coûts des commutations de contexte de la branche.
+ * @param tempsCommutation reçoit le temps perdu en commutations depuis le début de la simulation,
+ * s'il n'est pas nul.
+ * @return false si la politique est inconnue, ou si l'état de la politique gardé par l'instantané
+ * est invalide ; rien n'est alors simulé.
+ * \pre instantane a une charge
+ */
+bool TP::Ordonnanceur::reprendre(const string& politique, int quantum, const Instantane& instantane,
+                                 PuitsProcessus& puits, int& temps, const CoutsCommutation& couts,
+                                 int64_t* tempsCommutation) {
+    PRECONDITION(instantane.charge != nullptr);
+
+    TableProcessus table = TableProcessus::partager(instantane.charge);
+    bool repris = false;
+    bool connue = avecPolitique(politique, table, quantum, [&](auto& file) {
+        MoteurGenerique moteur(table, file);
+        moteur.setCouts(couts);
+        repris = moteur.reprendre(instantane, prolonge(politique, quantum, instantane));
+        if (!repris) {
+            return;
+        }
+        for (const EtatProcessus& e : instantane.termines) {
+            puits.recevoir(table, e.id);
+        }
+        temps = instantane.temps;
+        moteur.executer(puits, temps);
+        if (tempsCommutation != nullptr) {
+            *tempsCommutation = moteur.tempsCommutation();
+        }
     });
+    return connue && repris;
+}
 
-    for (auto& p : utilisateur) {
-        p.setAttente(temps - p.getArrivee());  // calculer le temps d'attente
-        temps += p.getDuree();  // avancer le temps après chaque exécution
-        POSTCONDITION(p.getAttente() >= 0);
-        result.push(p);
-    }
+/**
+ * @brief simule une trace en flux, sans la charger : les processus sont lus dans l'ordre
+ * d'arrivée et chaque processus terminé est transmis au puits aussitôt.
+ * @param politique nom de la politique d'ordonnancement.
+ * @param quantum quantum de la politique, ignoré si elle n'en utilise pas (voir utiliseQuantum).
+ * @param source processus à ordonnancer, dans l'ordre d'arrivée.
+ * @param puits destination des processus terminés.
+ * @param temps temps actuel de la simulation.
+ * @param chronologie reçoit les tranches d'exécution, nullptr pour ne rien enregistrer ; les processus
+ * y sont désignés par leur numéro d'admission.
+ * @param couts coûts des commutations de contexte.
+ * @param tempsCommutation reçoit le temps perdu en commutations, s'il n'est pas nul.
+ * @return false si la politique est inconnue.
+ */
+bool TP::Ordonnanceur::flux(const string& politique, int quantum, SourceProcessus& source, PuitsProcessus& puits,
+                            int& temps, Chronologie* chronologie, const CoutsCommutation& couts,
+                            int64_t* tempsCommutation) {
+    PRECONDITION(temps >= 0);
 
-    POSTCONDITION(!result.empty());
-    return result;
+    TableProcessus table = TableProcessus::pourFlux();
+    return avecPolitique(politique, table, quantum, [&](auto& file) {
+        MoteurGenerique moteur(table, file);
+        moteur.setChronologie(chronologie);
+        moteur.setCouts(couts);
+        moteur.executer(source, puits, temps);
+        if (tempsCommutation != nullptr) {
+            *tempsCommutation = moteur.tempsCommutation();
+        }
+    });
 }
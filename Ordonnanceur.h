@@ -1,16 +1,18 @@
 #include "processus.h"
+#include "Moteur.h"
+#include "Flux.h"
+#include "Instantane.h"
+#include <memory>
 #include <queue>
+#include <string>
+#include <vector>
 using namespace std;
 
 #ifndef ORDONNANCEUR_H
 #define ORDONNANCEUR_H
 
-template<typename T>
-using File = std::queue<T>;
 namespace TP {
 
-
-
     class Ordonnanceur {
     public:
         // Algorithme Premier Arrivé, Premier Servi (FCFS)
@@ -19,15 +21,46 @@ namespace TP {
         // Algorithme Plus Court d'abord (SJF)
         static File<Processus> fjs(queue<Processus> f_entree, int& temps);
 
+        // Algorithme Plus Court Temps Restant d'abord (SRTF), préemptif
+        static File<Processus> srtf(queue<Processus> f_entree, int& temps);
+
         // Algorithme Round Robin (RR)
         static File<Processus> round_robin(queue<Processus> f_entree, int quantum, int& temps);
 
         // Algorithme d'ordonnancement par priorité
         static File<Processus> priorite(queue<Processus> f_entree, int& temps);
 
+        // Algorithme d'ordonnancement par priorité préemptif
+        static File<Processus> priorite_preemptive(queue<Processus> f_entree, int& temps);
+
         // Algorithme d'ordonnancement à files d'attente multiniveaux
         static File<Processus> multiniveaux(queue<Processus> f_entree, int quantum, int& temps);
 
+        // simulation d'une table chargée par une politique nommée, chaque processus terminé étant remis
+        // au puits ; false si le nom est inconnu. Les tranches sont enregistrées dans chronologie si elle
+        // n'est pas nulle, le temps perdu en commutations dans tempsCommutation s'il n'est pas nul
+        static bool simuler(const string& politique, int quantum, TableProcessus& table, PuitsProcessus& puits,
+                            int& temps, Chronologie* chronologie = nullptr, const CoutsCommutation& couts = {},
+                            int64_t* tempsCommutation = nullptr);
+
+        // simulation en flux d'une politique nommée (voir creerPolitique) ; false si le nom est inconnu
+        static bool flux(const string& politique, int quantum, SourceProcessus& source, PuitsProcessus& puits,
+                         int& temps, Chronologie* chronologie = nullptr, const CoutsCommutation& couts = {},
+                         int64_t* tempsCommutation = nullptr);
+
+        // instantanés d'une simulation de la charge aux instants donnés, en ordre croissant, pris
+        // pendant une seule simulation ; false si le nom est inconnu
+        static bool instantanes(const string& politique, int quantum, shared_ptr<const TableProcessus> charge,
+                                const vector<int>& instants, vector<shared_ptr<const Instantane>>& resultat,
+                                const CoutsCommutation& couts = {});
+
+        // simulation d'une branche repartant d'un instantané, sous une politique quelconque : les
+        // processus terminés avant l'instantané sont remis au puits sans être simulés à nouveau ;
+        // false si le nom est inconnu ou si l'état de la politique de l'instantané est invalide
+        static bool reprendre(const string& politique, int quantum, const Instantane& instantane,
+                              PuitsProcessus& puits, int& temps, const CoutsCommutation& couts = {},
+                              int64_t* tempsCommutation = nullptr);
+
         void verifieInvariant() const;
     };
 
@@ -0,0 +1,1148 @@
+#include "Politiques.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <sstream>
+#include "ContratModule.h"
+
+namespace {
+
+    size_t capaciteDe(const TP::TableProcessus& table, size_t capacite) {
+        return capacite == TP::CAPACITE_TABLE ? table.taille() : capacite;
+    }
+
+    // processus qu'un état restauré doit nommer, chacun une seule fois
+    class Attendus {
+    public:
+        Attendus(size_t taille, const vector<TP::IdProcessus>& ids, TP::IdProcessus elu = TP::AUCUN_PROCESSUS)
+            : m_attendus(taille, false), m_restants(0) {
+            ajouter(ids);
+            if (elu != TP::AUCUN_PROCESSUS) {
+                ajouter({elu});
+            }
+        }
+
+        void ajouter(const vector<TP::IdProcessus>& ids) {
+            for (TP::IdProcessus id : ids) {
+                m_attendus[id] = true;
+            }
+            m_restants += ids.size();
+        }
+
+        // vrai si le processus est attendu et n'a pas encore été nommé
+        bool prendre(TP::IdProcessus id) {
+            if (!m_attendus[id]) {
+                return false;
+            }
+            m_attendus[id] = false;
+            --m_restants;
+            return true;
+        }
+
+        bool tousPris() const { return m_restants == 0; }
+
+    private:
+        vector<bool> m_attendus;
+        size_t m_restants;
+    };
+
+    // plus grand identifiant de la table, pour lire un identifiant
+    int64_t dernierId(const TP::TableProcessus& table) {
+        return static_cast<int64_t>(table.taille()) - 1;
+    }
+
+} // namespace
+
+// FileFifo
+
+/**
+ * @brief Constructeur de la file FIFO.
+ * @param capacite nombre maximal de processus prêts en même temps.
+ * @param quantum durée maximale d'une tranche, 0 pour exécuter chaque processus jusqu'à la fin.
+ * \pre quantum >= 0
+ */
+TP::FileFifo::FileFifo(size_t capacite, int quantum) : m_file(capacite), m_quantum(quantum) {
+    PRECONDITION(quantum >= 0);
+}
+
+// FileCourtDabord
+
+/**
+ * @brief Constructeur de la file Plus Court d'abord.
+ *
+ * le tas ne compare que des entiers : la durée, puis le rang de départage de la table.
+ * @param table processus simulés.
+ * @param capacite nombre de processus prêts prévus.
+ * \pre table.rangsDisponibles()
+ */
+TP::FileCourtDabord::FileCourtDabord(const TableProcessus& table, size_t capacite) : m_table(table) {
+    PRECONDITION(table.rangsDisponibles());
+
+    vector<Cle> reserve;
+    reserve.reserve(capaciteDe(table, capacite));
+    m_tas = priority_queue<Cle, vector<Cle>, greater<Cle>>(greater<Cle>(), std::move(reserve));
+}
+
+/**
+ * @brief insère le processus dans le tas en O(log n).
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FileCourtDabord::ajouter(IdProcessus id) {
+    m_tas.push({m_table.duree(id), m_table.rang(id), id});
+}
+
+/**
+ * @brief retire le processus de plus courte durée en O(log n).
+ * @return identifiant du processus élu.
+ */
+TP::IdProcessus TP::FileCourtDabord::extraire() {
+    PRECONDITION(!m_tas.empty());
+    IdProcessus id = m_tas.top().id;
+    m_tas.pop();
+    return id;
+}
+
+bool TP::FileCourtDabord::estVide() const {
+    return m_tas.empty();
+}
+
+// FilePriorite
+
+TP::FilePriorite::FilePriorite(const TableProcessus& table) : m_table(table), m_nbEntrees(0) {
+}
+
+/**
+ * @brief insère le processus dans le tas en O(log n) ; il passe après tous ceux de priorité
+ * supérieure ou égale déjà dans la file.
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FilePriorite::ajouter(IdProcessus id) {
+    m_tas.push({m_table.priorite(id), m_nbEntrees++, id});
+}
+
+/**
+ * @brief retire le processus de plus haute priorité entré le premier, en O(log n).
+ * @return identifiant du processus élu.
+ */
+TP::IdProcessus TP::FilePriorite::extraire() {
+    PRECONDITION(!m_tas.empty());
+    IdProcessus id = m_tas.top().id;
+    m_tas.pop();
+    return id;
+}
+
+bool TP::FilePriorite::estVide() const {
+    return m_tas.empty();
+}
+
+// FileIndexee
+
+TP::FileIndexee::FileIndexee(const TableProcessus& table, size_t capacite)
+    : m_table(table), m_tas(capaciteDe(table, capacite)), m_elu(AUCUN_PROCESSUS) {
+}
+
+/**
+ * @brief rend le processus prêt ; s'il est déjà dans le tas (processus élu qui revient),
+ * seule sa clé est mise à jour.
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FileIndexee::ajouter(IdProcessus id) {
+    if (m_tas.contient(id)) {
+        m_tas.modifierCle(id, cle(id));
+        if (id == m_elu) {
+            m_elu = AUCUN_PROCESSUS;
+        }
+    } else {
+        m_tas.inserer(id, cle(id));
+    }
+}
+
+/**
+ * @brief élit le processus de plus petite clé, qui reste dans le tas pendant son exécution.
+ * @return identifiant du processus élu.
+ * \pre aucun processus n'est déjà élu
+ */
+TP::IdProcessus TP::FileIndexee::extraire() {
+    PRECONDITION(!estVide());
+    PRECONDITION(m_elu == AUCUN_PROCESSUS);
+    m_elu = m_tas.sommet();
+    return m_elu;
+}
+
+bool TP::FileIndexee::estVide() const {
+    return m_tas.taille() == (m_elu == AUCUN_PROCESSUS ? 0 : 1);
+}
+
+/**
+ * @brief le processus qui arrive préempte si sa clé primaire est strictement plus petite.
+ * @param courant processus élu, dont le temps restant est à jour.
+ * @param arrivant processus qui vient d'arriver.
+ */
+bool TP::FileIndexee::preempte(IdProcessus courant, IdProcessus arrivant) const {
+    return cle(arrivant).first < cle(courant).first;
+}
+
+void TP::FileIndexee::terminer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    m_tas.retirer(id);
+    m_elu = AUCUN_PROCESSUS;
+}
+
+/**
+ * @brief retire le meilleur processus prêt ; le processus élu, qui reste dans le tas, est mis
+ * de côté le temps de l'extraction puis remis avec sa clé.
+ */
+TP::IdProcessus TP::FileIndexee::ceder() {
+    if (estVide()) {
+        return AUCUN_PROCESSUS;
+    }
+    if (m_elu == AUCUN_PROCESSUS) {
+        return static_cast<IdProcessus>(m_tas.extraire());
+    }
+    Cle cleElu = m_tas.cle(m_elu);
+    m_tas.retirer(m_elu);
+    IdProcessus id = static_cast<IdProcessus>(m_tas.extraire());
+    m_tas.inserer(m_elu, cleElu);
+    return id;
+}
+
+// le tas, élu compris, avec la clé de chaque processus
+void TP::FileIndexee::sauver(vector<int64_t>& etat) const {
+    etat.push_back(static_cast<int64_t>(m_tas.taille()));
+    m_tas.parcourir([&etat](size_t id, const Cle& cle) {
+        etat.insert(etat.end(), {static_cast<int64_t>(id), cle.first, static_cast<int64_t>(cle.second)});
+    });
+}
+
+/**
+ * @brief reprend le tas sauvé, qui contient exactement les processus prêts et l'élu.
+ * \pre la file est vide
+ */
+bool TP::FileIndexee::restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>&,
+                                LecteurEtat& etat) {
+    PRECONDITION(m_tas.estVide());
+    Attendus attendus(m_table.taille(), prets, elu);
+    int64_t nb = etat.lire(0, static_cast<int64_t>(m_table.taille()));
+    for (int64_t i = 0; i < nb && etat.valide(); ++i) {
+        IdProcessus id = static_cast<IdProcessus>(etat.lire(0, dernierId(m_table)));
+        Cle cle;
+        cle.first = etat.lire(INT64_MIN, INT64_MAX);
+        cle.second = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+        if (!attendus.prendre(id)) {
+            return false;
+        }
+        m_tas.inserer(id, cle);
+    }
+    m_elu = elu;
+    return attendus.tousPris();
+}
+
+// FileRestantCourt
+
+/**
+ * \pre table.rangsDisponibles()
+ */
+TP::FileRestantCourt::FileRestantCourt(const TableProcessus& table, size_t capacite)
+    : FileIndexee(table, capacite) {
+    PRECONDITION(table.rangsDisponibles());
+}
+
+TP::FileIndexee::Cle TP::FileRestantCourt::cle(IdProcessus id) const {
+    return {m_table.restant(id) - m_table.finRafale(id), m_table.rang(id)};
+}
+
+// FilePrioritePreemptive
+
+TP::FilePrioritePreemptive::FilePrioritePreemptive(const TableProcessus& table, size_t capacite)
+    : FileIndexee(table, capacite), m_compteur(0) {
+}
+
+void TP::FilePrioritePreemptive::ajouter(IdProcessus id) {
+    bool nouveau = cleRangee(id) == nullptr;
+    FileIndexee::ajouter(id);
+    if (nouveau) {
+        ++m_compteur;
+    }
+}
+
+void TP::FilePrioritePreemptive::sauver(vector<int64_t>& etat) const {
+    FileIndexee::sauver(etat);
+    etat.push_back(static_cast<int64_t>(m_compteur));
+}
+
+bool TP::FilePrioritePreemptive::restaurer(const vector<IdProcessus>& prets, IdProcessus elu,
+                                           const vector<IdProcessus>& bloques, LecteurEtat& etat) {
+    bool valide = FileIndexee::restaurer(prets, elu, bloques, etat);
+    m_compteur = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+    return valide;
+}
+
+// un processus absent du tas (arrivée, ou migration depuis un autre processeur) prend le rang suivant
+TP::FileIndexee::Cle TP::FilePrioritePreemptive::cle(IdProcessus id) const {
+    const Cle* rangee = cleRangee(id);
+    return {-m_table.priorite(id), rangee != nullptr ? rangee->second : m_compteur};
+}
+
+// FileEcheance
+
+TP::FileEcheance::FileEcheance(const TableProcessus& table, bool preemptive, size_t capacite)
+    : FileIndexee(table, capacite), m_preemptive(preemptive), m_compteur(0) {
+}
+
+void TP::FileEcheance::ajouter(IdProcessus id) {
+    bool nouveau = cleRangee(id) == nullptr;
+    FileIndexee::ajouter(id);
+    if (nouveau) {
+        ++m_compteur;
+    }
+}
+
+bool TP::FileEcheance::preempte(IdProcessus courant, IdProcessus arrivant) const {
+    return m_preemptive && FileIndexee::preempte(courant, arrivant);
+}
+
+void TP::FileEcheance::sauver(vector<int64_t>& etat) const {
+    FileIndexee::sauver(etat);
+    etat.push_back(static_cast<int64_t>(m_compteur));
+}
+
+bool TP::FileEcheance::restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                                 LecteurEtat& etat) {
+    bool valide = FileIndexee::restaurer(prets, elu, bloques, etat);
+    m_compteur = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+    return valide;
+}
+
+TP::FileIndexee::Cle TP::FileEcheance::cle(IdProcessus id) const {
+    const Cle* rangee = cleRangee(id);
+    return {m_table.echeanceAbsolue(id), rangee != nullptr ? rangee->second : m_compteur};
+}
+
+// FileMultiniveaux
+
+/**
+ * @brief Constructeur de la file multiniveaux.
+ * @param table processus simulés.
+ * @param quantum quantum du tourniquet des processus interactifs.
+ * @param capacite nombre de processus prêts prévus.
+ * \pre quantum > 0
+ */
+TP::FileMultiniveaux::FileMultiniveaux(const TableProcessus& table, int quantum, size_t capacite)
+    : m_table(table), m_systeme(table), m_interactif(capaciteDe(table, capacite), quantum),
+      m_batch(table), m_utilisateur(table) {
+    PRECONDITION(quantum > 0);
+}
+
+void TP::FileMultiniveaux::ajouter(IdProcessus id) {
+    switch (m_table.type(id)) {
+        case SYSTEME:
+            m_systeme.ajouter(id);
+            break;
+        case INTERACTIF:
+            m_interactif.ajouter(id);
+            break;
+        case BATCH:
+            m_batch.ajouter(id);
+            break;
+        case UTILISATEUR:
+            m_utilisateur.ajouter(id);
+            break;
+    }
+}
+
+/**
+ * @brief extrait le prochain processus du niveau non vide le plus prioritaire.
+ * @return identifiant du processus élu.
+ */
+TP::IdProcessus TP::FileMultiniveaux::extraire() {
+    PRECONDITION(!estVide());
+    if (!m_systeme.estVide()) {
+        return m_systeme.extraire();
+    }
+    if (!m_interactif.estVide()) {
+        return m_interactif.extraire();
+    }
+    if (!m_batch.estVide()) {
+        return m_batch.extraire();
+    }
+    return m_utilisateur.extraire();
+}
+
+bool TP::FileMultiniveaux::estVide() const {
+    return m_systeme.estVide() && m_interactif.estVide() && m_batch.estVide() && m_utilisateur.estVide();
+}
+
+int TP::FileMultiniveaux::quantum(IdProcessus id) const {
+    return m_table.type(id) == INTERACTIF ? m_interactif.quantum(id) : 0;
+}
+
+// FileRetroaction
+
+/**
+ * @brief Constructeur de la file multiniveaux à rétroaction.
+ * @param table processus simulés.
+ * @param quanta quantum de chaque niveau, du plus prioritaire au dernier.
+ * @param periode intervalle des rehaussements, 0 pour n'en faire aucun.
+ * @param capacite nombre de processus prêts prévus, réparti entre les niveaux ; chaque niveau
+ * grandit au besoin.
+ * \pre 1 <= quanta.size() <= NB_NIVEAUX_MAX et chaque quantum > 0
+ * \pre periode >= 0
+ */
+TP::FileRetroaction::FileRetroaction(const TableProcessus& table, vector<int> quanta, int periode, size_t capacite)
+    : m_table(table), m_quanta(std::move(quanta)), m_periode(periode), m_nonVides(0), m_etats({0, ABSENT, false, 0}),
+      m_elu(AUCUN_PROCESSUS), m_nbRehaussements(0) {
+    PRECONDITION(!m_quanta.empty() && m_quanta.size() <= NB_NIVEAUX_MAX);
+    PRECONDITION(all_of(m_quanta.begin(), m_quanta.end(), [](int q) { return q > 0; }));
+    PRECONDITION(periode >= 0);
+
+    m_niveaux.reserve(m_quanta.size());
+    for (size_t n = 0; n < m_quanta.size(); ++n) {
+        m_niveaux.emplace_back(capaciteDe(table, capacite) / m_quanta.size() + 1);
+    }
+}
+
+/**
+ * \pre quantum > 0
+ */
+TP::FileRetroaction::FileRetroaction(const TableProcessus& table, int quantum, size_t capacite)
+    : FileRetroaction(table, quantaDoubles(quantum, NB_NIVEAUX_DEFAUT), 0, capacite) {
+    m_periode = 2 * m_quanta.back();
+}
+
+vector<int> TP::FileRetroaction::quantaDoubles(int quantum, size_t nbNiveaux) {
+    PRECONDITION(quantum > 0);
+    vector<int> quanta(nbNiveaux);
+    int64_t q = min(quantum, INT32_MAX / 2);
+    for (int& n : quanta) {
+        n = static_cast<int>(q);
+        q = min<int64_t>(q * 2, INT32_MAX / 2);
+    }
+    return quanta;
+}
+
+// met le processus à la fin de la file du niveau et lève le bit du niveau
+void TP::FileRetroaction::placer(IdProcessus id, size_t niveau) {
+    m_etats[id].niveau = static_cast<uint8_t>(niveau);
+    m_niveaux[niveau].ajouter(id);
+    m_nonVides |= uint64_t(1) << niveau;
+}
+
+/**
+ * @brief rend le processus prêt : un nouveau processus entre au niveau de son type ; le processus
+ * élu ou en E/S qui revient descend d'un niveau s'il a épuisé le quantum du sien, et le garde sinon.
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FileRetroaction::ajouter(IdProcessus id) {
+    Etat& etat = m_etats.occupe(id) ? m_etats[id] : m_etats.occuper(id);
+    size_t niveau;
+    if (etat.bloque && etat.rehaussement != m_nbRehaussements) {
+        etat.bloque = false;
+        niveau = niveauDeDepart(id);
+        etat.restantAuNiveau = m_table.restant(id);
+    } else if (id == m_elu || etat.bloque) {
+        if (id == m_elu) {
+            m_elu = AUCUN_PROCESSUS;
+        }
+        etat.bloque = false;
+        niveau = etat.niveau;
+        if (etat.restantAuNiveau - m_table.restant(id) >= m_quanta[niveau]) {
+            niveau = min(niveau + 1, m_niveaux.size() - 1);
+            etat.restantAuNiveau = m_table.restant(id);
+        }
+    } else {
+        PRECONDITION(etat.niveau == ABSENT);
+        niveau = niveauDeDepart(id);
+        etat.restantAuNiveau = m_table.restant(id);
+    }
+    placer(id, niveau);
+}
+
+/**
+ * @brief élit le premier processus du niveau non vide le plus prioritaire, trouvé par le bit
+ * le plus faible de l'index.
+ * @return identifiant du processus élu.
+ * \pre aucun processus n'est déjà élu
+ */
+TP::IdProcessus TP::FileRetroaction::extraire() {
+    PRECONDITION(!estVide());
+    PRECONDITION(m_elu == AUCUN_PROCESSUS);
+    size_t niveau = static_cast<size_t>(__builtin_ctzll(m_nonVides));
+    m_elu = m_niveaux[niveau].extraire();
+    if (m_niveaux[niveau].estVide()) {
+        m_nonVides &= ~(uint64_t(1) << niveau);
+    }
+    return m_elu;
+}
+
+// reste du quantum du niveau : un processus préempté reprend là où il s'était arrêté
+int TP::FileRetroaction::quantum(IdProcessus id) const {
+    const Etat& etat = m_etats[id];
+    return m_quanta[etat.niveau] - (etat.restantAuNiveau - m_table.restant(id));
+}
+
+bool TP::FileRetroaction::preempte(IdProcessus courant, IdProcessus arrivant) const {
+    return m_etats[arrivant].niveau < m_etats[courant].niveau;
+}
+
+void TP::FileRetroaction::terminer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    m_etats.liberer(id);
+    m_elu = AUCUN_PROCESSUS;
+}
+
+// le processus garde son niveau et son quantum entamé jusqu'à son retour
+void TP::FileRetroaction::bloquer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    m_etats[id].bloque = true;
+    m_etats[id].rehaussement = m_nbRehaussements;
+    m_elu = AUCUN_PROCESSUS;
+}
+
+void TP::FileRetroaction::oublier(IdProcessus id) {
+    PRECONDITION(m_etats[id].bloque);
+    m_etats.liberer(id);
+}
+
+// cède un processus du niveau le moins prioritaire, celui qui perd le moins à attendre une migration
+TP::IdProcessus TP::FileRetroaction::ceder() {
+    if (estVide()) {
+        return AUCUN_PROCESSUS;
+    }
+    size_t niveau = 63 - static_cast<size_t>(__builtin_clzll(m_nonVides));
+    IdProcessus id = m_niveaux[niveau].extraire();
+    if (m_niveaux[niveau].estVide()) {
+        m_nonVides &= ~(uint64_t(1) << niveau);
+    }
+    m_etats.liberer(id);
+    return id;
+}
+
+/**
+ * @brief remet chaque processus prêt, et le processus élu, au niveau de son type avec un quantum
+ * entier, ce qui évite la famine des processus descendus au dernier niveau. L'ordre des processus
+ * est conservé à l'intérieur de chaque niveau.
+ */
+void TP::FileRetroaction::rehausser() {
+    ++m_nbRehaussements; // les processus en E/S seront rehaussés à leur retour
+    m_nonVides = 0;
+    for (size_t n = 0; n < m_niveaux.size(); ++n) {
+        // un processus ne descend jamais sous son niveau de départ : il reste dans le sien ou remonte
+        // dans un niveau déjà parcouru
+        for (size_t i = m_niveaux[n].taille(); i > 0; --i) {
+            IdProcessus id = m_niveaux[n].extraire();
+            m_etats[id].restantAuNiveau = m_table.restant(id);
+            placer(id, niveauDeDepart(id));
+        }
+    }
+    if (m_elu != AUCUN_PROCESSUS) {
+        m_etats[m_elu] = {m_table.restant(m_elu), static_cast<uint8_t>(niveauDeDepart(m_elu)), false, 0};
+    }
+}
+
+// le contenu de chaque niveau, dans l'ordre, puis l'état de chaque processus connu
+void TP::FileRetroaction::sauver(vector<int64_t>& etat) const {
+    etat.push_back(m_nbRehaussements);
+    etat.push_back(static_cast<int64_t>(m_niveaux.size()));
+    for (const FileCirculaire<IdProcessus>& niveau : m_niveaux) {
+        etat.push_back(static_cast<int64_t>(niveau.taille()));
+        for (size_t i = 0; i < niveau.taille(); ++i) {
+            etat.push_back(niveau[i]);
+        }
+    }
+    size_t nbEtats = etat.size();
+    etat.push_back(0);
+    m_etats.parcourir([&etat, nbEtats](size_t id, const Etat& e) {
+        etat.insert(etat.end(), {static_cast<int64_t>(id), e.restantAuNiveau, e.niveau, e.bloque, e.rehaussement});
+        ++etat[nbEtats];
+    });
+}
+
+/**
+ * @brief reprend les niveaux sauvés, qui contiennent exactement les processus prêts, et l'état de
+ * chaque processus prêt, élu ou en E/S.
+ * \pre la file est vide
+ */
+bool TP::FileRetroaction::restaurer(const vector<IdProcessus>& prets, IdProcessus elu,
+                                    const vector<IdProcessus>& bloques, LecteurEtat& etat) {
+    PRECONDITION(estVide() && m_elu == AUCUN_PROCESSUS);
+    m_nbRehaussements = static_cast<uint32_t>(etat.lire(0, UINT32_MAX));
+    if (etat.lire(0, NB_NIVEAUX_MAX) != static_cast<int64_t>(m_niveaux.size())) {
+        return false;
+    }
+    Attendus attendus(m_table.taille(), prets);
+    for (size_t n = 0; n < m_niveaux.size(); ++n) {
+        int64_t nb = etat.lire(0, static_cast<int64_t>(prets.size()));
+        for (int64_t i = 0; i < nb && etat.valide(); ++i) {
+            IdProcessus id = static_cast<IdProcessus>(etat.lire(0, dernierId(m_table)));
+            if (!attendus.prendre(id)) {
+                return false;
+            }
+            m_niveaux[n].ajouter(id);
+            m_nonVides |= uint64_t(1) << n;
+        }
+    }
+    Attendus connus(m_table.taille(), prets, elu);
+    connus.ajouter(bloques);
+    int64_t nb = etat.lire(0, static_cast<int64_t>(m_table.taille()));
+    for (int64_t i = 0; i < nb && etat.valide(); ++i) {
+        IdProcessus id = static_cast<IdProcessus>(etat.lire(0, dernierId(m_table)));
+        Etat e;
+        e.restantAuNiveau = static_cast<int>(etat.lire(0, INT32_MAX));
+        e.niveau = static_cast<uint8_t>(etat.lire(0, static_cast<int64_t>(m_niveaux.size()) - 1));
+        e.bloque = etat.lire(0, 1) != 0;
+        e.rehaussement = static_cast<uint32_t>(etat.lire(0, UINT32_MAX));
+        if (!connus.prendre(id)) {
+            return false;
+        }
+        m_etats.occuper(id) = e;
+    }
+    if (!attendus.tousPris() || !connus.tousPris()) {
+        return false;
+    }
+
+    // chaque processus prêt est dans la file de son niveau, seuls les processus en E/S sont bloqués
+    for (size_t n = 0; n < m_niveaux.size(); ++n) {
+        for (size_t i = 0; i < m_niveaux[n].taille(); ++i) {
+            const Etat& e = m_etats[m_niveaux[n][i]];
+            if (e.niveau != n || e.bloque) {
+                return false;
+            }
+        }
+    }
+    if ((elu != AUCUN_PROCESSUS && m_etats[elu].bloque)
+        || !all_of(bloques.begin(), bloques.end(), [this](IdProcessus id) { return m_etats[id].bloque; })) {
+        return false;
+    }
+    m_elu = elu;
+    return true;
+}
+
+// partage proportionnel
+
+/**
+ * @brief poids de Linux (sched_prio_to_weight) pour le nice -priorite, borné à [-20, 19].
+ */
+int TP::poidsPriorite(int priorite) {
+    static constexpr int POIDS[40] = {
+        88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+        9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,
+        1024,  820,   655,   526,   423,   335,   272,   215,   172,   137,
+        110,   87,    70,    56,    45,    36,    29,    23,    18,    15};
+    int nice = std::clamp(-priorite, -20, 19);
+    return POIDS[nice + 20];
+}
+
+// FileEquitable
+
+/**
+ * @brief Constructeur de la file équitable.
+ * @param table processus simulés.
+ * @param granulariteMin tranche minimale, et avance du processus élu au-delà de laquelle un
+ * processus qui arrive le préempte.
+ * @param latenceCible période pendant laquelle chaque processus prêt devrait être élu une fois.
+ * l'arbre et les états ne suivent que les processus présents : la capacité prévue n'est pas utilisée.
+ * \pre granulariteMin > 0
+ * \pre latenceCible >= granulariteMin
+ */
+TP::FileEquitable::FileEquitable(const TableProcessus& table, int granulariteMin, int latenceCible, size_t)
+    : m_table(table), m_granulariteMin(granulariteMin), m_latenceCible(latenceCible), m_etats({0, false, false}),
+      m_tempsVirtuelMin(0), m_poidsTotal(0), m_compteur(0), m_elu(AUCUN_PROCESSUS), m_restantElection(0) {
+    PRECONDITION(granulariteMin > 0);
+    PRECONDITION(latenceCible >= granulariteMin);
+}
+
+void TP::FileEquitable::ranger(IdProcessus id) {
+    m_arbre.insert({m_etats[id].tempsVirtuel, m_compteur++, id});
+    m_tempsVirtuelMin = max(m_tempsVirtuelMin, m_arbre.begin()->tempsVirtuel);
+}
+
+/**
+ * @brief rend le processus prêt : un nouveau processus part du plus petit temps virtuel ; le
+ * processus élu qui revient est crédité du temps qu'il vient d'exécuter ; celui qui revient
+ * d'une E/S garde le sien, sans descendre plus d'une demi-latence cible sous le plus petit.
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FileEquitable::ajouter(IdProcessus id) {
+    Etat& etat = m_etats.occupe(id) ? m_etats[id] : m_etats.occuper(id);
+    if (id == m_elu) {
+        m_elu = AUCUN_PROCESSUS;
+        etat.tempsVirtuel += virtuel(m_restantElection - m_table.restant(id), poidsDe(id));
+    } else if (etat.bloque) {
+        int64_t plancher = m_tempsVirtuelMin - virtuel(m_latenceCible / 2, POIDS_NICE_0);
+        etat = {max(etat.tempsVirtuel, plancher), true, false};
+        m_poidsTotal += poidsDe(id);
+    } else {
+        PRECONDITION(!etat.present);
+        etat = {m_tempsVirtuelMin, true, false};
+        m_poidsTotal += poidsDe(id);
+    }
+    ranger(id);
+}
+
+/**
+ * @brief élit le processus le plus à gauche de l'arbre, celui de plus petit temps virtuel.
+ * @return identifiant du processus élu.
+ * \pre aucun processus n'est déjà élu
+ */
+TP::IdProcessus TP::FileEquitable::extraire() {
+    PRECONDITION(!estVide());
+    PRECONDITION(m_elu == AUCUN_PROCESSUS);
+    m_elu = m_arbre.begin()->id;
+    m_arbre.erase(m_arbre.begin());
+    m_restantElection = m_table.restant(m_elu);
+    return m_elu;
+}
+
+// part du processus, au prorata de son poids, de la période d'ordonnancement
+int TP::FileEquitable::quantum(IdProcessus id) const {
+    int64_t nbProcessus = static_cast<int64_t>(m_arbre.size()) + (m_elu != AUCUN_PROCESSUS ? 1 : 0);
+    int64_t periode = max<int64_t>(m_latenceCible, nbProcessus * m_granulariteMin);
+    int64_t tranche = periode * poidsDe(id) / m_poidsTotal;
+    return static_cast<int>(std::clamp<int64_t>(tranche, m_granulariteMin, INT32_MAX));
+}
+
+/**
+ * @brief le processus qui arrive préempte si le processus élu, compté jusqu'à l'instant
+ * courant, a plus de granulariteMin d'avance sur lui en temps virtuel.
+ * @param courant processus élu, dont le temps restant est à jour.
+ * @param arrivant processus qui vient d'arriver.
+ */
+bool TP::FileEquitable::preempte(IdProcessus courant, IdProcessus arrivant) const {
+    int64_t courantAJour =
+        m_etats[courant].tempsVirtuel + virtuel(m_restantElection - m_table.restant(courant), poidsDe(courant));
+    return courantAJour - m_etats[arrivant].tempsVirtuel > virtuel(m_granulariteMin, poidsDe(arrivant));
+}
+
+void TP::FileEquitable::terminer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    m_etats.liberer(id);
+    m_poidsTotal -= poidsDe(id);
+    m_elu = AUCUN_PROCESSUS;
+}
+
+// le processus quitte le partage pendant son E/S, crédité du temps qu'il vient d'exécuter
+void TP::FileEquitable::bloquer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    Etat& etat = m_etats[id];
+    etat.tempsVirtuel += virtuel(m_restantElection - m_table.restant(id), poidsDe(id));
+    etat.present = false;
+    etat.bloque = true;
+    m_poidsTotal -= poidsDe(id);
+    m_elu = AUCUN_PROCESSUS;
+}
+
+void TP::FileEquitable::oublier(IdProcessus id) {
+    PRECONDITION(m_etats[id].bloque);
+    m_etats.liberer(id);
+}
+
+// cède le processus prêt le plus à droite, celui qui a le plus reçu ; il repart du temps virtuel
+// minimal de son nouveau processeur
+TP::IdProcessus TP::FileEquitable::ceder() {
+    if (estVide()) {
+        return AUCUN_PROCESSUS;
+    }
+    auto dernier = prev(m_arbre.end());
+    IdProcessus id = dernier->id;
+    m_arbre.erase(dernier);
+    m_etats.liberer(id);
+    m_poidsTotal -= poidsDe(id);
+    return id;
+}
+
+// l'ordre de chaque processus prêt dans l'arbre, puis l'état de chaque processus connu
+void TP::FileEquitable::sauver(vector<int64_t>& etat) const {
+    etat.insert(etat.end(), {m_tempsVirtuelMin, static_cast<int64_t>(m_compteur), m_restantElection,
+                             static_cast<int64_t>(m_arbre.size())});
+    for (const Cle& cle : m_arbre) {
+        etat.insert(etat.end(), {static_cast<int64_t>(cle.id), static_cast<int64_t>(cle.ordre)});
+    }
+    size_t nbEtats = etat.size();
+    etat.push_back(0);
+    m_etats.parcourir([&etat, nbEtats](size_t id, const Etat& e) {
+        etat.insert(etat.end(), {static_cast<int64_t>(id), e.tempsVirtuel, e.present, e.bloque});
+        ++etat[nbEtats];
+    });
+}
+
+/**
+ * @brief reprend l'arbre sauvé, qui contient exactement les processus prêts, et l'état de chaque
+ * processus prêt, élu ou en E/S ; le poids total est recalculé.
+ * \pre la file est vide
+ */
+bool TP::FileEquitable::restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                                  LecteurEtat& etat) {
+    PRECONDITION(estVide() && m_elu == AUCUN_PROCESSUS);
+    m_tempsVirtuelMin = etat.lire(INT64_MIN, INT64_MAX);
+    m_compteur = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+    m_restantElection = static_cast<int>(etat.lire(0, INT32_MAX));
+    if (etat.lire(0, static_cast<int64_t>(prets.size())) != static_cast<int64_t>(prets.size())) {
+        return false;
+    }
+    vector<Cle> cles(prets.size());
+    for (Cle& cle : cles) {
+        cle.id = static_cast<IdProcessus>(etat.lire(0, dernierId(m_table)));
+        cle.ordre = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+    }
+    Attendus connus(m_table.taille(), prets, elu);
+    connus.ajouter(bloques);
+    int64_t nb = etat.lire(0, static_cast<int64_t>(m_table.taille()));
+    for (int64_t i = 0; i < nb && etat.valide(); ++i) {
+        IdProcessus id = static_cast<IdProcessus>(etat.lire(0, dernierId(m_table)));
+        Etat e;
+        e.tempsVirtuel = etat.lire(INT64_MIN, INT64_MAX);
+        e.present = etat.lire(0, 1) != 0;
+        e.bloque = etat.lire(0, 1) != 0;
+        if (!connus.prendre(id)) {
+            return false;
+        }
+        m_etats.occuper(id) = e;
+    }
+    if (!etat.valide() || !connus.tousPris()) {
+        return false;
+    }
+
+    // les processus prêts et l'élu sont présents, les processus en E/S bloqués
+    Attendus attendus(m_table.taille(), prets);
+    for (Cle& cle : cles) {
+        cle.tempsVirtuel = m_etats[cle.id].tempsVirtuel;
+        if (!attendus.prendre(cle.id) || !m_etats[cle.id].present || !m_arbre.insert(cle).second) {
+            return false;
+        }
+        m_poidsTotal += poidsDe(cle.id);
+    }
+    if (elu != AUCUN_PROCESSUS) {
+        if (!m_etats[elu].present) {
+            return false;
+        }
+        m_poidsTotal += poidsDe(elu);
+    }
+    if (!all_of(bloques.begin(), bloques.end(), [this](IdProcessus id) { return m_etats[id].bloque; })) {
+        return false;
+    }
+    m_elu = elu;
+    return true;
+}
+
+// PartsParPriorite
+
+/**
+ * @brief compte une élection.
+ * @param priorite priorité du processus élu, déjà entré.
+ * @param tranche durée de la tranche attribuée.
+ */
+void TP::PartsParPriorite::elire(int priorite, int tranche) {
+    int64_t poidsTotal = 0;
+    for (const auto& [p, part] : m_parts) {
+        poidsTotal += part.poidsPresent;
+    }
+    PRECONDITION(poidsTotal > 0);
+    for (auto& [p, part] : m_parts) {
+        part.attendue += static_cast<double>(tranche) * part.poidsPresent / poidsTotal;
+    }
+    Part& elue = m_parts[priorite];
+    elue.recue += tranche;
+    ++elue.nbElections;
+}
+
+// FileLoterie
+
+/**
+ * @brief Constructeur de la file à loterie.
+ * @param table processus simulés.
+ * @param quantum durée de la tranche de chaque élu.
+ * @param graine graine des tirages.
+ * @param capacite nombre de processus prévus.
+ * \pre quantum > 0
+ */
+TP::FileLoterie::FileLoterie(const TableProcessus& table, int quantum, uint64_t graine, size_t capacite)
+    : m_table(table), m_quantum(quantum), m_alea(graine), m_billets(capaciteDe(table, capacite)),
+      m_elu(AUCUN_PROCESSUS) {
+    PRECONDITION(quantum > 0);
+}
+
+/**
+ * @brief rend le processus prêt : le processus élu qui revient garde sa case, un nouveau processus
+ * prend une case libre.
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FileLoterie::ajouter(IdProcessus id) {
+    if (id == m_elu) {
+        m_elu = AUCUN_PROCESSUS;
+    } else {
+        PRECONDITION(!m_cases.occupe(id));
+        uint32_t c;
+        if (m_casesLibres.empty()) {
+            c = static_cast<uint32_t>(m_detenteurs.size());
+            m_detenteurs.push_back(id);
+        } else {
+            c = m_casesLibres.back();
+            m_casesLibres.pop_back();
+            m_detenteurs[c] = id;
+        }
+        m_cases.occuper(id) = c;
+        m_parts.entrer(m_table.priorite(id));
+    }
+    m_billets.modifier(m_cases[id], poidsPriorite(m_table.priorite(id)));
+}
+
+// le processus quitte la file ; sa case, déjà sans billets, est reprise
+void TP::FileLoterie::rendreCase(IdProcessus id) {
+    m_casesLibres.push_back(m_cases[id]);
+    m_cases.liberer(id);
+}
+
+/**
+ * @brief tire un billet uniformément parmi ceux des processus prêts et retire son détenteur
+ * de l'arbre.
+ *
+ * le rejet des tirages au-delà du dernier multiple du total évite le biais du modulo.
+ */
+TP::IdProcessus TP::FileLoterie::tirer() {
+    uint64_t total = static_cast<uint64_t>(m_billets.total());
+    uint64_t limite = UINT64_MAX - UINT64_MAX % total;
+    uint64_t tirage;
+    do {
+        tirage = m_alea();
+    } while (tirage >= limite);
+    size_t c = m_billets.chercher(static_cast<int64_t>(tirage % total));
+    m_billets.modifier(c, 0);
+    return m_detenteurs[c];
+}
+
+TP::IdProcessus TP::FileLoterie::extraire() {
+    PRECONDITION(!estVide());
+    PRECONDITION(m_elu == AUCUN_PROCESSUS);
+    m_elu = tirer();
+    m_parts.elire(m_table.priorite(m_elu), min(m_quantum, m_table.restant(m_elu) - m_table.finRafale(m_elu)));
+    return m_elu;
+}
+
+void TP::FileLoterie::terminer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    rendreCase(id);
+    m_parts.sortir(m_table.priorite(id));
+    m_elu = AUCUN_PROCESSUS;
+}
+
+// cède un processus prêt tiré au sort, comme pour une élection
+TP::IdProcessus TP::FileLoterie::ceder() {
+    if (estVide()) {
+        return AUCUN_PROCESSUS;
+    }
+    IdProcessus id = tirer();
+    rendreCase(id);
+    m_parts.sortir(m_table.priorite(id));
+    return id;
+}
+
+/**
+ * @brief l'état du générateur, sous sa forme textuelle standard découpée en nombres, puis le
+ * détenteur de chaque case (-1 pour une case libre) et les cases libres dans l'ordre de leur reprise.
+ */
+void TP::FileLoterie::sauver(vector<int64_t>& etat) const {
+    stringstream texte;
+    texte << m_alea;
+    size_t nbMots = etat.size();
+    etat.push_back(0);
+    uint64_t mot;
+    while (texte >> mot) {
+        etat.push_back(static_cast<int64_t>(mot));
+        ++etat[nbMots];
+    }
+    etat.push_back(static_cast<int64_t>(m_detenteurs.size()));
+    for (size_t c = 0; c < m_detenteurs.size(); ++c) {
+        IdProcessus id = m_detenteurs[c];
+        bool occupee = m_cases.occupe(id) && m_cases[id] == c;
+        etat.push_back(occupee ? static_cast<int64_t>(id) : -1);
+    }
+    etat.push_back(static_cast<int64_t>(m_casesLibres.size()));
+    etat.insert(etat.end(), m_casesLibres.begin(), m_casesLibres.end());
+}
+
+/**
+ * @brief reprend le générateur et les cases sauvés ; les cases occupées sont exactement celles
+ * des processus prêts et de l'élu, et les cases libres sont toutes nommées une fois.
+ * \pre la file est vide
+ */
+bool TP::FileLoterie::restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>&,
+                                LecteurEtat& etat) {
+    PRECONDITION(m_detenteurs.empty() && m_elu == AUCUN_PROCESSUS);
+    // mt19937_64 s'écrit en 313 nombres au plus
+    int64_t nbMots = etat.lire(0, 1024);
+    stringstream texte;
+    for (int64_t i = 0; i < nbMots; ++i) {
+        texte << static_cast<uint64_t>(etat.lire(INT64_MIN, INT64_MAX)) << ' ';
+    }
+    if (!(texte >> m_alea)) {
+        return false;
+    }
+
+    Attendus attendus(m_table.taille(), prets, elu);
+    int64_t nbCases = etat.lire(0, static_cast<int64_t>(m_table.taille()));
+    vector<bool> libres;
+    for (int64_t c = 0; c < nbCases && etat.valide(); ++c) {
+        int64_t detenteur = etat.lire(-1, dernierId(m_table));
+        libres.push_back(detenteur == -1);
+        if (detenteur == -1) {
+            m_detenteurs.push_back(AUCUN_PROCESSUS);
+            continue;
+        }
+        IdProcessus id = static_cast<IdProcessus>(detenteur);
+        if (!attendus.prendre(id)) {
+            return false;
+        }
+        m_detenteurs.push_back(id);
+        m_cases.occuper(id) = static_cast<uint32_t>(c);
+        m_billets.modifier(static_cast<size_t>(c), id == elu ? 0 : poidsPriorite(m_table.priorite(id)));
+        m_parts.entrer(m_table.priorite(id));
+    }
+    int64_t nbLibres = etat.lire(0, nbCases);
+    for (int64_t i = 0; i < nbLibres && etat.valide(); ++i) {
+        size_t c = static_cast<size_t>(etat.lire(0, nbCases - 1));
+        if (!libres[c]) {
+            return false;
+        }
+        libres[c] = false;
+        m_casesLibres.push_back(static_cast<uint32_t>(c));
+    }
+    m_elu = elu;
+    return attendus.tousPris() && none_of(libres.begin(), libres.end(), [](bool libre) { return libre; });
+}
+
+// FileStride
+
+/**
+ * @brief Constructeur de la file par pas.
+ * @param table processus simulés.
+ * @param quantum durée de la tranche de chaque élu.
+ * @param capacite nombre de processus prévus.
+ * \pre quantum > 0
+ */
+TP::FileStride::FileStride(const TableProcessus& table, int quantum, size_t capacite)
+    : m_table(table), m_quantum(quantum), m_tas(capaciteDe(table, capacite)), m_avanceeGlobale(0), m_compteur(0),
+      m_elu(AUCUN_PROCESSUS), m_restantElection(0) {
+    PRECONDITION(quantum > 0);
+}
+
+/**
+ * @brief rend le processus prêt : un nouveau processus part de l'avancée globale ; le processus
+ * élu qui revient avance de son pas par unité de temps exécutée.
+ * @param id identifiant du processus devenu prêt.
+ */
+void TP::FileStride::ajouter(IdProcessus id) {
+    if (id == m_elu) {
+        m_elu = AUCUN_PROCESSUS;
+        m_avancees[id] += pas(id) * (m_restantElection - m_table.restant(id));
+    } else {
+        m_avancees.occuper(id) = m_avanceeGlobale;
+        m_parts.entrer(m_table.priorite(id));
+    }
+    m_tas.inserer(id, {m_avancees[id], m_compteur++});
+}
+
+TP::IdProcessus TP::FileStride::extraire() {
+    PRECONDITION(!estVide());
+    PRECONDITION(m_elu == AUCUN_PROCESSUS);
+    m_elu = static_cast<IdProcessus>(m_tas.extraire());
+    m_avanceeGlobale = m_avancees[m_elu];
+    m_restantElection = m_table.restant(m_elu);
+    m_parts.elire(m_table.priorite(m_elu), min(m_quantum, m_restantElection - m_table.finRafale(m_elu)));
+    return m_elu;
+}
+
+void TP::FileStride::terminer(IdProcessus id) {
+    PRECONDITION(id == m_elu);
+    m_avancees.liberer(id);
+    m_parts.sortir(m_table.priorite(id));
+    m_elu = AUCUN_PROCESSUS;
+}
+
+// cède le processus prêt le moins avancé
+TP::IdProcessus TP::FileStride::ceder() {
+    if (estVide()) {
+        return AUCUN_PROCESSUS;
+    }
+    IdProcessus id = static_cast<IdProcessus>(m_tas.extraire());
+    m_avancees.liberer(id);
+    m_parts.sortir(m_table.priorite(id));
+    return id;
+}
+
+// le tas des processus prêts avec leurs clés, puis l'avancée de l'élu
+void TP::FileStride::sauver(vector<int64_t>& etat) const {
+    etat.insert(etat.end(), {m_avanceeGlobale, static_cast<int64_t>(m_compteur), m_restantElection,
+                             static_cast<int64_t>(m_tas.taille())});
+    m_tas.parcourir([&etat](size_t id, const Cle& cle) {
+        etat.insert(etat.end(), {static_cast<int64_t>(id), cle.first, static_cast<int64_t>(cle.second)});
+    });
+    if (m_elu != AUCUN_PROCESSUS) {
+        etat.push_back(m_avancees[m_elu]);
+    }
+}
+
+/**
+ * @brief reprend le tas sauvé, qui contient exactement les processus prêts, et l'avancée de l'élu.
+ * \pre la file est vide
+ */
+bool TP::FileStride::restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>&,
+                               LecteurEtat& etat) {
+    PRECONDITION(estVide() && m_elu == AUCUN_PROCESSUS);
+    m_avanceeGlobale = etat.lire(INT64_MIN, INT64_MAX);
+    m_compteur = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+    m_restantElection = static_cast<int>(etat.lire(0, INT32_MAX));
+    Attendus attendus(m_table.taille(), prets);
+    int64_t nb = etat.lire(0, static_cast<int64_t>(prets.size()));
+    for (int64_t i = 0; i < nb && etat.valide(); ++i) {
+        IdProcessus id = static_cast<IdProcessus>(etat.lire(0, dernierId(m_table)));
+        Cle cle;
+        cle.first = etat.lire(INT64_MIN, INT64_MAX);
+        cle.second = static_cast<uint64_t>(etat.lire(0, INT64_MAX));
+        if (!attendus.prendre(id)) {
+            return false;
+        }
+        m_tas.inserer(id, cle);
+        m_avancees.occuper(id) = cle.first;
+        m_parts.entrer(m_table.priorite(id));
+    }
+    if (elu != AUCUN_PROCESSUS) {
+        m_avancees.occuper(elu) = etat.lire(INT64_MIN, INT64_MAX);
+        m_parts.entrer(m_table.priorite(elu));
+    }
+    m_elu = elu;
+    return attendus.tousPris();
+}
+
+// fabrique
+
+/**
+ * @brief crée la file prête de la politique nommée.
+ * @param nom nom de la politique.
+ * @param table processus simulés ; ses pids sont classés si la politique en a besoin.
+ * @param quantum quantum du tourniquet, ignoré par les politiques qui n'en ont pas.
+ * @param capacite nombre de processus prêts prévus, CAPACITE_TABLE pour toute la table.
+ * @return file prête, ou nullptr si le nom est inconnu.
+ */
+unique_ptr<TP::FilePrete> TP::creerPolitique(const string& nom, TableProcessus& table, int quantum,
+                                             size_t capacite) {
+    unique_ptr<FilePrete> file;
+    avecPolitique(nom, table, quantum, [&file](auto& concrete) {
+        file = make_unique<decay_t<decltype(concrete)>>(std::move(concrete));
+    }, capacite);
+    return file;
+}
+
+const vector<string>& TP::nomsPolitiques() {
+    static const vector<string> NOMS = {"fcfs", "sjf", "srtf", "rr", "priorite", "priorite_preemptive",
+                                        "edf", "edf_preemptive", "multiniveaux", "mlfq", "cfs", "loterie", "stride"};
+    return NOMS;
+}
+
+bool TP::utiliseQuantum(const string& nom) {
+    return nom == "rr" || nom == "multiniveaux" || nom == "mlfq" || nom == "cfs" || nom == "loterie"
+           || nom == "stride";
+}
+
+// le quantum d'une politique qui n'en a pas est ignoré
+bool TP::prolonge(const string& nom, int quantum, const Instantane& instantane) {
+    return nom == instantane.politique && (utiliseQuantum(nom) ? quantum : 0) == instantane.quantum;
+}
@@ -0,0 +1,622 @@
+#include "Moteur.h"
+#include "FileCirculaire.h"
+#include "TasIndexe.h"
+#include "ArbreFenwick.h"
+#include "EtatsParPages.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// Politiques.h
+#ifndef POLITIQUES_H
+#define POLITIQUES_H
+
+namespace TP {
+
+    // capacité par défaut d'une file prête : une place par processus de la table
+    constexpr size_t CAPACITE_TABLE = SIZE_MAX;
+
+    // Premier Arrivé, Premier Servi ; avec un quantum, c'est le tourniquet (Round Robin)
+    class FileFifo final : public FilePrete {
+    public:
+        explicit FileFifo(size_t capacite, int quantum = 0);
+
+        void ajouter(IdProcessus id) override { m_file.ajouter(id); }
+        IdProcessus extraire() override { return m_file.extraire(); }
+        bool estVide() const override { return m_file.estVide(); }
+        int quantum(IdProcessus) const override { return m_quantum; }
+
+    private:
+        FileCirculaire<IdProcessus> m_file; // identifiants compacts, aucune allocation après la construction
+        int m_quantum;
+    };
+
+    // Plus Court d'abord : la plus petite durée, puis le plus petit pid
+    class FileCourtDabord final : public FilePrete {
+    public:
+        explicit FileCourtDabord(const TableProcessus& table, size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override;
+
+    private:
+        // clé du tas : durée, puis rang de départage donné par la table
+        struct Cle {
+            int duree;
+            uint64_t rangPid;
+            IdProcessus id;
+
+            bool operator>(const Cle& autre) const {
+                if (duree != autre.duree) {
+                    return duree > autre.duree;
+                }
+                return rangPid > autre.rangPid;
+            }
+        };
+
+        const TableProcessus& m_table;
+        priority_queue<Cle, vector<Cle>, greater<Cle>> m_tas;
+    };
+
+    // priorité décroissante, l'ordre d'entrée dans la file départage les égalités
+    class FilePriorite final : public FilePrete {
+    public:
+        explicit FilePriorite(const TableProcessus& table);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override;
+
+    private:
+        // clé du tas : priorité décroissante, puis rang d'entrée croissant
+        struct Cle {
+            int priorite;
+            uint64_t rangEntree;
+            IdProcessus id;
+
+            bool operator>(const Cle& autre) const {
+                if (priorite != autre.priorite) {
+                    return priorite < autre.priorite;
+                }
+                return rangEntree > autre.rangEntree;
+            }
+        };
+
+        const TableProcessus& m_table;
+        priority_queue<Cle, vector<Cle>, greater<Cle>> m_tas;
+        uint64_t m_nbEntrees; // rang d'entrée du prochain processus ajouté
+    };
+
+    /**
+     * @brief base des politiques préemptives : les processus prêts et le processus élu
+     * restent dans un tas indexé.
+     *
+     * lorsqu'un processus élu revient dans la file (préemption ou fin de quantum), sa clé est
+     * mise à jour en O(log n) au lieu d'un retrait suivi d'une insertion.
+     */
+    class FileIndexee : public FilePrete {
+    public:
+        explicit FileIndexee(const TableProcessus& table, size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override;
+        bool preempte(IdProcessus courant, IdProcessus arrivant) const override;
+        void terminer(IdProcessus id) override;
+        IdProcessus ceder() override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+    protected:
+        // clé primaire comparée pour la préemption, clé secondaire pour départager ; la clé primaire
+        // est sur 64 bits pour les échéances absolues (arrivée + délai)
+        using Cle = pair<int64_t, uint64_t>;
+
+        virtual Cle cle(IdProcessus id) const = 0;
+
+        // clé gardée dans le tas, nullptr si le processus n'y est pas
+        const Cle* cleRangee(IdProcessus id) const { return m_tas.contient(id) ? &m_tas.cle(id) : nullptr; }
+
+        const TableProcessus& m_table;
+
+    private:
+        TasIndexe<Cle> m_tas;
+        IdProcessus m_elu; // processus élu gardé dans le tas, AUCUN_PROCESSUS si le processeur est libre
+    };
+
+    // Plus Court Temps Restant d'abord (SRTF), préemptif ; seul compte le reste de la rafale processeur en cours
+    class FileRestantCourt final : public FileIndexee {
+    public:
+        explicit FileRestantCourt(const TableProcessus& table, size_t capacite = CAPACITE_TABLE);
+
+    protected:
+        Cle cle(IdProcessus id) const override;
+    };
+
+    /**
+     * priorité décroissante, préemptive ; l'ordre d'entrée dans la file départage les égalités.
+     * Ce rang est gardé dans la clé du tas tant que le processus y reste, préemptions comprises.
+     */
+    class FilePrioritePreemptive final : public FileIndexee {
+    public:
+        explicit FilePrioritePreemptive(const TableProcessus& table, size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+    protected:
+        Cle cle(IdProcessus id) const override;
+
+    private:
+        uint64_t m_compteur; // rang du prochain processus qui entre dans la file
+    };
+
+    /**
+     * @brief Échéance la Plus Proche d'abord (EDF) : l'échéance absolue la plus petite est élue,
+     * les processus sans échéance passent après tous les autres, dans leur ordre d'entrée.
+     *
+     * préemptive, un processus qui arrive avec une échéance plus proche que celle du processus élu
+     * le préempte ; sinon, le processus élu va jusqu'à sa fin. L'ordre d'entrée dans la file
+     * départage les égalités, comme pour FilePrioritePreemptive.
+     */
+    class FileEcheance final : public FileIndexee {
+    public:
+        FileEcheance(const TableProcessus& table, bool preemptive, size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        bool preempte(IdProcessus courant, IdProcessus arrivant) const override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+    protected:
+        Cle cle(IdProcessus id) const override;
+
+    private:
+        bool m_preemptive;
+        uint64_t m_compteur; // rang du prochain processus qui entre dans la file
+    };
+
+    // files multiniveaux : SYSTEME, puis INTERACTIF en tourniquet, puis BATCH, puis UTILISATEUR
+    class FileMultiniveaux final : public FilePrete {
+    public:
+        FileMultiniveaux(const TableProcessus& table, int quantum, size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override;
+        int quantum(IdProcessus id) const override;
+
+    private:
+        const TableProcessus& m_table;
+        FilePriorite m_systeme;
+        FileFifo m_interactif;
+        FilePriorite m_batch;
+        FilePriorite m_utilisateur;
+    };
+
+    /**
+     * @brief files multiniveaux à rétroaction (MLFQ) : un processus entre au niveau de son type
+     * (SYSTEME au niveau 0, puis INTERACTIF, BATCH et UTILISATEUR), descend d'un niveau chaque
+     * fois qu'il épuise le quantum du sien, et remonte à son niveau de départ à chaque
+     * rehaussement périodique.
+     *
+     * chaque niveau a son quantum, par défaut le double du précédent ; le dernier niveau est un
+     * tourniquet. Un processus
+     * qui arrive préempte le processus élu s'il entre à un niveau plus prioritaire ; le processus
+     * préempté garde son niveau et le reste de son quantum. Chaque niveau est une file FIFO et un
+     * bit par niveau non vide (comme l'ordonnanceur O(1) de Linux) donne le prochain niveau à
+     * servir en une instruction : ajouter et extraire sont en O(1) quel que soit le nombre de
+     * niveaux ou de processus. Le rehaussement est en O(n) sur les processus prêts.
+     *
+     * un processus qui part en E/S garde son niveau et ce qu'il a consommé du quantum : rendre le
+     * processeur juste avant la fin du quantum ne suffit pas à rester dans un niveau prioritaire.
+     * S'il y a eu un rehaussement pendant son E/S, il revient à son niveau de départ.
+     *
+     * l'état de chaque processus n'est gardé que tant qu'il est prêt, élu ou en E/S (voir
+     * EtatsParPages) : avec une file par processeur, chacune ne garde que ses propres processus.
+     */
+    class FileRetroaction final : public FilePrete {
+    public:
+        static constexpr size_t NB_NIVEAUX_MAX = 64; // un bit par niveau
+        static constexpr size_t NB_NIVEAUX_DEFAUT = 8;
+
+        // NB_NIVEAUX_DEFAUT niveaux de quanta doublés à partir de quantum, rehaussés tous les deux
+        // quanta du dernier niveau ; \pre quantum > 0
+        FileRetroaction(const TableProcessus& table, int quantum, size_t capacite = CAPACITE_TABLE);
+
+        /**
+         * quanta : quantum de chaque niveau, du plus prioritaire au dernier ; periode : intervalle des
+         * rehaussements, 0 pour n'en faire aucun.
+         * \pre 1 <= quanta.size() <= NB_NIVEAUX_MAX et chaque quantum > 0
+         * \pre periode >= 0
+         */
+        FileRetroaction(const TableProcessus& table, vector<int> quanta, int periode,
+                        size_t capacite = CAPACITE_TABLE);
+
+        // quanta doublés d'un niveau au suivant à partir de quantum, sans dépasser INT32_MAX / 2
+        static vector<int> quantaDoubles(int quantum, size_t nbNiveaux);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override { return m_nonVides == 0; }
+        int quantum(IdProcessus id) const override;
+        bool preempte(IdProcessus courant, IdProcessus arrivant) const override;
+        void terminer(IdProcessus id) override;
+        void bloquer(IdProcessus id) override;
+        void oublier(IdProcessus id) override;
+        IdProcessus ceder() override;
+        int periodeRehaussement() const override { return m_periode; }
+        void rehausser() override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+        // niveau actuel d'un processus prêt ou élu
+        size_t niveau(IdProcessus id) const { return m_etats[id].niveau; }
+        size_t nbNiveaux() const { return m_niveaux.size(); }
+
+    private:
+        static constexpr uint8_t ABSENT = UINT8_MAX;
+
+        // état d'un processus connu de la file
+        struct Etat {
+            int restantAuNiveau;    // temps restant à son entrée dans le niveau
+            uint8_t niveau;         // ABSENT si le processus n'est ni prêt ni élu
+            bool bloque;            // en E/S
+            uint32_t rehaussement;  // numéro du dernier rehaussement au début de l'E/S
+        };
+
+        size_t niveauDeDepart(IdProcessus id) const {
+            return min<size_t>(m_table.type(id), m_niveaux.size() - 1);
+        }
+        void placer(IdProcessus id, size_t niveau);
+
+        const TableProcessus& m_table;
+        vector<int> m_quanta;       // quantum de chaque niveau
+        int m_periode;
+        vector<FileCirculaire<IdProcessus>> m_niveaux;
+        uint64_t m_nonVides;        // bit n levé si le niveau n a un processus prêt
+        EtatsParPages<Etat> m_etats; // processus prêts, élu et en E/S
+        IdProcessus m_elu;          // AUCUN_PROCESSUS si le processeur est libre
+        uint32_t m_nbRehaussements;
+    };
+
+    /**
+     * @brief poids d'un processus pour les politiques à partage proportionnel (cfs, loterie,
+     * stride) : la priorité est lue comme l'opposé d'un nice, la priorité 0 pèse 1024 et chaque
+     * cran de plus donne environ 25 % de processeur en plus (table des poids de Linux).
+     */
+    int poidsPriorite(int priorite);
+
+    /**
+     * @brief ordonnancement équitable à la manière de CFS (Linux) : chaque processus accumule un
+     * temps virtuel, son temps d'exécution divisé par son poids, et le processus prêt de plus petit
+     * temps virtuel est élu.
+     *
+     * le poids vient de la priorité (voir poidsPriorite). Les processus prêts sont rangés dans un
+     * arbre équilibré (std::set) ordonné par temps virtuel : l'élection prend le plus à gauche, et
+     * ranger un processus coûte O(log n).
+     *
+     * la tranche d'un processus est sa part, au prorata des poids, d'une période qui vaut la
+     * latence cible, ou granulariteMin fois le nombre de processus si c'est plus ; elle n'est jamais
+     * plus courte que granulariteMin. Un processus qui arrive part du plus petit temps virtuel de la
+     * file et préempte le processus élu si celui-ci a plus de granulariteMin d'avance sur lui.
+     *
+     * un processus qui revient d'une E/S garde son temps virtuel, relevé au besoin à une
+     * demi-latence cible sous le plus petit : il est servi vite sans rattraper tout le temps passé
+     * bloqué (le crédit des processus endormis de Linux).
+     *
+     * comme pour FileRetroaction, l'état de chaque processus n'est gardé que tant qu'il est prêt,
+     * élu ou en E/S.
+     */
+    class FileEquitable final : public FilePrete {
+    public:
+        // rapport entre latence cible et granularité minimale retenu par avecPolitique, celui de Linux
+        static constexpr int LATENCE_PAR_GRANULARITE = 8;
+
+        /**
+         * \pre granulariteMin > 0
+         * \pre latenceCible >= granulariteMin
+         */
+        FileEquitable(const TableProcessus& table, int granulariteMin, int latenceCible,
+                      size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override { return m_arbre.empty(); }
+        int quantum(IdProcessus id) const override;
+        bool preempte(IdProcessus courant, IdProcessus arrivant) const override;
+        void terminer(IdProcessus id) override;
+        void bloquer(IdProcessus id) override;
+        void oublier(IdProcessus id) override;
+        IdProcessus ceder() override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+        // temps virtuel d'un processus prêt, ou du processus élu à sa dernière élection, en
+        // 1/2^DECALAGE d'unité de temps d'un processus de poids 1024
+        int64_t tempsVirtuel(IdProcessus id) const { return m_etats[id].tempsVirtuel; }
+        int64_t tempsVirtuelMin() const { return m_tempsVirtuelMin; }
+
+        static constexpr int DECALAGE = 16;
+
+    private:
+        static constexpr int POIDS_NICE_0 = 1024;
+
+        struct Cle {
+            int64_t tempsVirtuel;
+            uint64_t ordre;         // ordre d'insertion, départage les égalités
+            IdProcessus id;
+
+            bool operator<(const Cle& autre) const {
+                if (tempsVirtuel != autre.tempsVirtuel) {
+                    return tempsVirtuel < autre.tempsVirtuel;
+                }
+                return ordre < autre.ordre;
+            }
+        };
+
+        struct Etat {
+            int64_t tempsVirtuel;
+            bool present;           // prêt ou élu
+            bool bloque;            // en E/S, son temps virtuel est gardé
+        };
+
+        // temps virtuel correspondant à une durée d'exécution pour ce poids
+        static int64_t virtuel(int64_t duree, int poids) {
+            return (duree * POIDS_NICE_0 << DECALAGE) / poids;
+        }
+        int poidsDe(IdProcessus id) const { return poidsPriorite(m_table.priorite(id)); }
+        void ranger(IdProcessus id);
+
+        const TableProcessus& m_table;
+        int m_granulariteMin;
+        int m_latenceCible;
+        set<Cle> m_arbre;           // processus prêts ; le processus élu n'y est pas
+        EtatsParPages<Etat> m_etats; // processus prêts, élu et en E/S
+        int64_t m_tempsVirtuelMin;  // ne décroît jamais
+        int64_t m_poidsTotal;       // poids des processus prêts et du processus élu
+        uint64_t m_compteur;
+        IdProcessus m_elu;          // AUCUN_PROCESSUS si le processeur est libre
+        int m_restantElection;      // temps restant du processus élu à son élection
+    };
+
+    /**
+     * @brief part du processeur reçue par chaque priorité, comparée à la part attendue d'un
+     * partage proportionnel.
+     *
+     * à chaque élection, la tranche attribuée est répartie entre les priorités au prorata des
+     * poids de leurs processus présents (prêts ou élu) : c'est la part attendue. La part reçue est
+     * la tranche elle-même, comptée à la priorité du processus élu.
+     */
+    class PartsParPriorite {
+    public:
+        struct Part {
+            int64_t poidsPresent = 0;   // poids des processus présents de cette priorité
+            double attendue = 0.0;      // temps processeur attendu
+            int64_t recue = 0;          // temps processeur reçu
+            uint64_t nbElections = 0;
+        };
+
+        void entrer(int priorite) { m_parts[priorite].poidsPresent += poidsPriorite(priorite); }
+        void sortir(int priorite) { m_parts[priorite].poidsPresent -= poidsPriorite(priorite); }
+        void elire(int priorite, int tranche);
+
+        // parts de chaque priorité rencontrée, par priorité croissante
+        const map<int, Part>& parts() const { return m_parts; }
+
+    private:
+        map<int, Part> m_parts;
+    };
+
+    /**
+     * @brief ordonnancement par loterie : chaque processus prêt détient autant de billets que son
+     * poids (voir poidsPriorite) et chaque élection tire un billet au hasard.
+     *
+     * les billets sont rangés dans un arbre de Fenwick, une case par processus prêt ou élu, reprise
+     * à son départ : un tirage et une modification coûtent O(log n), et la taille de l'arbre suit le
+     * nombre de processus présents plutôt que celui de la table. Les tirages n'utilisent que
+     * mt19937_64 et un rejet explicite, une même graine donne donc les mêmes élections sur toute
+     * plateforme ; un instantané garde l'état du générateur. Chaque élu reçoit un quantum ; les
+     * billets de compensation ne sont pas utiles, un processus ne rendant le processeur avant la
+     * fin de son quantum que lorsqu'il termine.
+     */
+    class FileLoterie final : public FilePrete {
+    public:
+        static constexpr uint64_t GRAINE_DEFAUT = 1;
+
+        // \pre quantum > 0
+        FileLoterie(const TableProcessus& table, int quantum, uint64_t graine = GRAINE_DEFAUT,
+                    size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override { return m_billets.total() == 0; }
+        int quantum(IdProcessus) const override { return m_quantum; }
+        void terminer(IdProcessus id) override;
+        IdProcessus ceder() override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+        const PartsParPriorite& parts() const { return m_parts; }
+
+    private:
+        IdProcessus tirer();
+        void rendreCase(IdProcessus id);
+
+        const TableProcessus& m_table;
+        int m_quantum;
+        mt19937_64 m_alea;
+        ArbreFenwick m_billets;     // billets de chaque case, 0 pour les cases libres et celle de l'élu
+        EtatsParPages<uint32_t> m_cases; // case de chaque processus prêt ou élu
+        vector<IdProcessus> m_detenteurs; // processus de chaque case
+        vector<uint32_t> m_casesLibres;
+        IdProcessus m_elu;          // AUCUN_PROCESSUS si le processeur est libre
+        PartsParPriorite m_parts;
+    };
+
+    /**
+     * @brief ordonnancement par pas (stride scheduling) : chaque processus avance d'un pas
+     * inversement proportionnel à son poids par unité de temps exécutée, et le processus prêt le
+     * moins avancé est élu.
+     *
+     * c'est le pendant déterministe de la loterie : entre processus présents ensemble, l'écart
+     * entre part reçue et part attendue reste borné par un quantum par processus. Les avancées
+     * sont gardées dans un tas indexé ; un processus qui arrive part de l'avancée du dernier élu.
+     */
+    class FileStride final : public FilePrete {
+    public:
+        // avancée d'un processus de poids 1 pour une unité de temps
+        static constexpr int64_t PAS_UNITE = int64_t(1) << 28;
+
+        // \pre quantum > 0
+        FileStride(const TableProcessus& table, int quantum, size_t capacite = CAPACITE_TABLE);
+
+        void ajouter(IdProcessus id) override;
+        IdProcessus extraire() override;
+        bool estVide() const override { return m_tas.taille() == 0; }
+        int quantum(IdProcessus) const override { return m_quantum; }
+        void terminer(IdProcessus id) override;
+        IdProcessus ceder() override;
+        void sauver(vector<int64_t>& etat) const override;
+        bool restaurer(const vector<IdProcessus>& prets, IdProcessus elu, const vector<IdProcessus>& bloques,
+                       LecteurEtat& etat) override;
+
+        const PartsParPriorite& parts() const { return m_parts; }
+
+    private:
+        // avancée, puis ordre d'entrée dans le tas pour départager les égalités
+        using Cle = pair<int64_t, uint64_t>;
+
+        int64_t pas(IdProcessus id) const { return PAS_UNITE / poidsPriorite(m_table.priorite(id)); }
+
+        const TableProcessus& m_table;
+        int m_quantum;
+        TasIndexe<Cle> m_tas;
+        EtatsParPages<int64_t> m_avancees; // processus prêts et élu
+        int64_t m_avanceeGlobale;   // avancée du dernier élu, ne décroît jamais
+        uint64_t m_compteur;
+        IdProcessus m_elu;
+        int m_restantElection;
+        PartsParPriorite m_parts;
+    };
+
+    // vrai si la politique nommée a besoin d'un quantum positif
+    bool utiliseQuantum(const string& nom);
+
+    // vrai si une branche de cette politique et de ce quantum prolonge exactement la simulation qui
+    // a pris l'instantané (voir MoteurGenerique::reprendre)
+    bool prolonge(const string& nom, int quantum, const Instantane& instantane);
+
+    /**
+     * @brief construit la file concrète de la politique nommée et la passe à action(file).
+     *
+     * action est appelée avec le type exact de la file : un code générique, par exemple
+     * MoteurGenerique<decltype(file)>, est ainsi instancié et optimisé pour chaque politique.
+     * Les pids de la table sont classés si la politique en a besoin pour départager les égalités.
+     * @return false si le nom est inconnu.
+     * pour "cfs", le quantum est la granularité minimale, et la latence cible en vaut
+     * LATENCE_PAR_GRANULARITE fois.
+     * \pre quantum > 0 si utiliseQuantum(nom)
+     */
+    template<typename Action>
+    bool avecPolitique(const string& nom, TableProcessus& table, int quantum, Action&& action,
+                       size_t capacite = CAPACITE_TABLE) {
+        if ((nom == "sjf" || nom == "srtf") && !table.rangsDisponibles()) {
+            table.classerPids();
+        }
+        if (capacite == CAPACITE_TABLE) {
+            capacite = table.taille();
+        }
+
+        if (nom == "fcfs") {
+            FileFifo file(capacite);
+            action(file);
+        } else if (nom == "sjf") {
+            FileCourtDabord file(table, capacite);
+            action(file);
+        } else if (nom == "srtf") {
+            FileRestantCourt file(table, capacite);
+            action(file);
+        } else if (nom == "rr") {
+            PRECONDITION(quantum > 0);
+            FileFifo file(capacite, quantum);
+            action(file);
+        } else if (nom == "priorite") {
+            FilePriorite file(table);
+            action(file);
+        } else if (nom == "priorite_preemptive") {
+            FilePrioritePreemptive file(table, capacite);
+            action(file);
+        } else if (nom == "edf" || nom == "edf_preemptive") {
+            FileEcheance file(table, nom == "edf_preemptive", capacite);
+            action(file);
+        } else if (nom == "multiniveaux") {
+            FileMultiniveaux file(table, quantum, capacite);
+            action(file);
+        } else if (nom == "mlfq") {
+            FileRetroaction file(table, quantum, capacite);
+            action(file);
+        } else if (nom == "cfs") {
+            PRECONDITION(quantum > 0);
+            int64_t latence = int64_t(quantum) * FileEquitable::LATENCE_PAR_GRANULARITE;
+            FileEquitable file(table, quantum, static_cast<int>(min<int64_t>(latence, INT32_MAX)), capacite);
+            action(file);
+        } else if (nom == "loterie") {
+            FileLoterie file(table, quantum, FileLoterie::GRAINE_DEFAUT, capacite);
+            action(file);
+        } else if (nom == "stride") {
+            FileStride file(table, quantum, capacite);
+            action(file);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief crée la file prête d'une politique désignée par son nom : "fcfs", "sjf", "srtf", "rr",
+     * "priorite", "priorite_preemptive", "edf", "edf_preemptive", "multiniveaux", "mlfq", "cfs",
+     * "loterie" ou "stride".
+     *
+     * classe les pids de la table si la politique en a besoin pour départager les égalités.
+     * capacite ne fait que réserver la place : la file grandit au besoin.
+     * @return nullptr si le nom est inconnu.
+     * \pre quantum > 0 si utiliseQuantum(nom)
+     */
+    unique_ptr<FilePrete> creerPolitique(const string& nom, TableProcessus& table, int quantum,
+                                         size_t capacite = CAPACITE_TABLE);
+
+    // noms acceptés par creerPolitique et avecPolitique
+    const vector<string>& nomsPolitiques();
+
+    // boucles de simulation spécialisées pour chaque file concrète, instanciées dans Moteur.cpp
+    extern template class MoteurGenerique<FileFifo>;
+    extern template class MoteurGenerique<FileCourtDabord>;
+    extern template class MoteurGenerique<FilePriorite>;
+    extern template class MoteurGenerique<FileRestantCourt>;
+    extern template class MoteurGenerique<FilePrioritePreemptive>;
+    extern template class MoteurGenerique<FileEcheance>;
+    extern template class MoteurGenerique<FileMultiniveaux>;
+    extern template class MoteurGenerique<FileRetroaction>;
+    extern template class MoteurGenerique<FileEquitable>;
+    extern template class MoteurGenerique<FileLoterie>;
+    extern template class MoteurGenerique<FileStride>;
+
+} // namespace TP
+
+#endif // POLITIQUES_H
@@ -0,0 +1,166 @@
+#include "PoolFils.h"
+#include "ContratException.h"
+#include <algorithm>
+#include "ContratModule.h"
+
+namespace {
+
+    // pool et file du fil courant, pour que soumettre() dépose la tâche au bon endroit
+    thread_local const TP::PoolFils* t_pool = nullptr;
+    thread_local unsigned t_indice = 0;
+
+} // namespace
+
+/**
+ * @brief Constructeur du pool.
+ * @param nbFils nombre total de fils d'un lot, fil appelant compris ; 0 pour un fil par cœur.
+ */
+TP::PoolFils::PoolFils(unsigned nbFils) {
+    if (nbFils == 0) {
+        nbFils = max(1u, thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < nbFils; ++i) {
+        m_files.push_back(make_unique<FileTaches>());
+    }
+    m_fils.reserve(nbFils - 1);
+    for (unsigned i = 1; i < nbFils; ++i) {
+        m_fils.emplace_back(&PoolFils::travailler, this, i);
+    }
+}
+
+TP::PoolFils::~PoolFils() {
+    {
+        lock_guard<mutex> verrou(m_mutex);
+        m_fin = true;
+    }
+    m_reveil.notify_all();
+    for (thread& f : m_fils) {
+        f.join();
+    }
+}
+
+/**
+ * @brief exécute un lot de tâches sur tous les fils du pool.
+ * @param n nombre de tâches initiales, réparties à tour de rôle entre les files des fils.
+ * @param tache fonction appelée avec le numéro de chaque tâche, depuis n'importe quel fil.
+ */
+void TP::PoolFils::executer(size_t n, const function<void(size_t)>& tache) {
+    PRECONDITION(t_pool != this); // pas de lot imbriqué : utiliser soumettre()
+
+    m_restantes = n;
+    for (size_t i = 0; i < n; ++i) {
+        deposer(static_cast<unsigned>(i % m_files.size()), [&tache, i] { tache(i); });
+    }
+    {
+        lock_guard<mutex> verrou(m_mutex);
+        m_erreur = nullptr;
+        m_actifs = static_cast<unsigned>(m_fils.size());
+        ++m_generation;
+    }
+    m_reveil.notify_all();
+
+    traiterLot(0);
+
+    unique_lock<mutex> verrou(m_mutex);
+    m_termine.wait(verrou, [this] { return m_actifs == 0; });
+    if (m_erreur) {
+        rethrow_exception(m_erreur);
+    }
+}
+
+/**
+ * @brief ajoute une tâche au lot en cours, dans la file du fil appelant.
+ * @param tache travail à exécuter par un fil du pool.
+ * \pre appelé depuis une tâche d'un lot de ce pool
+ */
+void TP::PoolFils::soumettre(function<void()> tache) {
+    PRECONDITION(t_pool == this);
+    ++m_restantes;
+    deposer(t_indice, std::move(tache));
+}
+
+// boucle des fils du pool : attendre un lot, le traiter, recommencer
+void TP::PoolFils::travailler(unsigned indice) {
+    unsigned generation = 0;
+    while (true) {
+        {
+            unique_lock<mutex> verrou(m_mutex);
+            m_reveil.wait(verrou, [&] { return m_fin || m_generation != generation; });
+            if (m_fin) {
+                return;
+            }
+            generation = m_generation;
+        }
+        traiterLot(indice);
+        {
+            lock_guard<mutex> verrou(m_mutex);
+            --m_actifs;
+        }
+        m_termine.notify_one();
+    }
+}
+
+// exécute des tâches, les siennes ou volées, jusqu'à ce que toutes celles du lot soient terminées ;
+// sans tâche à prendre, le fil dort jusqu'au prochain dépôt ou jusqu'à la fin du lot
+void TP::PoolFils::traiterLot(unsigned indice) {
+    t_pool = this;
+    t_indice = indice;
+    function<void()> tache;
+    while (m_restantes.load() > 0) {
+        // lu avant prendre() : un dépôt fait entre les deux change le signal et l'attente revient aussitôt
+        uint32_t signal = m_signal.load();
+        if (!prendre(indice, tache)) {
+            if (m_restantes.load() > 0) {
+                m_signal.wait(signal); // des tâches en cours peuvent encore en soumettre
+            }
+            continue;
+        }
+        try {
+            tache();
+        } catch (...) {
+            lock_guard<mutex> verrou(m_mutex);
+            if (!m_erreur) {
+                m_erreur = current_exception();
+            }
+        }
+        tache = nullptr;
+        if (--m_restantes == 0) {
+            m_signal.fetch_add(1);
+            m_signal.notify_all();
+        }
+    }
+    t_pool = nullptr;
+}
+
+// la plus récente tâche de sa file, sinon la plus ancienne d'une autre file
+bool TP::PoolFils::prendre(unsigned indice, function<void()>& tache) {
+    {
+        FileTaches& file = *m_files[indice];
+        lock_guard<mutex> verrou(file.verrou);
+        if (!file.taches.empty()) {
+            tache = std::move(file.taches.back());
+            file.taches.pop_back();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < m_files.size(); ++k) {
+        FileTaches& victime = *m_files[(indice + k) % m_files.size()];
+        lock_guard<mutex> verrou(victime.verrou);
+        if (!victime.taches.empty()) {
+            tache = std::move(victime.taches.front());
+            victime.taches.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TP::PoolFils::deposer(unsigned indice, function<void()> tache) {
+    {
+        FileTaches& file = *m_files[indice];
+        lock_guard<mutex> verrou(file.verrou);
+        file.taches.push_back(std::move(tache));
+    }
+    m_signal.fetch_add(1);
+    m_signal.notify_all();
+}
@@ -0,0 +1,76 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// PoolFils.h
+#ifndef POOLFILS_H
+#define POOLFILS_H
+
+namespace TP {
+
+    /**
+     * @brief groupe de fils d'exécution créés une fois et réutilisés d'un lot de tâches à l'autre,
+     * avec vol de travail.
+     *
+     * chaque fil a sa propre file de tâches : il prend la plus récente de la sienne et, quand elle
+     * est vide, vole la plus ancienne d'un autre fil. Une tâche peut en soumettre d'autres au lot
+     * en cours (par exemple, une tâche qui charge une trace soumet une simulation par politique) ;
+     * elles restent près du fil qui les a créées tant qu'aucun autre fil n'est inoccupé.
+     */
+    class PoolFils {
+    public:
+        // nbFils = 0 : un fil par cœur de la machine
+        explicit PoolFils(unsigned nbFils = 0);
+        ~PoolFils();
+
+        PoolFils(const PoolFils&) = delete;
+        PoolFils& operator=(const PoolFils&) = delete;
+
+        // nombre de fils qui exécutent un lot, fil appelant compris
+        unsigned nbFils() const { return static_cast<unsigned>(m_files.size()); }
+
+        // exécute tache(i) pour i de 0 à n - 1, et les tâches qu'elles soumettent, puis attend
+        // la fin du lot ; la première exception levée par une tâche est relancée dans le fil appelant
+        void executer(size_t n, const function<void(size_t)>& tache);
+
+        // ajoute une tâche au lot en cours ; à appeler depuis une tâche de ce lot
+        void soumettre(function<void()> tache);
+
+    private:
+        // file de tâches d'un fil ; les tâches sont longues, un verrou par file suffit
+        struct FileTaches {
+            mutex verrou;
+            deque<function<void()>> taches;
+        };
+
+        void travailler(unsigned indice);
+        void traiterLot(unsigned indice);
+        bool prendre(unsigned indice, function<void()>& tache);
+        void deposer(unsigned indice, function<void()> tache);
+
+        vector<unique_ptr<FileTaches>> m_files; // une par fil, la 0 pour le fil appelant
+        vector<thread> m_fils;
+        mutex m_mutex;
+        condition_variable m_reveil;     // un nouveau lot est disponible, ou fin du pool
+        condition_variable m_termine;    // le dernier fil a quitté le lot
+        atomic<size_t> m_restantes{0};   // tâches du lot soumises et pas encore terminées
+        atomic<uint32_t> m_signal{0};    // change à chaque dépôt et à la fin du lot : un fil sans
+                                         // tâche à prendre l'attend au lieu de tourner à vide
+        unsigned m_generation = 0;       // numéro du lot courant
+        unsigned m_actifs = 0;           // fils encore occupés par le lot courant
+        exception_ptr m_erreur;
+        bool m_fin = false;
+    };
+
+} // namespace TP
+
+#endif // POOLFILS_H
@@ -0,0 +1,186 @@
+#include "ContratException.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// RoueTemporelle.h
+#ifndef ROUETEMPORELLE_H
+#define ROUETEMPORELLE_H
+
+namespace TP {
+
+    /**
+     * @brief roue temporelle hiérarchique : chaque élément (un identifiant compact) attend son
+     * échéance, et avancer le temps rend ceux qui sont échus.
+     *
+     * six niveaux de 64 cases couvrent 2^36 unités de temps. Un élément est rangé au niveau du
+     * groupe de 6 bits le plus fort où son échéance diffère du curseur, dans la case que donne ce
+     * groupe ; au niveau 0, une case est un instant exact. Quand le curseur atteint une case d'un
+     * niveau supérieur, ses éléments descendent vers un niveau plus fin. Un élément descend ainsi
+     * au plus six fois : insérer, et rendre un élément échu, coûtent O(1) amorti, sans tas ni
+     * parcours des éléments en attente. Un masque de 64 bits par niveau trouve les cases occupées.
+     *
+     * les listes des cases sont chaînées par identifiant dans des tableaux : aucune allocation
+     * une fois les tableaux à la taille du plus grand identifiant.
+     */
+    class RoueTemporelle {
+    public:
+        static constexpr unsigned BITS = 6;
+        static constexpr unsigned NIVEAUX = 6;
+        static constexpr unsigned CASES = 1u << BITS;
+        static constexpr int64_t HORIZON = int64_t(1) << (BITS * NIVEAUX);
+
+        RoueTemporelle() : m_curseur(0), m_taille(0), m_compteur(0), m_occupees{} {
+            m_tetes.fill(AUCUN);
+            m_queues.fill(AUCUN);
+        }
+
+        bool estVide() const { return m_taille == 0; }
+        size_t taille() const { return m_taille; }
+        // instant jusqu'où la roue a avancé
+        int64_t curseur() const { return m_curseur; }
+
+        /**
+         * met l'élément en attente jusqu'à l'instant donné.
+         * \pre curseur() <= instant < HORIZON
+         * \pre l'élément n'est pas déjà en attente
+         */
+        void inserer(uint32_t id, int64_t instant) {
+            PRECONDITION(instant >= m_curseur && instant < HORIZON);
+            if (id >= m_echeances.size()) {
+                size_t taille = max<size_t>(id + 1, 2 * m_echeances.size());
+                m_echeances.resize(taille);
+                m_ordres.resize(taille);
+                m_suivants.resize(taille, AUCUN);
+            }
+            m_echeances[id] = instant;
+            m_ordres[id] = m_compteur++;
+            ranger(id);
+            ++m_taille;
+        }
+
+        /**
+         * premier instant où avancer() a du travail : l'échéance la plus proche, ou plus tôt le
+         * début d'une case de niveau supérieur à faire descendre. Jamais après la prochaine
+         * échéance ; INT64_MAX si la roue est vide. O(NIVEAUX).
+         */
+        int64_t prochainInstant() const {
+            int64_t prochain = INT64_MAX;
+            for (unsigned niveau = 0; niveau < NIVEAUX; ++niveau) {
+                if (m_occupees[niveau] != 0) {
+                    unsigned decalage = BITS * niveau;
+                    int64_t base = (m_curseur >> (decalage + BITS)) << (decalage + BITS);
+                    int64_t debut = base | (int64_t(countr_zero(m_occupees[niveau])) << decalage);
+                    prochain = min(prochain, debut);
+                }
+            }
+            return prochain;
+        }
+
+        /**
+         * avance le curseur jusqu'à instant et ajoute à echus les éléments dont l'échéance est
+         * passée, par échéance puis dans l'ordre de leur insertion ; les autres éléments des
+         * cases atteintes descendent d'un niveau.
+         * \pre instant >= curseur()
+         */
+        void avancer(int64_t instant, vector<uint32_t>& echus) {
+            PRECONDITION(instant >= m_curseur);
+            size_t premier = echus.size();
+            int64_t ancien = m_curseur;
+            m_curseur = instant;
+            for (unsigned niveau = 0; niveau < NIVEAUX; ++niveau) {
+                if (m_occupees[niveau] == 0) {
+                    continue;
+                }
+                // cases dont le début est atteint : toutes si le curseur a quitté le groupe du
+                // niveau supérieur, sinon jusqu'à sa propre case
+                unsigned decalage = BITS * niveau;
+                uint64_t atteintes = ~uint64_t(0);
+                if ((ancien >> (decalage + BITS)) == (instant >> (decalage + BITS))) {
+                    unsigned c = static_cast<unsigned>(instant >> decalage) & (CASES - 1);
+                    atteintes = (c == CASES - 1) ? ~uint64_t(0) : (uint64_t(2) << c) - 1;
+                }
+                uint64_t aVider = m_occupees[niveau] & atteintes;
+                m_occupees[niveau] &= ~aVider;
+                while (aVider != 0) {
+                    size_t position = niveau * CASES + countr_zero(aVider);
+                    aVider &= aVider - 1;
+                    uint32_t id = m_tetes[position];
+                    m_tetes[position] = AUCUN;
+                    m_queues[position] = AUCUN;
+                    while (id != AUCUN) {
+                        uint32_t suivant = m_suivants[id];
+                        m_suivants[id] = AUCUN;
+                        if (m_echeances[id] <= instant) {
+                            echus.push_back(id);
+                            --m_taille;
+                        } else {
+                            ranger(id); // à un niveau plus fin, relativement au nouveau curseur
+                        }
+                        id = suivant;
+                    }
+                }
+            }
+            sort(echus.begin() + premier, echus.end(), [this](uint32_t a, uint32_t b) {
+                return m_echeances[a] != m_echeances[b] ? m_echeances[a] < m_echeances[b] : m_ordres[a] < m_ordres[b];
+            });
+        }
+
+        /**
+         * appelle f(id, echeance) pour chaque élément en attente, par échéance puis dans l'ordre
+         * de leur insertion ; O(n log n), pour un instantané et non pour la boucle de simulation.
+         */
+        template<typename Fonction>
+        void parcourir(Fonction&& f) const {
+            vector<uint32_t> attente;
+            attente.reserve(m_taille);
+            for (uint32_t tete : m_tetes) {
+                for (uint32_t id = tete; id != AUCUN; id = m_suivants[id]) {
+                    attente.push_back(id);
+                }
+            }
+            sort(attente.begin(), attente.end(), [this](uint32_t a, uint32_t b) {
+                return m_echeances[a] != m_echeances[b] ? m_echeances[a] < m_echeances[b] : m_ordres[a] < m_ordres[b];
+            });
+            for (uint32_t id : attente) {
+                f(id, m_echeances[id]);
+            }
+        }
+
+    private:
+        static constexpr uint32_t AUCUN = UINT32_MAX;
+
+        // ajoute l'élément à la fin de sa case, selon son échéance et le curseur courant
+        void ranger(uint32_t id) {
+            int64_t instant = m_echeances[id];
+            uint64_t difference = static_cast<uint64_t>(instant ^ m_curseur);
+            unsigned niveau = difference == 0 ? 0 : (static_cast<unsigned>(bit_width(difference)) - 1) / BITS;
+            size_t c = static_cast<size_t>(instant >> (BITS * niveau)) & (CASES - 1);
+            size_t position = niveau * CASES + c;
+            if (m_tetes[position] == AUCUN) {
+                m_tetes[position] = id;
+            } else {
+                m_suivants[m_queues[position]] = id;
+            }
+            m_queues[position] = id;
+            m_occupees[niveau] |= uint64_t(1) << c;
+        }
+
+        int64_t m_curseur;
+        size_t m_taille;
+        uint64_t m_compteur;                        // numéro d'insertion, pour départager les échéances égales
+        array<uint64_t, NIVEAUX> m_occupees;        // bit c du niveau n : la case c du niveau n n'est pas vide
+        array<uint32_t, NIVEAUX * CASES> m_tetes;
+        array<uint32_t, NIVEAUX * CASES> m_queues;
+        vector<int64_t> m_echeances;                // par identifiant
+        vector<uint64_t> m_ordres;
+        vector<uint32_t> m_suivants;                // chaînage des listes des cases
+    };
+
+} // namespace TP
+
+#endif // ROUETEMPORELLE_H
@@ -1,183 +1,1243 @@
 #include "processus.h"
-#include "ordonnanceur.h"
-#include <iostream>
+#include "Ordonnanceur.h"
+#include "ChargeurTrace.h"
+#include "TraceBinaire.h"
+#include "Balayage.h"
+#include "Campagne.h"
+#include "Multiprocesseur.h"
+#include "Latences.h"
+#include "Echeances.h"
+#include "Chronologie.h"
+#include "Politiques.h"
+#include "Arguments.h"
+#include <algorithm>
 #include <fstream>
-#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
 #include <queue>
+#include <sstream>
+#include <vector>
+#include <stdexcept>
 #include <filesystem>
+#include <cstdlib>
+#include "ContratModule.h"
 using namespace std;
 
+/**
+ * @brief fonction pour charger une trace texte, ou binaire, dans une table
+ *
+ * les lignes invalides sont signalées avec leur numéro et ignorées.
+ *
+ * @param fileName le nom du fichier à charger
+ * @param table la table où les processus seront ajoutés
+ *
+ * @return true si le chargement est réussi, false sinon
+ */
+bool chargerTable(const string& fileName, TP::TableProcessus& table) {
+    vector<TP::ErreurLigne> erreurs;
+
+    if (TP::estTraceBinaire(fileName)) {
+        string erreur;
+        if (!TP::chargerTraceBinaire(fileName, table, erreur)) {
+            cerr << "erreur : trace binaire " << fileName << " invalide : " << erreur << endl;
+            return false;
+        }
+    } else if (!TP::chargerTrace(fileName, table, erreurs)) {
+        // vérifier si le fichier a été ouvert avec succès
+        cerr << "erreur : impossible d'ouvrir le fichier " << fileName << "." << endl;
+        cerr << "chemin courant : " << filesystem::current_path() << endl;
+        return false;
+    }
+
+    for (const TP::ErreurLigne& erreur : erreurs) {
+        cerr << "erreur : impossible de lire la ligne " << erreur.numero << " : " << erreur.contenu << endl;
+    }
+    return true;
+}
+
 /**
  * @brief fonction pour charger les processus à partir d'un fichier
  *
- * cette fonction lit un fichier texte contenant des processus et les stocke dans une file.
+ * cette fonction lit un fichier texte, ou une trace binaire, contenant des processus et
+ * les stocke dans une table partagée par les simulations. les lignes invalides sont signalées
+ * avec leur numéro et ignorées.
  *
  * @param fileName le nom du fichier à partir duquel charger les processus
- * @param file_processus la file où les processus seront stockés
+ * @param charge la table où les processus seront stockés
+ * @param afficher vrai pour afficher les processus chargés
  *
  * @return true si le chargement est réussi, false sinon
  */
-bool chargerProcessus(const string& fileName, queue<Processus>& file_processus) {
-    ifstream fichier(fileName);
+bool chargerProcessus(const string& fileName, shared_ptr<const TP::TableProcessus>& charge, bool afficher = true) {
+    auto table = make_shared<TP::TableProcessus>();
+    if (!chargerTable(fileName, *table)) {
+        return false;
+    }
+
+    // afficher les processus chargés
+    if (afficher) {
+        cout << "chargement des processus depuis " << fileName << " :\n";
+        for (TP::IdProcessus id = 0; id < table->taille(); ++id) {
+            cout << table->pid(id) << " arrivee : " << table->arrivee(id) << " Duree : " << table->duree(id)
+                 << " temps d'attente : " << table->attente(id) << " Priorite : " << table->priorite(id)
+                 << " Type : " << (table->type(id) + 1) << "\n";
+        }
+        cout << "fin chargement\n";
+    }
+
+    charge = std::move(table);
+    return true;
+}
+
+/**
+ * @brief fonction pour convertir une trace texte en trace binaire
+ *
+ * @param entree le fichier texte à convertir
+ * @param sortie le fichier binaire à écrire
+ *
+ * @return 0 si la conversion est réussie, 1 sinon
+ */
+int convertirTrace(const string& entree, const string& sortie) {
+    TP::TableProcessus table;
+    vector<TP::ErreurLigne> erreurs;
+    if (!TP::chargerTrace(entree, table, erreurs)) {
+        cerr << "erreur : impossible d'ouvrir le fichier " << entree << "." << endl;
+        return 1;
+    }
+    for (const TP::ErreurLigne& erreur : erreurs) {
+        cerr << "erreur : impossible de lire la ligne " << erreur.numero << " : " << erreur.contenu << endl;
+    }
+    if (!TP::ecrireTraceBinaire(table, sortie)) {
+        cerr << "erreur : impossible d'ecrire le fichier " << sortie << "." << endl;
+        return 1;
+    }
+    cout << table.taille() << " processus convertis dans " << sortie << "\n";
+    return 0;
+}
+
+/**
+ * @brief fonction pour lire les coûts des commutations de contexte
+ *
+ * @param texte "commutation[,rechauffement[,refroidissement[,migration]]]" ; les coûts absents
+ * sont nuls, le refroidissement vaut 1 par défaut
+ * @param couts les coûts lus
+ *
+ * @return true si le texte est valide, tous les coûts positifs ou nuls et le refroidissement
+ * positif, false sinon
+ */
+bool lireCouts(const string& texte, TP::CoutsCommutation& couts) {
+    int* champs[] = {&couts.commutation, &couts.rechauffement, &couts.refroidissement, &couts.migration};
+    stringstream flux(texte);
+    string element;
+    size_t n = 0;
+    while (getline(flux, element, ',')) {
+        if (n == size(champs) || !TP::lireNombre(element, *champs[n], 0)) {
+            return false;
+        }
+        ++n;
+    }
+    return n > 0 && couts.refroidissement > 0;
+}
 
-    // vérifier si le fichier a été ouvert avec succès
+/**
+ * @brief fonction pour afficher le temps perdu en commutations de contexte, s'il y a des coûts
+ *
+ * @param couts les coûts des commutations de la simulation
+ * @param commutation le temps perdu en commutations
+ * @param temps le temps simulé, multiplié par le nombre de processeurs
+ */
+void afficherCommutation(const TP::CoutsCommutation& couts, int64_t commutation, int64_t temps) {
+    if (couts.estNul()) {
+        return;
+    }
+    streamsize precision = cout.precision();
+    cout << "temps perdu en commutations : " << commutation << " (" << fixed << setprecision(1)
+         << (temps > 0 ? 100.0 * commutation / temps : 0.0) << " % du temps)\n";
+    cout.unsetf(ios::floatfield);
+    cout.precision(precision);
+}
+
+/**
+ * @brief fonction pour simuler une charge et afficher le résultat
+ *
+ * affiche chaque processus au moment de sa terminaison, puis le temps d'attente moyen et les
+ * centiles des latences. La charge est partagée en lecture seule et aucun processus n'est copié.
+ *
+ * @param politique le nom de la politique d'ordonnancement
+ * @param quantum le quantum de la politique, ignoré si elle n'en utilise pas (voir TP::utiliseQuantum)
+ * @param charge les processus à ordonnancer
+ * @param couts les coûts des commutations de contexte
+ */
+void afficherResultat(const string& politique, int quantum, const shared_ptr<const TP::TableProcessus>& charge,
+                      const TP::CoutsCommutation& couts) {
+    TP::TableProcessus table = TP::TableProcessus::partager(charge);
+    TP::PuitsTexte texte(cout);
+    TP::PuitsLatences latences;
+    TP::PuitsMultiple puits({&texte, &latences});
+    int temps = 0;
+    int64_t commutation = 0;
+    TP::Ordonnanceur::simuler(politique, quantum, table, puits, temps, nullptr, couts, &commutation);
+    if (texte.nbTermines() > 0) {
+        cout << "temps d'attente moyen : " << texte.attenteMoyenne() << "\n";
+        afficherCommutation(couts, commutation, temps);
+        TP::ecrireLatences(cout, latences, false);
+    }
+}
+
+/**
+ * @brief fonction pour écrire une chronologie au format Chrome trace
+ *
+ * @param chemin le fichier JSON à écrire
+ * @param chronologie les tranches enregistrées pendant la simulation
+ * @param table la table simulée, nullptr en mode flux
+ *
+ * @return true si l'écriture est réussie, false sinon
+ */
+bool ecrireChronologie(const string& chemin, const TP::Chronologie& chronologie, const TP::TableProcessus* table) {
+    ofstream fichier(chemin);
     if (!fichier) {
-        cerr << "erreur : impossible d'ouvrir le fichier " << fileName << "." << endl;
-        cerr << "chemin courant : " << filesystem::current_path() << endl;
+        cerr << "erreur : impossible d'ecrire le fichier " << chemin << "." << endl;
         return false;
     }
+    chronologie.ecrireTraceChrome(fichier, table);
+    cerr << chronologie.taille() << " evenements dans " << chemin;
+    if (chronologie.nbPerdus() > 0) {
+        cerr << " (" << chronologie.nbPerdus() << " plus anciens ecrases)";
+    }
+    cerr << endl;
+    return static_cast<bool>(fichier);
+}
 
-    string ligne;  // variable pour lire le fichier ligne par ligne
-    while (getline(fichier, ligne)) {
-        istringstream iss(ligne);  // découper la ligne
-        string pid;
-        int arrivee, duree, restant, priorite, type;
+/**
+ * @brief fonction pour simuler une trace texte ou binaire en flux
+ *
+ * les processus terminés sont affichés au fil de la simulation ; la trace n'est jamais
+ * chargée en entier, sa taille n'est donc pas limitée par la mémoire. Si des processus ont une
+ * échéance, les échéances manquées sont résumées à la fin. La chronologie, si elle est demandée,
+ * ne garde que les derniers événements.
+ *
+ * @param politique le nom de la politique d'ordonnancement
+ * @param quantum le quantum de la politique, ignoré si elle n'en utilise pas (voir TP::utiliseQuantum)
+ * @param chemin la trace à simuler, texte ou binaire (.pssb), "-" pour une trace texte sur l'entrée
+ * standard
+ * @param sortieChronologie le fichier JSON de la chronologie, vide pour ne pas l'enregistrer
+ * @param couts les coûts des commutations de contexte
+ *
+ * @return 0 si la simulation est réussie, 1 sinon
+ */
+int simulerFlux(const string& politique, int quantum, const string& chemin, const string& sortieChronologie,
+                const TP::CoutsCommutation& couts) {
+    constexpr size_t CAPACITE_CHRONOLOGIE = size_t(1) << 20; // 16 Mo d'enregistrements
 
-        // lire et créer le processus s'il y a suffisamment de données
-        if (iss >> pid >> arrivee >> duree >> restant >> priorite >> type) {
-            auto typeEnum = static_cast<TypeProcessus>(type - 1); // conversion en type énuméré
-            file_processus.emplace(pid, arrivee, duree, priorite, typeEnum);  // création d'un nouveau processus
-        } else {
-            cerr << "erreur : impossible de lire la ligne : " << ligne << endl;
+    ifstream fichier;
+    unique_ptr<TP::SourceTraceBinaire> binaire;
+    if (chemin != "-" && TP::estTraceBinaire(chemin)) {
+        binaire = make_unique<TP::SourceTraceBinaire>(chemin, cerr);
+        if (!binaire->estOuverte()) {
+            cerr << "erreur : trace binaire " << chemin << " invalide : " << binaire->erreur() << endl;
+            return 1;
+        }
+    } else if (chemin != "-") {
+        fichier.open(chemin);
+        if (!fichier) {
+            cerr << "erreur : impossible d'ouvrir le fichier " << chemin << "." << endl;
+            return 1;
         }
     }
-    fichier.close();
+    if (quantum <= 0 && TP::utiliseQuantum(politique)) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
+    }
 
-    // afficher les processus chargés (sans toucher la file principale)
-    cout << "chargement des processus depuis " << fileName << " :\n";
-    queue<Processus> temp = file_processus;
-    while (!temp.empty()) {
-        Processus p = temp.front();
-        temp.pop();  // retirer l'élément pour lire le suivant
-        cout << p.getPid() << " arrivee : " << p.getArrivee() << " Duree : " << p.getDuree()
-             << " temps d'attente : " << p.getAttente() << " Priorite : " << p.getPriorite()
-             << " Type : " << (p.getType() + 1) << endl;
+    TP::SourceTexte sourceTexte(chemin == "-" ? cin : fichier, cerr);
+    TP::SourceProcessus& source = binaire != nullptr ? static_cast<TP::SourceProcessus&>(*binaire) : sourceTexte;
+    TP::PuitsTexte texte(cout);
+    TP::PuitsLatences latences;
+    TP::PuitsEcheances echeances;
+    TP::PuitsStatistiques statistiques;
+    TP::PuitsMultiple puits({&texte, &latences, &echeances, &statistiques});
+    unique_ptr<TP::Chronologie> chronologie;
+    if (!sortieChronologie.empty()) {
+        chronologie = make_unique<TP::Chronologie>(CAPACITE_CHRONOLOGIE);
+    }
+    int temps = 0;
+    int64_t commutation = 0;
+    if (!TP::Ordonnanceur::flux(politique, quantum, source, puits, temps, chronologie.get(), couts, &commutation)) {
+        cerr << "erreur : politique " << politique << " inconnue." << endl;
+        return 1;
+    }
+    size_t nbHorsOrdre = binaire != nullptr ? binaire->nbHorsOrdre() : sourceTexte.nbHorsOrdre();
+    if (nbHorsOrdre > 0) {
+        cerr << nbHorsOrdre << " processus hors de l'ordre d'arrivee ignores" << endl;
+    }
+    if (texte.nbTermines() > 0) {
+        cout << "temps d'attente moyen : " << texte.attenteMoyenne() << "\n";
+        if (statistiques.entreesSortiesMoyenne() > 0) {
+            cout << "temps d'entrees-sorties moyen : " << statistiques.entreesSortiesMoyenne() << "\n";
+        }
+        afficherCommutation(couts, commutation, temps);
+        TP::ecrireLatences(cout, latences, true);
+    }
+    if (echeances.tous().nbEcheances > 0) {
+        TP::ecrireEcheances(cout, echeances);
     }
-    cout << "fin chargement\n";
+    if (chronologie != nullptr && !ecrireChronologie(sortieChronologie, *chronologie, nullptr)) {
+        return 1;
+    }
+    return 0;
+}
 
-    return true;
+/**
+ * @brief fonction pour lire une liste de quanta
+ *
+ * @param texte "q1,q2,..." ou un intervalle "debut:fin[:pas]"
+ * @param quanta les quanta lus
+ *
+ * @return true si le texte est valide et tous les quanta positifs, false sinon
+ */
+bool lireQuanta(const string& texte, vector<int>& quanta) {
+    quanta.clear();
+    if (texte.find(':') != string::npos) {
+        vector<int> bornes; // debut, fin et pas
+        stringstream flux(texte);
+        string element;
+        while (getline(flux, element, ':')) {
+            int valeur = 0;
+            if (bornes.size() == 3 || !TP::lireNombre(element, valeur)) {
+                return false;
+            }
+            bornes.push_back(valeur);
+        }
+        int pas = bornes.size() == 3 ? bornes[2] : 1;
+        if (bornes.size() < 2 || pas <= 0) {
+            return false;
+        }
+        for (int64_t q = bornes[0]; q <= bornes[1]; q += pas) {
+            quanta.push_back(static_cast<int>(q));
+        }
+    } else {
+        stringstream flux(texte);
+        string element;
+        while (getline(flux, element, ',')) {
+            int q = 0;
+            if (!TP::lireNombre(element, q)) {
+                return false;
+            }
+            quanta.push_back(q);
+        }
+    }
+    return !quanta.empty() && all_of(quanta.begin(), quanta.end(), [](int q) { return q > 0; });
 }
 
 /**
- * @brief fonction principale
+ * @brief fonction pour afficher une mesure de balayage du quantum
  *
- * cette fonction exécute différentes simulations d'algorithmes d'ordonnancement de processus :
- * fcfs, sjf, round robin, priorité et à files multiniveaux. les résultats sont affichés dans la console.
+ * @param m la mesure
+ * @param avecCouts vrai pour afficher aussi la part du temps perdue en commutations
+ */
+void afficherMesure(const TP::MesureQuantum& m, bool avecCouts) {
+    cout << setw(8) << m.quantum;
+    if (m.abandonnee) {
+        cout << "  abandonne\n";
+        return;
+    }
+    cout << fixed << setprecision(2) << setw(16) << m.attenteMoyenne << setw(12) << m.attenteP99
+         << setw(18) << m.rotationMoyenne << setw(14) << m.rotationP99;
+    if (avecCouts) {
+        cout << setw(13) << 100.0 * m.commutation << "%";
+    }
+    cout << "\n";
+    cout.unsetf(ios::floatfield);
+}
+
+void afficherEnTeteMesures(bool avecCouts) {
+    cout << setw(8) << "quantum" << setw(16) << "attente moy." << setw(12) << "attente p99"
+         << setw(18) << "rotation moy." << setw(14) << "rotation p99";
+    if (avecCouts) {
+        cout << setw(14) << "commutations";
+    }
+    cout << "\n";
+}
+
+/**
+ * @brief fonction pour balayer ou ajuster le quantum d'une politique sur une trace
  *
- * @return 0 si l'exécution se fait correctement, 1 sinon
+ * la trace est chargée une seule fois ; les simulations se la partagent en lecture seule
+ * et s'exécutent en parallèle sur tous les cœurs.
+ *
+ * @param politique une politique à quantum (voir TP::utiliseQuantum)
+ * @param chemin la trace à simuler
+ * @param quanta les quanta à balayer, ou l'intervalle "qmin:qmax" à ajuster
+ * @param critere le critère à minimiser, vide pour un simple balayage
+ * @param couts les coûts des commutations de contexte, qui pénalisent les petits quanta
+ *
+ * @return 0 si les simulations sont réussies, 1 sinon
+ */
+int balayerQuantum(const string& politique, const string& chemin, const string& quanta, const string& critere,
+                   const TP::CoutsCommutation& couts) {
+    if (!TP::utiliseQuantum(politique)) {
+        cerr << "erreur : le balayage du quantum s'applique a rr, multiniveaux, mlfq et cfs." << endl;
+        return 1;
+    }
+    vector<int> liste;
+    if (!lireQuanta(quanta, liste)) {
+        cerr << "erreur : quanta " << quanta << " invalides." << endl;
+        return 1;
+    }
+    TP::CritereQuantum choix = TP::ATTENTE_MOYENNE;
+    if (!critere.empty() && !TP::lireCritere(critere, choix)) {
+        cerr << "erreur : critere " << critere << " inconnu." << endl;
+        return 1;
+    }
+
+    auto charge = make_shared<TP::TableProcessus>();
+    if (!chargerTable(chemin, *charge) || charge->estVide()) {
+        return 1;
+    }
+
+    TP::PoolFils pool;
+    if (critere.empty()) {
+        afficherEnTeteMesures(!couts.estNul());
+        for (const TP::MesureQuantum& m : TP::balayerQuanta(charge, politique, liste, pool, couts)) {
+            afficherMesure(m, !couts.estNul());
+        }
+        return 0;
+    }
+
+    vector<TP::MesureQuantum> essais;
+    TP::MesureQuantum meilleure = TP::ajusterQuantum(charge, politique, *min_element(liste.begin(), liste.end()),
+                                                     *max_element(liste.begin(), liste.end()), choix, pool, essais,
+                                                     couts);
+    afficherEnTeteMesures(!couts.estNul());
+    for (const TP::MesureQuantum& m : essais) {
+        afficherMesure(m, !couts.estNul());
+    }
+    cout << "meilleur quantum (" << critere << ") : " << meilleure.quantum << "\n";
+    return 0;
+}
+
+/**
+ * @brief fonction pour simuler un ensemble de politiques sur un ensemble de traces
+ *
+ * toutes les paires (trace, politique) sont réparties sur les cœurs de la machine ; le résumé
+ * est écrit en JSON si le fichier de sortie finit par .json, en CSV sinon.
+ *
+ * @param chemin un répertoire de traces ou un manifeste (un chemin par ligne)
+ * @param politiques les noms des politiques séparés par des virgules, ou "toutes"
+ * @param quantum le quantum de la politique, ignoré si elle n'en utilise pas (voir TP::utiliseQuantum)
+ * @param sortie le fichier du résumé
+ * @param couts les coûts des commutations de contexte
+ *
+ * @return 0 si la campagne est réussie, 1 sinon
  */
-int main() {
-    queue<Processus> file_processus;
+int executerCampagne(const string& chemin, const string& politiques, int quantum, const string& sortie,
+                     const TP::CoutsCommutation& couts) {
+    const vector<string>& connus = TP::nomsPolitiques();
+    vector<string> noms;
+    if (politiques == "toutes") {
+        noms = connus;
+    } else {
+        stringstream flux(politiques);
+        string nom;
+        while (getline(flux, nom, ',')) {
+            if (find(connus.begin(), connus.end(), nom) == connus.end()) {
+                cerr << "erreur : politique " << nom << " inconnue." << endl;
+                return 1;
+            }
+            noms.push_back(nom);
+        }
+    }
+    if (quantum <= 0) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
+    }
+
+    vector<string> traces;
+    if (!TP::listerTraces(chemin, traces)) {
+        cerr << "erreur : impossible de lire " << chemin << "." << endl;
+        return 1;
+    }
+    ofstream fichier(sortie);
+    if (!fichier) {
+        cerr << "erreur : impossible d'ecrire le fichier " << sortie << "." << endl;
+        return 1;
+    }
+
+    TP::PoolFils pool;
+    vector<TP::ResultatCampagne> resultats = TP::executerCampagne(traces, noms, quantum, pool, couts);
+    if (sortie.size() >= 5 && sortie.compare(sortie.size() - 5, 5, ".json") == 0) {
+        TP::ecrireJson(fichier, resultats);
+    } else {
+        TP::ecrireCsv(fichier, resultats);
+    }
+
+    size_t echecs = count_if(resultats.begin(), resultats.end(),
+                             [](const TP::ResultatCampagne& r) { return !r.erreur.empty(); });
+    cout << resultats.size() << " simulations (" << traces.size() << " traces, " << noms.size()
+         << " politiques, " << pool.nbFils() << " fils), " << echecs << " en echec, resume dans " << sortie << "\n";
+    return 0;
+}
+
+/**
+ * @brief fonction pour simuler une trace sur plusieurs processeurs
+ *
+ * chaque processeur a sa propre file prête sous la politique choisie ; affiche l'utilisation
+ * et les migrations de chaque processeur, puis l'attente et la rotation de tout le système.
+ *
+ * @param politique le nom de la politique d'ordonnancement de chaque processeur
+ * @param quantum le quantum de la politique, ignoré si elle n'en utilise pas (voir TP::utiliseQuantum)
+ * @param nbProcesseurs le nombre de processeurs
+ * @param equilibrage "aucun", "pousser", "tirer" ou "periodique:intervalle"
+ * @param chemin la trace à simuler
+ * @param sortieChronologie le fichier JSON de la chronologie (une ligne par processeur), vide pour
+ * ne pas l'enregistrer
+ * @param couts les coûts des commutations de contexte ; un processus migré paie aussi la migration
+ *
+ * @return 0 si la simulation est réussie, 1 sinon
+ */
+int simulerMultiprocesseur(const string& politique, int quantum, int nbProcesseurs, const string& equilibrage,
+                           const string& chemin, const string& sortieChronologie, const TP::CoutsCommutation& couts) {
+    const vector<string>& connues = TP::nomsPolitiques();
+    if (find(connues.begin(), connues.end(), politique) == connues.end()) {
+        cerr << "erreur : politique " << politique << " inconnue." << endl;
+        return 1;
+    }
+    if (quantum <= 0 && TP::utiliseQuantum(politique)) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
+    }
+    if (nbProcesseurs <= 0) {
+        cerr << "erreur : le nombre de processeurs doit etre positif." << endl;
+        return 1;
+    }
+    string nom = equilibrage.substr(0, equilibrage.find(':'));
+    int periode = 0;
+    bool periodeLue = nom.size() == equilibrage.size()
+                      || TP::lireNombre(string_view(equilibrage).substr(nom.size() + 1), periode);
+    const vector<string>& equilibreurs = TP::nomsEquilibreurs();
+    if (find(equilibreurs.begin(), equilibreurs.end(), nom) == equilibreurs.end() || !periodeLue
+        || (nom == "periodique" && periode <= 0)) {
+        cerr << "erreur : equilibrage " << equilibrage << " invalide." << endl;
+        return 1;
+    }
+
+    TP::TableProcessus table;
+    if (!chargerTable(chemin, table) || table.estVide()) {
+        return 1;
+    }
+
+    unique_ptr<TP::Equilibreur> equilibreur = TP::creerEquilibreur(nom, periode);
+    vector<unique_ptr<TP::FilePrete>> files;
+    for (int p = 0; p < nbProcesseurs; ++p) {
+        files.push_back(TP::creerPolitique(politique, table, quantum, table.taille() / nbProcesseurs + 1));
+    }
+    TP::MoteurMultiprocesseur moteur(table, std::move(files), *equilibreur);
+    moteur.setCouts(couts);
+    TP::Chronologie chronologie;
+    if (!sortieChronologie.empty()) {
+        moteur.setChronologie(&chronologie);
+    }
     int temps = 0;
+    vector<TP::IdProcessus> termines = moteur.executer(temps);
 
-    string cheminFichier = "Test.txt";
+    cout << setw(6) << "cpu" << setw(14) << "utilisation" << setw(12) << "elections" << setw(12) << "entrees"
+         << setw(12) << "sorties";
+    if (!couts.estNul()) {
+        cout << setw(14) << "commutations";
+    }
+    cout << "\n";
+    streamsize precision = cout.precision();
+    for (size_t p = 0; p < moteur.nbProcesseurs(); ++p) {
+        const TP::StatistiquesProcesseur& stats = moteur.statistiques(p);
+        cout << setw(6) << p << fixed << setprecision(1) << setw(13)
+             << (temps > 0 ? 100.0 * stats.tempsOccupe / temps : 0.0) << "%" << setw(12) << stats.nbElections
+             << setw(12) << stats.migrationsEntrantes << setw(12) << stats.migrationsSortantes;
+        if (!couts.estNul()) {
+            cout << setw(13) << (temps > 0 ? 100.0 * stats.tempsCommutation / temps : 0.0) << "%";
+        }
+        cout << "\n";
+        cout.unsetf(ios::floatfield);
+    }
+    cout.precision(precision);
 
+    double attente = 0;
+    double rotation = 0;
+    double entreesSorties = 0;
+    for (TP::IdProcessus id : termines) {
+        attente += table.attente(id);
+        rotation += table.fin(id) - table.arrivee(id);
+        entreesSorties += table.tempsEntreesSorties(id);
+    }
+    cout << termines.size() << " processus sur " << nbProcesseurs << " processeurs, fin a " << temps << ", "
+         << moteur.nbMigrations() << " migrations\n";
+    cout << "temps d'attente moyen : " << attente / termines.size() << "\n";
+    if (table.aEntreesSorties()) {
+        cout << "temps d'entrees-sorties moyen : " << entreesSorties / termines.size() << "\n";
+    }
+    cout << "temps de rotation moyen : " << rotation / termines.size() << "\n";
+    afficherCommutation(couts, moteur.tempsCommutation(), int64_t(temps) * nbProcesseurs);
+    if (!sortieChronologie.empty() && !ecrireChronologie(sortieChronologie, chronologie, &table)) {
+        return 1;
+    }
+    return 0;
+}
 
-    // simulation FCFS
-    if (!chargerProcessus(cheminFichier, file_processus)) {
+/**
+ * @brief fonction pour comparer la part du processeur reçue par chaque priorité à la part
+ * attendue d'un partage proportionnel
+ *
+ * @param politique "loterie" ou "stride"
+ * @param quantum la tranche de chaque élu
+ * @param chemin la trace à simuler
+ * @param graine la graine des tirages de la loterie
+ * @param couts les coûts des commutations de contexte
+ *
+ * @return 0 si la simulation est réussie, 1 sinon
+ */
+int mesurerParts(const string& politique, int quantum, const string& chemin, uint64_t graine,
+                 const TP::CoutsCommutation& couts) {
+    if (politique != "loterie" && politique != "stride") {
+        cerr << "erreur : les parts se mesurent pour loterie et stride." << endl;
+        return 1;
+    }
+    if (quantum <= 0) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
+    }
+    TP::TableProcessus table;
+    if (!chargerTable(chemin, table) || table.estVide()) {
         return 1;
     }
 
-    cout << "\nsimulation FCFS resultat: \n";
-    queue<Processus> fcfs_result = TP::Ordonnanceur::fcfs(file_processus, temps);
-    double temps_attente_total = 0;
-    int n = fcfs_result.size();
-    while (!fcfs_result.empty()) {
-        Processus p = fcfs_result.front();
-        fcfs_result.pop();
-        cout << p.getPid() << " arrivee : " << p.getArrivee() << " Duree : " << p.getDuree()
-             << " temps d'attente : " << p.getAttente() << " Priorite : " << p.getPriorite()
-             << " Type : " << (p.getType() + 1) << endl;
-        temps_attente_total += p.getAttente();
+    TP::PuitsStatistiques statistiques;
+    int temps = 0;
+    int64_t commutation = 0;
+    map<int, TP::PartsParPriorite::Part> parts;
+    auto simuler = [&](auto& file) {
+        TP::MoteurGenerique moteur(table, file);
+        moteur.setCouts(couts);
+        moteur.executer(statistiques, temps);
+        commutation = moteur.tempsCommutation();
+        parts = file.parts().parts();
+    };
+    if (politique == "loterie") {
+        TP::FileLoterie file(table, quantum, graine);
+        simuler(file);
+    } else {
+        TP::FileStride file(table, quantum);
+        simuler(file);
+    }
+
+    int64_t total = 0;
+    uint64_t elections = 0;
+    for (const auto& [priorite, part] : parts) {
+        total += part.recue;
+        elections += part.nbElections;
     }
-    if (n > 0) {
-        cout << "temps d'attente moyen : " << temps_attente_total / n << "\n";
+    cout << setw(9) << "priorite" << setw(8) << "poids" << setw(12) << "elections" << setw(11) << "recue"
+         << setw(11) << "attendue" << setw(9) << "ecart" << "\n";
+    streamsize precision = cout.precision();
+    for (const auto& [priorite, part] : parts) {
+        double recue = 100.0 * part.recue / total;
+        double attendue = 100.0 * part.attendue / total;
+        cout << setw(9) << priorite << setw(8) << TP::poidsPriorite(priorite) << setw(12) << part.nbElections << fixed
+             << setprecision(3) << setw(10) << recue << "%" << setw(10) << attendue << "%" << showpos << setw(8)
+             << recue - attendue << "%" << noshowpos << "\n";
+        cout.unsetf(ios::floatfield);
     }
+    cout.precision(precision);
+    cout << elections << " elections, " << statistiques.nbTermines() << " processus, fin a " << temps
+         << ", attente moyenne " << statistiques.attenteMoyenne() << "\n";
+    afficherCommutation(couts, commutation, temps);
+    return 0;
+}
 
-    // réinitialisation du temps pour les autres simulations
-    temps = 0;
+/**
+ * @brief fonction pour mesurer les échéances manquées d'une politique sur une trace à échéances
+ *
+ * la faisabilité de la charge est vérifiée avant la simulation (voir TP::verifierFaisabilite) ;
+ * une charge infaisable n'est simulée que si forcer est vrai.
+ *
+ * @param politique le nom de la politique d'ordonnancement
+ * @param quantum le quantum des politiques à quantum
+ * @param chemin la trace à simuler
+ * @param forcer vrai pour simuler même une charge infaisable
+ * @param couts les coûts des commutations de contexte, que le test de faisabilité ignore
+ *
+ * @return 0 si la simulation est réussie, 1 sinon (ou si la charge est infaisable et non forcée)
+ */
+int mesurerEcheances(const string& politique, int quantum, const string& chemin, bool forcer,
+                     const TP::CoutsCommutation& couts) {
+    const vector<string>& connues = TP::nomsPolitiques();
+    if (find(connues.begin(), connues.end(), politique) == connues.end()) {
+        cerr << "erreur : politique " << politique << " inconnue." << endl;
+        return 1;
+    }
+    if (quantum <= 0 && TP::utiliseQuantum(politique)) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
+    }
+    auto charge = make_shared<TP::TableProcessus>();
+    if (!chargerTable(chemin, *charge) || charge->estVide()) {
+        return 1;
+    }
 
-    // simulation SJF (fjs)
-    cout << "\nsimulation SJF (FJS) resultat: \n";
-    queue<Processus> sjf_result = TP::Ordonnanceur::fjs(file_processus, temps);
-    temps_attente_total = 0;
-    n = sjf_result.size();
-    while (!sjf_result.empty()) {
-        Processus p = sjf_result.front();
-        sjf_result.pop();
-        cout << p.getPid() << " arrivee : " << p.getArrivee() << " Duree : " << p.getDuree()
-             << " temps d'attente : " << p.getAttente() << " Priorite : " << p.getPriorite()
-             << " Type : " << (p.getType() + 1) << endl;
-        temps_attente_total += p.getAttente();
+    TP::Faisabilite faisabilite = TP::verifierFaisabilite(*charge);
+    if (faisabilite.nbEcheances == 0) {
+        cerr << "erreur : aucun processus de " << chemin << " n'a d'echeance." << endl;
+        return 1;
     }
-    if (n > 0) {
-        cout << "temps d'attente moyen : " << temps_attente_total / n << "\n";
+    if (!faisabilite.faisable) {
+        cout << "charge infaisable : la fenetre [" << faisabilite.debut << ", " << faisabilite.fin << "] demande "
+             << faisabilite.demande << " unites pour " << faisabilite.capacite << " disponibles\n";
+        if (!forcer) {
+            cerr << "simulation abandonnee (--forcer pour la lancer quand meme)" << endl;
+            return 1;
+        }
+    } else {
+        cout << "charge faisable : edf_preemptive tient les " << faisabilite.nbEcheances << " echeances\n";
     }
 
-    // simulation Round Robin
-    temps = 0;
-    int quantum = 4;
-    cout << "\nsimulation Round Robin resultat: \n";
-    queue<Processus> rr_result = TP::Ordonnanceur::round_robin(file_processus, quantum, temps);
-    temps_attente_total = 0;
-    n = rr_result.size();
-    while (!rr_result.empty()) {
-        Processus p = rr_result.front();
-        rr_result.pop();
-        cout << p.getPid() << " arrivee : " << p.getArrivee() << " Duree : " << p.getDuree()
-             << " temps d'attente : " << p.getAttente() << " Priorite : " << p.getPriorite()
-             << " Type : " << (p.getType() + 1) << endl;
-        temps_attente_total += p.getAttente();
+    TP::TableProcessus table = TP::TableProcessus::partager(charge);
+    TP::PuitsEcheances echeances;
+    TP::PuitsStatistiques statistiques;
+    TP::PuitsMultiple puits({&echeances, &statistiques});
+    int temps = 0;
+    int64_t commutation = 0;
+    TP::Ordonnanceur::simuler(politique, quantum, table, puits, temps, nullptr, couts, &commutation);
+    TP::ecrireEcheances(cout, echeances);
+    cout << statistiques.nbTermines() << " processus, fin a " << temps << ", attente moyenne "
+         << statistiques.attenteMoyenne() << "\n";
+    afficherCommutation(couts, commutation, temps);
+    return 0;
+}
+
+/**
+ * @brief fonction pour mesurer une politique sur une trace dont les processus font des E/S
+ *
+ * affiche l'utilisation du processeur, puis, pour tous les processus et pour chaque type,
+ * l'attente du processeur, le temps passé en E/S, la rotation et la réponse moyennes.
+ *
+ * @param politique le nom de la politique d'ordonnancement
+ * @param quantum le quantum des politiques à quantum
+ * @param chemin la trace à simuler
+ * @param couts les coûts des commutations de contexte
+ *
+ * @return 0 si la simulation est réussie, 1 sinon
+ */
+int mesurerEntreesSorties(const string& politique, int quantum, const string& chemin,
+                          const TP::CoutsCommutation& couts) {
+    const vector<string>& connues = TP::nomsPolitiques();
+    if (find(connues.begin(), connues.end(), politique) == connues.end()) {
+        cerr << "erreur : politique " << politique << " inconnue." << endl;
+        return 1;
+    }
+    if (quantum <= 0 && TP::utiliseQuantum(politique)) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
     }
-    if (n > 0) {
-        cout << "temps d'attente moyen : " << temps_attente_total / n << "\n";
+    TP::TableProcessus table;
+    if (!chargerTable(chemin, table) || table.estVide()) {
+        return 1;
     }
 
-    // simulation avec Priorité
-    file_processus = queue<Processus>(); // réinitialisation de la file des processus
-    if (!chargerProcessus("TestPriorite.txt", file_processus)) {
+    TP::PuitsStatistiquesParType statistiques;
+    int temps = 0;
+    int64_t occupe = 0;
+    int64_t commutation = 0;
+    TP::avecPolitique(politique, table, quantum, [&](auto& file) {
+        TP::MoteurGenerique moteur(table, file);
+        moteur.setCouts(couts);
+        moteur.executer(statistiques, temps);
+        occupe = moteur.tempsOccupe();
+        commutation = moteur.tempsCommutation();
+    });
+
+    const TP::PuitsStatistiques& tous = statistiques.tous();
+    streamsize precision = cout.precision();
+    cout << tous.nbTermines() << " processus, fin a " << temps << ", utilisation du processeur " << fixed
+         << setprecision(1) << (temps > 0 ? 100.0 * occupe / temps : 0.0) << " %\n";
+    cout << setw(8) << "type" << setw(10) << "nombre" << setw(12) << "attente" << setw(12) << "e/s" << setw(12)
+         << "rotation" << setw(12) << "reponse" << "\n";
+    auto ecrire = [](const string& nom, const TP::PuitsStatistiques& s) {
+        if (s.nbTermines() == 0) {
+            return;
+        }
+        cout << setw(8) << nom << setw(10) << s.nbTermines() << setprecision(2) << setw(12) << s.attenteMoyenne()
+             << setw(12) << s.entreesSortiesMoyenne() << setw(12) << s.rotationMoyenne() << setw(12)
+             << s.reponseMoyenne() << "\n";
+    };
+    ecrire("tous", tous);
+    for (int type = SYSTEME; type <= UTILISATEUR; ++type) {
+        ecrire(to_string(type + 1), statistiques.parType(static_cast<TypeProcessus>(type)));
+    }
+    cout.unsetf(ios::floatfield);
+    cout.precision(precision);
+    afficherCommutation(couts, commutation, temps);
+    return 0;
+}
+
+/**
+ * @brief fonction pour vérifier une politique et son quantum
+ *
+ * @return true si la politique est connue et, pour une politique à quantum, le quantum positif
+ */
+bool verifierPolitique(const string& politique, int quantum) {
+    const vector<string>& connues = TP::nomsPolitiques();
+    if (find(connues.begin(), connues.end(), politique) == connues.end()) {
+        cerr << "erreur : politique " << politique << " inconnue." << endl;
+        return false;
+    }
+    if (quantum <= 0 && TP::utiliseQuantum(politique)) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief fonction pour charger la charge partagée par un instantané et ses branches
+ *
+ * les pids sont classés une fois, avant le partage : sjf et srtf s'en servent dans chaque branche.
+ *
+ * @param chemin la trace texte ou binaire
+ * @param charge la table partagée
+ *
+ * @return true si la trace est chargée et n'est pas vide, false sinon
+ */
+bool chargerCharge(const string& chemin, shared_ptr<const TP::TableProcessus>& charge) {
+    auto table = make_shared<TP::TableProcessus>();
+    if (!chargerTable(chemin, *table) || table->estVide()) {
+        return false;
+    }
+    table->classerPids();
+    charge = std::move(table);
+    return true;
+}
+
+/**
+ * @brief fonction pour prendre l'instantané d'une simulation à un instant
+ *
+ * @return true si l'instantané est pris, false si les arguments sont invalides
+ */
+bool prendreInstantane(const string& politique, int quantum, const shared_ptr<const TP::TableProcessus>& charge,
+                       int instant, const TP::CoutsCommutation& couts,
+                       shared_ptr<const TP::Instantane>& instantane) {
+    if (instant < 0) {
+        cerr << "erreur : l'instant doit etre positif." << endl;
+        return false;
+    }
+    vector<shared_ptr<const TP::Instantane>> instantanes;
+    TP::Ordonnanceur::instantanes(politique, quantum, charge, {instant}, instantanes, couts);
+    instantane = instantanes.front();
+
+    size_t bloques = count_if(instantane->enCours.begin(), instantane->enCours.end(),
+                              [](const TP::EtatProcessus& e) { return e.reveil >= 0; });
+    cout << "instantane a " << instantane->temps << " : " << instantane->nbAdmis << " processus arrives, "
+         << instantane->termines.size() << " termines, " << instantane->enCours.size() - bloques << " prets, "
+         << bloques << " en E/S\n";
+    return true;
+}
+
+/**
+ * @brief fonction pour lire une liste de branches
+ *
+ * @param texte "politique[:quantum],..." ; une branche sans quantum prend quantumDefaut
+ * @param quantumDefaut le quantum des branches qui n'en donnent pas
+ * @param branches les branches lues
+ *
+ * @return true si chaque politique est connue et chaque quantum utilisé positif, false sinon
+ */
+bool lireBranches(const string& texte, int quantumDefaut, vector<TP::Branche>& branches) {
+    branches.clear();
+    stringstream flux(texte);
+    string element;
+    while (getline(flux, element, ',')) {
+        size_t deuxPoints = element.find(':');
+        TP::Branche branche{element.substr(0, deuxPoints), quantumDefaut};
+        if (deuxPoints != string::npos && !TP::lireNombre(string_view(element).substr(deuxPoints + 1), branche.quantum)) {
+            cerr << "erreur : branche " << element << " invalide." << endl;
+            return false;
+        }
+        if (!verifierPolitique(branche.politique, branche.quantum)) {
+            return false;
+        }
+        branches.push_back(branche);
+    }
+    return !branches.empty();
+}
+
+/**
+ * @brief fonction pour comparer des branches d'une même simulation
+ *
+ * la simulation suit la politique choisie jusqu'à l'instant, puis chaque branche en repart avec
+ * sa propre politique et son quantum ; les branches ne simulent que la suite, en parallèle, et
+ * partagent la charge et l'instantané. Les mesures comptent tous les processus de la trace.
+ *
+ * @param politique la politique suivie jusqu'à l'instant
+ * @param quantum son quantum, et celui des branches qui n'en donnent pas
+ * @param chemin la trace à simuler
+ * @param instant l'instant de l'embranchement
+ * @param texteBranches "politique[:quantum],..."
+ * @param couts les coûts des commutations de contexte, avant et après l'instant
+ *
+ * @return 0 si les simulations sont réussies, 1 sinon
+ */
+int comparerBranches(const string& politique, int quantum, const string& chemin, int instant,
+                     const string& texteBranches, const TP::CoutsCommutation& couts) {
+    vector<TP::Branche> branches;
+    if (!verifierPolitique(politique, quantum) || !lireBranches(texteBranches, quantum, branches)) {
         return 1;
     }
-    temps = 0;
-    cout << "\nsimulation avec Priorite resultat: \n";
-    queue<Processus> priorite_result = TP::Ordonnanceur::priorite(file_processus, temps);
-    temps_attente_total = 0;
-    n = priorite_result.size();
-    while (!priorite_result.empty()) {
-        Processus p = priorite_result.front();
-        priorite_result.pop();
-        cout << p.getPid() << " arrivee : " << p.getArrivee() << " Duree : " << p.getDuree()
-             << " temps d'attente : " << p.getAttente() << " Priorite : " << p.getPriorite()
-             << " Type : " << (p.getType() + 1) << endl;
-        temps_attente_total += p.getAttente();
+    shared_ptr<const TP::TableProcessus> charge;
+    shared_ptr<const TP::Instantane> instantane;
+    if (!chargerCharge(chemin, charge) || !prendreInstantane(politique, quantum, charge, instant, couts, instantane)) {
+        return 1;
     }
-    if (n > 0) {
-        cout << "temps d'attente moyen : " << temps_attente_total / n << "\n";
+
+    TP::PoolFils pool;
+    vector<TP::MesureQuantum> mesures = TP::mesurerBranches(instantane, branches, pool, couts);
+    cout << left << setw(22) << "branche" << right;
+    afficherEnTeteMesures(!couts.estNul());
+    for (size_t i = 0; i < branches.size(); ++i) {
+        cout << left << setw(22) << branches[i].politique << right;
+        afficherMesure(mesures[i], !couts.estNul());
     }
+    return 0;
+}
 
-    // simulation à files multiniveaux
-    file_processus = queue<Processus>(); // réinitialisation de la file des processus
-    if (!chargerProcessus("TestMultiniveaux.txt", file_processus)) {
+/**
+ * @brief fonction pour enregistrer l'instantané d'une simulation
+ *
+ * @param politique la politique suivie jusqu'à l'instant
+ * @param quantum son quantum
+ * @param chemin la trace à simuler ; elle sera relue pour reprendre l'instantané
+ * @param instant l'instant de l'instantané
+ * @param sortie le fichier de l'instantané
+ * @param couts les coûts des commutations de contexte
+ *
+ * @return 0 si l'instantané est écrit, 1 sinon
+ */
+int enregistrerInstantane(const string& politique, int quantum, const string& chemin, int instant,
+                          const string& sortie, const TP::CoutsCommutation& couts) {
+    if (!verifierPolitique(politique, quantum)) {
+        return 1;
+    }
+    shared_ptr<const TP::TableProcessus> charge;
+    shared_ptr<const TP::Instantane> instantane;
+    if (!chargerCharge(chemin, charge) || !prendreInstantane(politique, quantum, charge, instant, couts, instantane)) {
         return 1;
     }
-    temps = 0;
+    if (!TP::ecrireInstantane(*instantane, sortie)) {
+        cerr << "erreur : impossible d'ecrire le fichier " << sortie << "." << endl;
+        return 1;
+    }
+    cout << "instantane ecrit dans " << sortie << "\n";
+    return 0;
+}
 
-    cout << "\nsimulation Multiniveaux resultat: \n";
-    queue<Processus> multiniveaux_result = TP::Ordonnanceur::multiniveaux(file_processus, quantum, temps);
-    temps_attente_total = 0;
-    n = multiniveaux_result.size();
-    while (!multiniveaux_result.empty()) {
-        Processus p = multiniveaux_result.front();
-        multiniveaux_result.pop();
-        cout << p.getPid() << " arrivee : " << p.getArrivee() << " Duree : " << p.getDuree()
-             << " temps d'attente : " << p.getAttente() << " Priorite : " << p.getPriorite()
-             << " Type : " << (p.getType() + 1) << endl;
-        temps_attente_total += p.getAttente();
+/**
+ * @brief fonction pour reprendre une simulation depuis un instantané enregistré
+ *
+ * affiche l'attente moyenne et les centiles des latences de tous les processus de la trace,
+ * ceux terminés avant l'instantané compris.
+ *
+ * @param fichier l'instantané écrit par --instantane
+ * @param chemin la trace de la simulation
+ * @param politique la politique à partir de l'instantané
+ * @param quantum son quantum
+ * @param couts les coûts des commutations de contexte à partir de l'instantané
+ *
+ * @return 0 si la simulation est réussie, 1 sinon
+ */
+int reprendreInstantane(const string& fichier, const string& chemin, const string& politique, int quantum,
+                        const TP::CoutsCommutation& couts) {
+    if (!verifierPolitique(politique, quantum)) {
+        return 1;
+    }
+    shared_ptr<const TP::TableProcessus> charge;
+    if (!chargerCharge(chemin, charge)) {
+        return 1;
+    }
+    TP::Instantane instantane;
+    string erreur;
+    if (!TP::chargerInstantane(fichier, charge, instantane, erreur)) {
+        cerr << "erreur : instantane " << fichier << " invalide : " << erreur << endl;
+        return 1;
+    }
+
+    TP::PuitsStatistiques statistiques;
+    TP::PuitsLatences latences;
+    TP::PuitsMultiple puits({&statistiques, &latences});
+    int temps = 0;
+    int64_t commutation = 0;
+    if (!TP::Ordonnanceur::reprendre(politique, quantum, instantane, puits, temps, couts, &commutation)) {
+        cerr << "erreur : instantane " << fichier << " invalide : etat de la politique incoherent." << endl;
+        return 1;
+    }
+    cout << "reprise a " << instantane.temps << " : " << statistiques.nbTermines() << " processus, fin a " << temps
+         << "\n";
+    cout << "temps d'attente moyen : " << statistiques.attenteMoyenne() << "\n";
+    afficherCommutation(couts, commutation, temps);
+    TP::ecrireLatences(cout, latences, false);
+    return 0;
+}
+
+/**
+ * @brief fonction pour vérifier que la reprise d'un instantané prolonge exactement sa simulation
+ *
+ * pour chaque politique, des instantanés sont pris aux instants donnés ; la branche de la même
+ * politique qui repart de chacun doit terminer chaque processus au même instant, après la même
+ * attente et le même nombre de tranches, que la simulation sans arrêt, avec le même temps perdu
+ * en commutations.
+ *
+ * @param chemin la trace à simuler
+ * @param quantum le quantum des politiques qui en ont un
+ * @param texteInstants "i1,i2,..." ou un intervalle "debut:fin[:pas]", comme les quanta
+ * @param couts les coûts des commutations de contexte
+ *
+ * @return 0 si chaque reprise est identique à la simulation sans arrêt, 1 sinon
+ */
+int verifierReprise(const string& chemin, int quantum, const string& texteInstants,
+                    const TP::CoutsCommutation& couts) {
+    vector<int> instants;
+    if (!lireQuanta(texteInstants, instants)) {
+        cerr << "erreur : les instants doivent etre positifs." << endl;
+        return 1;
+    }
+    if (quantum <= 0) {
+        cerr << "erreur : le quantum doit etre positif." << endl;
+        return 1;
+    }
+    sort(instants.begin(), instants.end());
+    shared_ptr<const TP::TableProcessus> charge;
+    if (!chargerCharge(chemin, charge)) {
+        return 1;
+    }
+
+    auto memeFin = [](const TP::Terminaison& a, const TP::Terminaison& b) {
+        return a.id == b.id && a.fin == b.fin && a.attente == b.attente && a.premierDemarrage == b.premierDemarrage
+               && a.nbTranches == b.nbTranches;
+    };
+    size_t nbDivergentes = 0;
+    for (const string& politique : TP::nomsPolitiques()) {
+        TP::TableProcessus table = TP::TableProcessus::partager(charge);
+        TP::PuitsCollecte reference(table.taille());
+        int fin = 0;
+        int64_t commutation = 0;
+        TP::Ordonnanceur::simuler(politique, quantum, table, reference, fin, nullptr, couts, &commutation);
+
+        vector<shared_ptr<const TP::Instantane>> instantanes;
+        TP::Ordonnanceur::instantanes(politique, quantum, charge, instants, instantanes, couts);
+        string divergences;
+        for (size_t i = 0; i < instants.size(); ++i) {
+            TP::PuitsCollecte branche(table.taille());
+            int finBranche = 0;
+            int64_t commutationBranche = 0;
+            bool reprise = TP::Ordonnanceur::reprendre(politique, quantum, *instantanes[i], branche, finBranche, couts,
+                                                       &commutationBranche);
+            const vector<TP::Terminaison>& attendues = reference.terminaisons();
+            const vector<TP::Terminaison>& obtenues = branche.terminaisons();
+            if (!reprise || finBranche != fin || commutationBranche != commutation
+                || !equal(attendues.begin(), attendues.end(), obtenues.begin(), obtenues.end(), memeFin)) {
+                divergences += " " + to_string(instants[i]);
+            }
+        }
+        cout << left << setw(22) << politique << right;
+        if (divergences.empty()) {
+            cout << "identique\n";
+        } else {
+            cout << "diverge a" << divergences << "\n";
+            ++nbDivergentes;
+        }
+    }
+    return nbDivergentes == 0 ? 0 : 1;
+}
+
+/**
+ * @brief fonction pour lire un argument entier de la ligne de commande
+ *
+ * @param texte l'argument
+ * @param nom ce que l'argument désigne, pour le message d'erreur
+ * @param valeur l'entier lu
+ *
+ * @return true si l'argument est un entier positif ou nul, false sinon, après avoir affiché l'erreur
+ */
+bool lireArgument(const char* texte, const char* nom, int& valeur) {
+    if (!TP::lireNombre(string_view(texte), valeur, 0)) {
+        cerr << "erreur : " << nom << " " << texte << " invalide." << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief fonction pour exécuter le mode demandé par les arguments
+ *
+ * sans mode, cette fonction exécute différentes simulations d'algorithmes d'ordonnancement de processus :
+ * fcfs, sjf, srtf, round robin, équitable (cfs), priorité (non préemptive et préemptive) et à files
+ * multiniveaux.
+ * les résultats sont affichés dans la console.
+ *
+ * avec "--convertir entree.txt sortie.pssb", convertit plutôt une trace texte en trace binaire.
+ * avec "--flux politique quantum trace [chronologie.json]", simule une trace texte ou binaire en flux (voir
+ * simulerFlux).
+ * avec "--balayage politique trace.txt quanta", compare plusieurs quanta en parallèle, et avec
+ * "--ajuster politique trace.txt qmin:qmax critere", cherche le quantum qui minimise le critère.
+ * avec "--campagne traces politiques quantum resume.csv", simule chaque politique sur chaque trace.
+ * avec "--parts loterie|stride quantum trace.txt [graine]", compare la part du processeur reçue par
+ * chaque priorité à la part attendue.
+ * avec "--echeances politique quantum trace.txt [--forcer]", vérifie la faisabilité d'une trace à
+ * échéances puis compte les échéances manquées par la politique.
+ * avec "--smp politique quantum processeurs equilibrage trace.txt [chronologie.json]", simule plusieurs
+ * processeurs. Le dernier argument, facultatif, enregistre la chronologie au format Chrome trace.
+ * avec "--es politique quantum trace.txt", mesure l'utilisation du processeur et sépare l'attente
+ * du processeur du temps passé en E/S, par type de processus.
+ * avec "--embranchements politique quantum trace.txt instant branches", simule jusqu'à l'instant puis
+ * compare des branches "politique[:quantum],..." qui en repartent ; avec "--instantane politique
+ * quantum trace.txt instant fichier.pssi", enregistre l'instantané, et avec "--reprendre fichier.pssi
+ * trace.txt politique quantum", termine la simulation à partir de lui. Avec "--verifier-reprise
+ * trace.txt quantum instants", vérifie que chaque politique reprise d'un instantané termine comme
+ * sans arrêt (voir verifierReprise).
+ * l'option "--couts commutation[,rechauffement[,refroidissement[,migration]]]", placée n'importe où,
+ * ajoute à chaque mode le coût des commutations de contexte (voir TP::CoutsCommutation) et affiche
+ * le temps qu'elles font perdre.
+ *
+ * @return 0 si l'exécution se fait correctement, 1 sinon
+ */
+int lancer(int argc, char* argv[]) {
+    TP::CoutsCommutation couts;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--couts") {
+            if (i + 1 == argc || !lireCouts(argv[i + 1], couts)) {
+                cerr << "erreur : couts de commutation invalides (commutation,rechauffement,refroidissement,migration)."
+                     << endl;
+                return 1;
+            }
+            // l'option est retirée des arguments, les modes ne la voient pas
+            copy(argv + i + 2, argv + argc + 1, argv + i);
+            argc -= 2;
+            break;
+        }
     }
-    if (n > 0) {
-        cout << "temps d'attente moyen : " << temps_attente_total / n << "\n";
+
+    int quantum = 0;
+    int entier = 0; // processeurs ou instant
+    if (argc == 4 && string(argv[1]) == "--convertir") {
+        return convertirTrace(argv[2], argv[3]);
+    }
+    if ((argc == 5 || argc == 6) && string(argv[1]) == "--flux") {
+        return lireArgument(argv[3], "quantum", quantum)
+                   ? simulerFlux(argv[2], quantum, argv[4], argc == 6 ? argv[5] : "", couts) : 1;
+    }
+    if (argc == 5 && string(argv[1]) == "--balayage") {
+        return balayerQuantum(argv[2], argv[3], argv[4], "", couts);
+    }
+    if (argc == 6 && string(argv[1]) == "--ajuster") {
+        return balayerQuantum(argv[2], argv[3], argv[4], argv[5], couts);
+    }
+    if (argc == 6 && string(argv[1]) == "--campagne") {
+        return lireArgument(argv[4], "quantum", quantum) ? executerCampagne(argv[2], argv[3], quantum, argv[5], couts) : 1;
+    }
+    if ((argc == 5 || argc == 6) && string(argv[1]) == "--parts") {
+        uint64_t graine = TP::FileLoterie::GRAINE_DEFAUT;
+        if (argc == 6 && !TP::lireNombre(string_view(argv[5]), graine)) {
+            cerr << "erreur : graine " << argv[5] << " invalide." << endl;
+            return 1;
+        }
+        return lireArgument(argv[3], "quantum", quantum) ? mesurerParts(argv[2], quantum, argv[4], graine, couts) : 1;
+    }
+    if ((argc == 5 || (argc == 6 && string(argv[5]) == "--forcer")) && string(argv[1]) == "--echeances") {
+        return lireArgument(argv[3], "quantum", quantum) ? mesurerEcheances(argv[2], quantum, argv[4], argc == 6, couts)
+                                                           : 1;
+    }
+    if ((argc == 7 || argc == 8) && string(argv[1]) == "--smp") {
+        return lireArgument(argv[3], "quantum", quantum) && lireArgument(argv[4], "nombre de processeurs", entier)
+                   ? simulerMultiprocesseur(argv[2], quantum, entier, argv[5], argv[6], argc == 8 ? argv[7] : "", couts)
+                   : 1;
+    }
+    if (argc == 5 && string(argv[1]) == "--es") {
+        return lireArgument(argv[3], "quantum", quantum) ? mesurerEntreesSorties(argv[2], quantum, argv[4], couts) : 1;
+    }
+    if (argc == 7 && string(argv[1]) == "--embranchements") {
+        return lireArgument(argv[3], "quantum", quantum) && lireArgument(argv[5], "instant", entier)
+                   ? comparerBranches(argv[2], quantum, argv[4], entier, argv[6], couts) : 1;
+    }
+    if (argc == 7 && string(argv[1]) == "--instantane") {
+        return lireArgument(argv[3], "quantum", quantum) && lireArgument(argv[5], "instant", entier)
+                   ? enregistrerInstantane(argv[2], quantum, argv[4], entier, argv[6], couts) : 1;
+    }
+    if (argc == 6 && string(argv[1]) == "--reprendre") {
+        return lireArgument(argv[5], "quantum", quantum) ? reprendreInstantane(argv[2], argv[3], argv[4], quantum, couts)
+                                                           : 1;
     }
+    if (argc == 5 && string(argv[1]) == "--verifier-reprise") {
+        return lireArgument(argv[3], "quantum", quantum) ? verifierReprise(argv[2], quantum, argv[4], couts) : 1;
+    }
+
+    shared_ptr<const TP::TableProcessus> charge;
+    quantum = 4;
+
+    // simulation FCFS
+    if (!chargerProcessus("Test.txt", charge)) {
+        return 1;
+    }
+    cout << "\nsimulation FCFS resultat: \n";
+    afficherResultat("fcfs", quantum, charge, couts);
+
+    // simulation SJF (fjs)
+    cout << "\nsimulation SJF (FJS) resultat: \n";
+    afficherResultat("sjf", quantum, charge, couts);
+
+    // simulation SRTF
+    cout << "\nsimulation SRTF resultat: \n";
+    afficherResultat("srtf", quantum, charge, couts);
+
+    // simulation Round Robin
+    cout << "\nsimulation Round Robin resultat: \n";
+    afficherResultat("rr", quantum, charge, couts);
+
+    // simulation équitable (CFS), le quantum servant de granularité minimale
+    cout << "\nsimulation CFS resultat: \n";
+    afficherResultat("cfs", quantum, charge, couts);
+
+    // simulation avec Priorité
+    if (!chargerProcessus("TestPriorite.txt", charge)) {
+        return 1;
+    }
+    cout << "\nsimulation avec Priorite resultat: \n";
+    afficherResultat("priorite", quantum, charge, couts);
+
+    // simulation avec Priorité préemptive
+    cout << "\nsimulation avec Priorite preemptive resultat: \n";
+    afficherResultat("priorite_preemptive", quantum, charge, couts);
+
+    // simulation à files multiniveaux
+    if (!chargerProcessus("TestMultiniveaux.txt", charge)) {
+        return 1;
+    }
+    cout << "\nsimulation Multiniveaux resultat: \n";
+    afficherResultat("multiniveaux", quantum, charge, couts);
 
     cout << "fin du programme\n";
     return 0;
 }
+
+/**
+ * @brief fonction principale
+ *
+ * exécute le mode demandé (voir lancer) ; une simulation dont une fin de tranche ou un réveil
+ * dépasserait INT32_MAX s'arrête en erreur (voir TP::instantFutur).
+ *
+ * @return 0 si l'exécution se fait correctement, 1 sinon
+ */
+int main(int argc, char* argv[]) {
+    try {
+        return lancer(argc, argv);
+    } catch (const overflow_error& e) {
+        cerr << "erreur : " << e.what() << "." << endl;
+        return 1;
+    }
+}
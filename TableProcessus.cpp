@@ -0,0 +1,498 @@
+#include "TableProcessus.h"
+#include "ContratException.h"
+#include <algorithm>
+#include "ContratModule.h"
+
+/**
+ * @brief construit la table à partir d'une file de processus.
+ * @param f_entree file des processus, dans l'ordre du fichier.
+ */
+TP::TableProcessus::TableProcessus(queue<Processus> f_entree) {
+    reserver(f_entree.size());
+    while (!f_entree.empty()) {
+        const Processus& p = f_entree.front();
+        ajouter(p.getPid(), p.getArrivee(), p.getDuree(), p.getPriorite(), p.getType());
+        f_entree.pop();
+    }
+}
+
+/**
+ * @brief crée une table vide en mode flux.
+ */
+TP::TableProcessus TP::TableProcessus::pourFlux() {
+    TableProcessus table;
+    table.m_flux = true;
+    return table;
+}
+
+/**
+ * @brief admet un processus dans une table en mode flux, en recyclant une case libre si possible.
+ * @return identifiant de la case occupée.
+ * \pre la table est en mode flux
+ * \pre arrivee >= 0, duree > 0, priorite >= 0, echeance >= 0
+ * \pre rafalesValides(rafales, duree)
+ */
+TP::IdProcessus TP::TableProcessus::admettre(string_view pid, int arrivee, int duree, int priorite,
+                                             TypeProcessus type, int echeance, span<const int32_t> rafales) {
+    PRECONDITION(m_flux);
+    PRECONDITION(arrivee >= 0);
+    PRECONDITION(duree > 0);
+    PRECONDITION(priorite >= 0);
+    PRECONDITION(echeance >= 0);
+    PRECONDITION(rafalesValides(rafales, duree));
+
+    IdProcessus id;
+    if (m_casesLibres.empty()) {
+        PRECONDITION(taille() < UINT32_MAX);
+        id = static_cast<IdProcessus>(taille());
+        m_pid.push_back(0);
+        m_arrivee.push_back(arrivee);
+        m_duree.push_back(duree);
+        m_priorite.push_back(priorite);
+        m_type.push_back(static_cast<uint8_t>(type));
+        m_echeance.push_back(echeance);
+        m_restant.push_back(duree);
+        m_attente.push_back(0);
+        m_fin.push_back(0);
+        m_premierDemarrage.push_back(0);
+        m_nbTranches.push_back(0);
+        m_nomsCases.emplace_back(pid);
+        m_rafalesCases.emplace_back();
+        m_rafaleCourante.push_back(0);
+        m_rangs.push_back(static_cast<uint32_t>(m_admissions++));
+    } else {
+        id = m_casesLibres.back();
+        m_casesLibres.pop_back();
+        m_arrivee.remplacer(id, arrivee);
+        m_duree.remplacer(id, duree);
+        m_priorite.remplacer(id, priorite);
+        m_type.remplacer(id, static_cast<uint8_t>(type));
+        m_echeance.remplacer(id, echeance);
+        m_restant[id] = duree;
+        m_attente[id] = 0;
+        m_fin[id] = 0;
+        m_premierDemarrage[id] = 0;
+        m_nbTranches[id] = 0;
+        m_nomsCases[id].assign(pid); // réutilise la capacité de la chaîne
+        m_rafalesCases[id].clear();
+        m_rafaleCourante[id] = 0;
+        m_rangs.remplacer(id, static_cast<uint32_t>(m_admissions++));
+    }
+    convertirRafales(rafales, duree, m_rafalesCases[id]);
+    return id;
+}
+
+/**
+ * @brief rend la case d'un processus terminé pour une prochaine admission.
+ * \pre la table est en mode flux
+ */
+void TP::TableProcessus::liberer(IdProcessus id) {
+    PRECONDITION(m_flux);
+    PRECONDITION(id < taille());
+    m_casesLibres.push_back(id);
+}
+
+/**
+ * @brief ajoute un processus à la fin de la table.
+ * @param pid identifiant du processus, interné s'il n'a jamais été vu.
+ * @param arrivee temps d'arrivée du processus.
+ * @param duree durée d'exécution du processus.
+ * @param priorite priorité du processus.
+ * @param type type du processus.
+ * @param echeance délai relatif à l'arrivée, 0 si le processus n'a pas d'échéance.
+ * @param rafales durées alternées des rafales processeur et des E/S, de la première à la dernière
+ * rafale processeur ; vide pour une seule rafale de toute la durée.
+ * @return identifiant compact du processus ajouté.
+ * \pre arrivee >= 0
+ * \pre duree > 0
+ * \pre priorite >= 0
+ * \pre echeance >= 0
+ * \pre rafalesValides(rafales, duree)
+ * \pre la table contient moins de UINT32_MAX processus
+ * \pre les colonnes ne sont pas empruntées
+ */
+TP::IdProcessus TP::TableProcessus::ajouter(string_view pid, int arrivee, int duree, int priorite,
+                                            TypeProcessus type, int echeance, span<const int32_t> rafales) {
+    return ajouter(pid, hacherPid(pid), arrivee, duree, priorite, type, echeance, rafales);
+}
+
+/**
+ * @brief ajoute un processus dont le hachage du pid est déjà connu.
+ * \pre hachage == hacherPid(pid)
+ */
+TP::IdProcessus TP::TableProcessus::ajouter(string_view pid, size_t hachage, int arrivee, int duree,
+                                            int priorite, TypeProcessus type, int echeance,
+                                            span<const int32_t> rafales) {
+    PRECONDITION(arrivee >= 0);
+    PRECONDITION(duree > 0);
+    PRECONDITION(priorite >= 0);
+    PRECONDITION(echeance >= 0);
+    PRECONDITION(rafalesValides(rafales, duree));
+    PRECONDITION(taille() < UINT32_MAX);
+    PRECONDITION(!estEmpruntee());
+    PRECONDITION(!m_flux);
+
+    IdProcessus id = static_cast<IdProcessus>(taille());
+    m_pid.push_back(internerPid(pid, hachage));
+    m_arrivee.push_back(arrivee);
+    m_duree.push_back(duree);
+    m_priorite.push_back(priorite);
+    m_type.push_back(static_cast<uint8_t>(type));
+    m_echeance.push_back(echeance);
+    m_restant.push_back(duree);
+    m_attente.push_back(0);
+    m_fin.push_back(0);
+    m_premierDemarrage.push_back(0);
+    m_nbTranches.push_back(0);
+    ajouterRafales(id, duree, rafales);
+
+    POSTCONDITION(this->pid(id) == pid);
+    return id;
+}
+
+/**
+ * @brief range les E/S du processus qui vient d'être ajouté ; les colonnes des E/S ne sont
+ * créées qu'au premier processus qui en a.
+ */
+void TP::TableProcessus::ajouterRafales(IdProcessus id, int duree, span<const int32_t> rafales) {
+    if (m_debutsRafales.empty()) {
+        if (rafales.empty()) {
+            return;
+        }
+        m_debutsRafales.reserve(m_restant.capacity() + 1);
+        for (size_t i = 0; i <= id; ++i) {
+            m_debutsRafales.push_back(0); // les processus précédents n'ont pas d'E/S
+        }
+        m_rafaleCourante.reserve(m_restant.capacity());
+        m_rafaleCourante.assign(id, 0);
+    }
+    convertirRafales(rafales, duree, m_rafales);
+    m_debutsRafales.push_back(m_rafales.size());
+    m_rafaleCourante.push_back(0);
+}
+
+bool TP::TableProcessus::rafalesValides(span<const int32_t> rafales, int duree) {
+    if (rafales.empty()) {
+        return true;
+    }
+    if (rafales.size() < 3 || rafales.size() % 2 == 0) {
+        return false;
+    }
+    int64_t processeur = 0;
+    int64_t entreesSorties = 0;
+    for (size_t i = 0; i < rafales.size(); ++i) {
+        if (rafales[i] <= 0) {
+            return false;
+        }
+        (i % 2 == 0 ? processeur : entreesSorties) += rafales[i];
+    }
+    return processeur == duree && entreesSorties <= INT32_MAX;
+}
+
+/**
+ * @brief réserve la place pour n processus dans chaque colonne.
+ * @param n nombre de processus attendus.
+ */
+void TP::TableProcessus::reserver(size_t n) {
+    m_pid.reserve(n);
+    m_arrivee.reserve(n);
+    m_duree.reserve(n);
+    m_priorite.reserve(n);
+    m_type.reserve(n);
+    m_echeance.reserve(n);
+    m_restant.reserve(n);
+    m_attente.reserve(n);
+    m_fin.reserve(n);
+    m_premierDemarrage.reserve(n);
+    m_nbTranches.reserve(n);
+    if (!m_debutsRafales.empty()) {
+        m_debutsRafales.reserve(n + 1);
+        m_rafaleCourante.reserve(n);
+    }
+    while (m_indexNoms.size() < 2 * n) {
+        agrandirIndex();
+    }
+}
+
+/**
+ * @brief remplace le contenu de la table par des colonnes externes, sans les copier.
+ *
+ * seules les colonnes modifiées par la simulation sont allouées ; le temps restant part
+ * de la durée. L'index des pids n'est pas construit : la table empruntée est en lecture. Une
+ * trace sans échéances reçoit une colonne d'échéances nulles ; une trace sans E/S n'en a aucune.
+ * @param source propriétaire de la mémoire des colonnes, gardé vivant par la table.
+ * @param colonnes vues sur les colonnes d'entrée.
+ */
+void TP::TableProcessus::emprunter(shared_ptr<const void> source, const ColonnesTrace& colonnes) {
+    PRECONDITION(source != nullptr);
+    PRECONDITION(colonnes.nbProcessus < UINT32_MAX);
+
+    m_source = std::move(source);
+    m_flux = false;
+    m_rangs = Colonne<uint32_t>();
+    m_octetsNoms.emprunter(colonnes.octetsNoms, colonnes.debutsNoms[colonnes.nbNoms]);
+    m_debutsNoms.emprunter(colonnes.debutsNoms, colonnes.nbNoms + 1);
+    m_hachagesNoms.clear();
+    m_indexNoms.clear();
+
+    m_pid.emprunter(colonnes.pid, colonnes.nbProcessus);
+    m_arrivee.emprunter(colonnes.arrivee, colonnes.nbProcessus);
+    m_duree.emprunter(colonnes.duree, colonnes.nbProcessus);
+    m_priorite.emprunter(colonnes.priorite, colonnes.nbProcessus);
+    m_type.emprunter(colonnes.type, colonnes.nbProcessus);
+    if (colonnes.echeance != nullptr) {
+        m_echeance.emprunter(colonnes.echeance, colonnes.nbProcessus);
+    } else {
+        m_echeance = Colonne<int32_t>();
+        vector<int32_t> aucune(colonnes.nbProcessus, 0);
+        m_echeance.append(aucune.data(), aucune.size());
+    }
+    if (colonnes.debutsRafales != nullptr) {
+        m_debutsRafales.emprunter(colonnes.debutsRafales, colonnes.nbProcessus + 1);
+        m_rafales.emprunter(colonnes.rafales, colonnes.nbValeursRafales);
+        m_rafaleCourante.assign(colonnes.nbProcessus, 0);
+    } else {
+        m_debutsRafales = Colonne<uint64_t>();
+        m_rafales = Colonne<int32_t>();
+        m_rafaleCourante.clear();
+    }
+    m_restant.assign(colonnes.duree, colonnes.duree + colonnes.nbProcessus);
+    m_attente.assign(colonnes.nbProcessus, 0);
+    m_fin.assign(colonnes.nbProcessus, 0);
+    m_premierDemarrage.assign(colonnes.nbProcessus, 0);
+    m_nbTranches.assign(colonnes.nbProcessus, 0);
+
+    INVARIANTS();
+}
+
+/**
+ * @brief donne une vue brute sur les colonnes d'entrée, valide tant que la table n'est pas modifiée.
+ */
+/**
+ * @brief crée une table qui partage en lecture seule les colonnes d'entrée d'une autre.
+ * @param source table partagée, gardée vivante tant que la nouvelle table l'est.
+ * \pre source n'est pas en mode flux
+ */
+TP::TableProcessus TP::TableProcessus::partager(shared_ptr<const TableProcessus> source) {
+    PRECONDITION(source != nullptr);
+    PRECONDITION(!source->estFlux());
+
+    TableProcessus table;
+    ColonnesTrace colonnes = source->colonnes();
+    const Colonne<uint32_t>& rangs = source->m_rangs;
+    bool classee = source->rangsDisponibles() && !source->estVide();
+    table.emprunter(std::move(source), colonnes);
+    if (classee) {
+        table.m_rangs.emprunter(rangs.data(), rangs.size());
+    }
+    return table;
+}
+
+TP::ColonnesTrace TP::TableProcessus::colonnes() const {
+    static const uint64_t AUCUN_NOM[1] = {0};
+    return {taille(), m_debutsNoms.empty() ? 0 : m_debutsNoms.size() - 1,
+            m_debutsNoms.empty() ? AUCUN_NOM : m_debutsNoms.data(), m_octetsNoms.data(),
+            m_pid.data(), m_arrivee.data(), m_duree.data(), m_priorite.data(), m_type.data(), m_echeance.data(),
+            m_rafales.size(), m_debutsRafales.empty() ? nullptr : m_debutsRafales.data(), m_rafales.data()};
+}
+
+bool TP::TableProcessus::aEcheances() const {
+    return any_of(m_echeance.data(), m_echeance.data() + m_echeance.size(), [](int32_t e) { return e != 0; });
+}
+
+int TP::TableProcessus::tempsEntreesSorties(IdProcessus id) const {
+    span<const int32_t> es = entreesSorties(id);
+    int total = 0;
+    for (size_t k = 1; k < es.size(); k += 2) {
+        total += es[k];
+    }
+    return total;
+}
+
+bool TP::TableProcessus::aEntreesSorties() const {
+    if (m_flux) {
+        return any_of(m_rafalesCases.begin(), m_rafalesCases.end(), [](const vector<int32_t>& es) {
+            return !es.empty();
+        });
+    }
+    return !m_debutsRafales.empty() && m_debutsRafales[taille()] != 0;
+}
+
+/**
+ * @brief le processus élu a terminé sa rafale processeur : l'E/S suivante commence.
+ * @return durée de l'E/S.
+ * \pre restant(id) == finRafale(id) > 0
+ */
+int TP::TableProcessus::commencerEntreeSortie(IdProcessus id) {
+    PRECONDITION(finRafale(id) > 0 && restant(id) == finRafale(id));
+    return entreesSorties(id)[2 * size_t(m_rafaleCourante[id]++) + 1];
+}
+
+/**
+ * @brief retourne le numéro du pid, en l'ajoutant à la suite des noms s'il est nouveau.
+ * @param pid pid à interner.
+ * @param hachage hachage du pid.
+ */
+uint32_t TP::TableProcessus::internerPid(string_view pid, size_t hachage) {
+    size_t nbNoms = m_hachagesNoms.size();
+    if (2 * (nbNoms + 1) > m_indexNoms.size()) {
+        agrandirIndex(); // facteur de charge maximal de 1/2
+    }
+
+    size_t masque = m_indexNoms.size() - 1;
+    for (size_t i = hachage & masque;; i = (i + 1) & masque) {
+        uint32_t occupant = m_indexNoms[i];
+        if (occupant == 0) {
+            if (m_debutsNoms.empty()) {
+                m_debutsNoms.push_back(0);
+            }
+            m_octetsNoms.append(pid.data(), pid.size());
+            m_debutsNoms.push_back(m_octetsNoms.size());
+            m_hachagesNoms.push_back(hachage);
+            m_indexNoms[i] = static_cast<uint32_t>(nbNoms + 1);
+            return static_cast<uint32_t>(nbNoms);
+        }
+        if (m_hachagesNoms[occupant - 1] == hachage && nom(occupant - 1) == pid) {
+            return occupant - 1;
+        }
+    }
+}
+
+/**
+ * @brief double la taille de l'index des pids et y replace chaque nom.
+ */
+void TP::TableProcessus::agrandirIndex() {
+    vector<uint32_t> index(max<size_t>(16, 2 * m_indexNoms.size()), 0);
+    size_t masque = index.size() - 1;
+    for (uint32_t numero = 0; numero < m_hachagesNoms.size(); ++numero) {
+        size_t i = m_hachagesNoms[numero] & masque;
+        while (index[i] != 0) {
+            i = (i + 1) & masque;
+        }
+        index[i] = numero + 1;
+    }
+    m_indexNoms = std::move(index);
+}
+
+/**
+ * @brief Définit le temps restant d'un processus.
+ * \pre restant >= 0
+ */
+void TP::TableProcessus::setRestant(IdProcessus id, int restant) {
+    PRECONDITION(restant >= 0);
+    m_restant[id] = restant;
+}
+
+/**
+ * @brief Définit le temps d'attente d'un processus.
+ * \pre attente >= 0
+ */
+void TP::TableProcessus::setAttente(IdProcessus id, int attente) {
+    PRECONDITION(attente >= 0);
+    m_attente[id] = attente;
+}
+
+/**
+ * @brief rétablit les colonnes d'un processus modifiées par la simulation, telles qu'un instantané
+ * les a gardées.
+ * \pre 0 <= restant <= duree(id)
+ * \pre rafaleCourante ne dépasse pas le nombre d'E/S du processus
+ */
+void TP::TableProcessus::restaurer(IdProcessus id, int restant, int attente, int fin, int premierDemarrage,
+                                   uint32_t nbTranches, uint32_t rafaleCourante) {
+    PRECONDITION(restant >= 0 && restant <= duree(id));
+    PRECONDITION(2 * size_t(rafaleCourante) <= entreesSorties(id).size());
+
+    m_restant[id] = restant;
+    m_attente[id] = attente;
+    m_fin[id] = fin;
+    m_premierDemarrage[id] = premierDemarrage;
+    m_nbTranches[id] = nbTranches;
+    if (!m_rafaleCourante.empty()) {
+        m_rafaleCourante[id] = rafaleCourante;
+    }
+}
+
+/**
+ * @brief Définit le temps de fin d'un processus.
+ * \pre fin >= 0
+ */
+void TP::TableProcessus::setFin(IdProcessus id, int fin) {
+    PRECONDITION(fin >= 0);
+    m_fin[id] = fin;
+}
+
+/**
+ * @brief classe les pids distincts une seule fois et donne le rang de chaque processus.
+ *
+ * deux processus de même pid ont le même rang.
+ * @return rang lexicographique du pid de chaque processus.
+ */
+vector<uint32_t> TP::TableProcessus::rangsPid() const {
+    size_t nbNoms = m_debutsNoms.empty() ? 0 : m_debutsNoms.size() - 1;
+    vector<uint32_t> ordre(nbNoms);
+    for (uint32_t i = 0; i < ordre.size(); ++i) {
+        ordre[i] = i;
+    }
+    sort(ordre.begin(), ordre.end(), [this](uint32_t a, uint32_t b) {
+        return nom(a) < nom(b);
+    });
+
+    vector<uint32_t> rangNom(nbNoms);
+    for (uint32_t r = 0; r < ordre.size(); ++r) {
+        rangNom[ordre[r]] = r;
+    }
+
+    vector<uint32_t> rang(taille());
+    for (size_t id = 0; id < rang.size(); ++id) {
+        rang[id] = rangNom[m_pid[id]];
+    }
+    return rang;
+}
+
+/**
+ * @brief calcule le rang lexicographique du pid de chaque processus, lu ensuite par rang().
+ */
+void TP::TableProcessus::classerPids() {
+    if (m_flux) {
+        return; // le rang d'admission tient lieu de rang
+    }
+    vector<uint32_t> rangs = rangsPid();
+    m_rangs = Colonne<uint32_t>();
+    m_rangs.append(rangs.data(), rangs.size());
+    POSTCONDITION(rangsDisponibles());
+}
+
+/**
+ * @brief reconstruit le processus d'une ligne de la table avec son état courant.
+ * @param id identifiant du processus.
+ * @return une copie autonome du processus.
+ */
+Processus TP::TableProcessus::versProcessus(IdProcessus id) const {
+    Processus p(string(pid(id)), arrivee(id), duree(id), priorite(id), type(id));
+    p.setRestant(restant(id));
+    p.setAttente(attente(id));
+    p.setFin(fin(id));
+    return p;
+}
+
+/**
+ * \brief Vérifie les invariants de la table : toutes les colonnes ont la même taille.
+ */
+void TP::TableProcessus::verifieInvariant() const {
+    INVARIANT(m_arrivee.size() == m_pid.size());
+    INVARIANT(m_duree.size() == m_pid.size());
+    INVARIANT(m_priorite.size() == m_pid.size());
+    INVARIANT(m_type.size() == m_pid.size());
+    INVARIANT(m_echeance.size() == m_pid.size());
+    INVARIANT(m_restant.size() == m_pid.size());
+    INVARIANT(m_attente.size() == m_pid.size());
+    INVARIANT(m_fin.size() == m_pid.size());
+    INVARIANT(m_premierDemarrage.size() == m_pid.size());
+    INVARIANT(m_nbTranches.size() == m_pid.size());
+    INVARIANT(m_debutsRafales.empty() || m_debutsRafales.size() == m_pid.size() + 1);
+    INVARIANT(m_rafaleCourante.empty() || m_rafaleCourante.size() == m_pid.size());
+    INVARIANT(estEmpruntee() || 2 * m_hachagesNoms.size() <= m_indexNoms.size());
+    INVARIANT(!m_flux || m_nomsCases.size() == m_pid.size());
+    INVARIANT(!m_flux || (m_rafalesCases.size() == m_pid.size() && m_rafaleCourante.size() == m_pid.size()));
+}
@@ -0,0 +1,276 @@
+#include "processus.h"
+#include "Colonne.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+// TableProcessus.h
+#ifndef TABLEPROCESSUS_H
+#define TABLEPROCESSUS_H
+
+namespace TP {
+
+    // identifiant compact d'un processus : son rang dans la table
+    using IdProcessus = uint32_t;
+
+    // valeur sentinelle : aucun processus
+    constexpr IdProcessus AUCUN_PROCESSUS = UINT32_MAX;
+
+    // échéance absolue d'un processus qui n'en a pas : après toutes les autres
+    constexpr int64_t SANS_ECHEANCE = INT64_MAX;
+
+    // vue brute sur les colonnes d'entrée d'une table, pour l'écriture ou l'emprunt d'une trace
+    struct ColonnesTrace {
+        size_t nbProcessus;
+        size_t nbNoms;
+        const uint64_t* debutsNoms; // nbNoms + 1 positions dans octetsNoms
+        const char* octetsNoms;     // pids distincts mis bout à bout
+        const uint32_t* pid;        // numéro du pid de chaque processus
+        const int32_t* arrivee;
+        const int32_t* duree;
+        const int32_t* priorite;
+        const uint8_t* type;
+        const int32_t* echeance;    // nullptr si la trace n'a pas d'échéances
+        size_t nbValeursRafales;
+        const uint64_t* debutsRafales; // nbProcessus + 1 positions dans rafales, nullptr sans E/S
+        const int32_t* rafales;     // deux valeurs par E/S (voir TableProcessus::entreesSorties)
+    };
+
+    // compte rendu compact d'un processus terminé, remis aux puits au lieu d'une copie de Processus
+    struct Terminaison {
+        IdProcessus id;
+        int arrivee;
+        int duree;
+        int premierDemarrage;   // instant de sa première élection
+        int fin;                // instant de sa terminaison
+        int attente;            // attente du processeur, hors entrées-sorties
+        uint32_t nbTranches;    // nombre de fois où il a été élu
+        int entreesSorties;     // temps passé en entrées-sorties
+    };
+
+    /**
+     * @brief table des processus en colonnes parallèles (structure de tableaux).
+     *
+     * les pids sont internés au chargement : chaque chaîne distincte n'est stockée qu'une fois
+     * et chaque processus ne garde qu'un entier de 32 bits. Un processus occupe ainsi 45 octets
+     * répartis dans des colonnes contiguës (21 d'entrée, 20 modifiés par la simulation et 4 pour
+     * son rang de départage), plus 12 octets et 8 par E/S si la table a des E/S ; chaque pid
+     * distinct s'y ajoute une fois. Les ordonnanceurs ne comparent que des entiers.
+     *
+     * un processus est une suite de rafales processeur séparées par des entrées-sorties (E/S) ;
+     * sa durée est le total de ses rafales processeur. Les E/S ne sont stockées que si la table
+     * en a : une table dont chaque processus n'a qu'une rafale n'en paie rien.
+     *
+     * les colonnes d'entrée peuvent aussi être empruntées à un fichier projeté en mémoire ;
+     * seules les colonnes modifiées par la simulation sont alors allouées.
+     *
+     * en mode flux, les cases des processus terminés sont recyclées : la taille de la table
+     * reste bornée par le nombre de processus présents en même temps dans le système.
+     */
+    class TableProcessus {
+    public:
+        TableProcessus() = default;
+        explicit TableProcessus(queue<Processus> f_entree);
+
+        // table vide dont les cases sont recyclées (mode flux)
+        static TableProcessus pourFlux();
+        bool estFlux() const { return m_flux; }
+
+        // mode flux : occupe une case libre, ou une nouvelle case
+        IdProcessus admettre(string_view pid, int arrivee, int duree, int priorite, TypeProcessus type,
+                             int echeance = 0, span<const int32_t> rafales = {});
+        // mode flux : rend la case d'un processus terminé
+        void liberer(IdProcessus id);
+
+        // echeance : délai relatif à l'arrivée, 0 si le processus n'a pas d'échéance ;
+        // rafales : durées alternées processeur, E/S, ..., processeur, vide pour une seule rafale
+        IdProcessus ajouter(string_view pid, int arrivee, int duree, int priorite, TypeProcessus type,
+                            int echeance = 0, span<const int32_t> rafales = {});
+        // variante pour un chargeur qui a déjà calculé hacherPid(pid), par exemple en parallèle
+        IdProcessus ajouter(string_view pid, size_t hachage, int arrivee, int duree, int priorite,
+                            TypeProcessus type, int echeance = 0, span<const int32_t> rafales = {});
+        static size_t hacherPid(string_view pid) { return hash<string_view>()(pid); }
+        // vrai si les rafales sont vides, ou en nombre impair d'au moins trois, toutes positives,
+        // et si les rafales processeur totalisent la durée
+        static bool rafalesValides(span<const int32_t> rafales, int duree);
+        // ajoute à es les E/S des rafales, au format de entreesSorties()
+        template<typename Destination>
+        static void convertirRafales(span<const int32_t> rafales, int duree, Destination& es) {
+            int32_t restant = duree;
+            for (size_t i = 0; i + 1 < rafales.size(); i += 2) {
+                restant -= rafales[i];
+                es.push_back(restant);
+                es.push_back(rafales[i + 1]);
+            }
+        }
+        void reserver(size_t n);
+
+        // remplace le contenu par les colonnes données, gardées vivantes par source
+        void emprunter(shared_ptr<const void> source, const ColonnesTrace& colonnes);
+
+        /**
+         * table qui emprunte les colonnes d'entrée de source, et ses rangs s'ils sont classés :
+         * plusieurs simulations concurrentes partagent ainsi une seule copie de la charge, chacune
+         * n'allouant que les colonnes qu'elle modifie.
+         */
+        static TableProcessus partager(shared_ptr<const TableProcessus> source);
+        bool estEmpruntee() const { return m_source != nullptr; }
+        ColonnesTrace colonnes() const;
+
+        // nombre de cases de la table (en mode flux, y compris les cases libres)
+        size_t taille() const { return m_arrivee.size(); }
+        bool estVide() const { return m_arrivee.empty(); }
+
+        // colonnes en lecture
+        string_view pid(IdProcessus id) const { return m_flux ? string_view(m_nomsCases[id]) : nom(m_pid[id]); }
+        uint32_t idPid(IdProcessus id) const { return m_pid[id]; }
+        int arrivee(IdProcessus id) const { return m_arrivee[id]; }
+        int duree(IdProcessus id) const { return m_duree[id]; }
+        int restant(IdProcessus id) const { return m_restant[id]; }
+        int attente(IdProcessus id) const { return m_attente[id]; }
+        int fin(IdProcessus id) const { return m_fin[id]; }
+        int premierDemarrage(IdProcessus id) const { return m_premierDemarrage[id]; }
+        uint32_t nbTranches(IdProcessus id) const { return m_nbTranches[id]; }
+        int priorite(IdProcessus id) const { return m_priorite[id]; }
+        TypeProcessus type(IdProcessus id) const { return static_cast<TypeProcessus>(m_type[id]); }
+        // délai relatif à l'arrivée, 0 si le processus n'a pas d'échéance
+        int echeance(IdProcessus id) const { return m_echeance[id]; }
+        // instant où le processus doit être terminé, SANS_ECHEANCE s'il n'en a pas
+        int64_t echeanceAbsolue(IdProcessus id) const {
+            return m_echeance[id] == 0 ? SANS_ECHEANCE : int64_t(m_arrivee[id]) + m_echeance[id];
+        }
+        // vrai si au moins un processus de la table a une échéance
+        bool aEcheances() const;
+
+        /**
+         * E/S du processus, deux valeurs par E/S : le temps restant du processus quand elle
+         * commence, puis sa durée. Vide pour un processus d'une seule rafale processeur.
+         */
+        span<const int32_t> entreesSorties(IdProcessus id) const {
+            if (m_flux) {
+                return m_rafalesCases[id];
+            }
+            if (m_debutsRafales.empty()) {
+                return {};
+            }
+            return {m_rafales.data() + m_debutsRafales[id], m_debutsRafales[id + 1] - m_debutsRafales[id]};
+        }
+        // temps total que le processus passe en E/S
+        int tempsEntreesSorties(IdProcessus id) const;
+        // vrai si au moins un processus de la table a des E/S
+        bool aEntreesSorties() const;
+
+        // colonnes modifiées par la simulation
+        void setRestant(IdProcessus id, int restant);
+        void setAttente(IdProcessus id, int attente);
+        void setFin(IdProcessus id, int fin);
+        // le processus est élu pour une nouvelle tranche à l'instant temps
+        void demarrerTranche(IdProcessus id, int temps) {
+            if (m_nbTranches[id]++ == 0) {
+                m_premierDemarrage[id] = temps;
+            }
+        }
+
+        // E/S déjà commencées par le processus
+        uint32_t rafaleCourante(IdProcessus id) const { return m_rafaleCourante.empty() ? 0 : m_rafaleCourante[id]; }
+
+        // reprise d'un instantané : rétablit les colonnes du processus modifiées par la simulation
+        void restaurer(IdProcessus id, int restant, int attente, int fin, int premierDemarrage, uint32_t nbTranches,
+                       uint32_t rafaleCourante);
+
+        // temps restant auquel la rafale processeur en cours se termine, 0 pour la dernière
+        int finRafale(IdProcessus id) const {
+            if (m_rafaleCourante.empty()) {
+                return 0;
+            }
+            span<const int32_t> es = entreesSorties(id);
+            size_t k = 2 * size_t(m_rafaleCourante[id]);
+            return k < es.size() ? es[k] : 0;
+        }
+        // le processus termine sa rafale processeur et commence l'E/S suivante, dont la durée est retournée
+        int commencerEntreeSortie(IdProcessus id);
+
+        // compte rendu d'un processus terminé
+        Terminaison terminaison(IdProcessus id) const {
+            return {id, arrivee(id), duree(id), m_premierDemarrage[id], m_fin[id], m_attente[id], m_nbTranches[id],
+                    tempsEntreesSorties(id)};
+        }
+
+        // rang de chaque processus dans l'ordre lexicographique des pids, pour départager les égalités
+        vector<uint32_t> rangsPid() const;
+
+        /**
+         * rang de départage des égalités, lu par les politiques dans leurs clés : rang lexicographique
+         * du pid une fois classerPids() appelée, ou ordre d'admission en mode flux (le rang des
+         * pids futurs n'y est pas connu).
+         */
+        uint64_t rang(IdProcessus id) const {
+            if (!m_flux) {
+                return m_rangs[id];
+            }
+            // seuls les 32 bits de poids faible de l'admission sont gardés : elle est retrouvée à
+            // partir du compteur, un processus présent ayant été admis moins de 2^32 admissions plus tôt
+            return m_admissions - uint32_t(uint32_t(m_admissions) - m_rangs[id]);
+        }
+        bool rangsDisponibles() const { return m_flux || m_rangs.size() == taille(); }
+        void classerPids();
+
+        // reconstruit l'objet Processus d'une ligne, pour l'affichage
+        Processus versProcessus(IdProcessus id) const;
+
+        void verifieInvariant() const;
+
+    private:
+        string_view nom(uint32_t numero) const {
+            return {m_octetsNoms.data() + m_debutsNoms[numero], m_debutsNoms[numero + 1] - m_debutsNoms[numero]};
+        }
+        uint32_t internerPid(string_view pid, size_t hachage);
+        void agrandirIndex();
+        void ajouterRafales(IdProcessus id, int duree, span<const int32_t> rafales);
+
+        shared_ptr<const void> m_source; // mémoire des colonnes empruntées
+
+        // mode flux
+        bool m_flux = false;
+        vector<IdProcessus> m_casesLibres;
+        vector<string> m_nomsCases;      // pid de chaque case, sans internement
+        vector<vector<int32_t>> m_rafalesCases; // E/S de chaque case
+        uint64_t m_admissions = 0;       // processus admis depuis le début du flux
+
+        Colonne<uint32_t> m_rangs;       // voir rang() ; en mode flux, l'admission modulo 2^32
+
+        // internement des pids : les noms distincts sont mis bout à bout, m_debutsNoms donne
+        // la position de chacun (avec une sentinelle finale)
+        Colonne<char> m_octetsNoms;
+        Colonne<uint64_t> m_debutsNoms;
+        vector<size_t> m_hachagesNoms;
+        // index à adressage ouvert (sondage linéaire) : numéro de nom + 1, 0 pour une case vide
+        vector<uint32_t> m_indexNoms;
+
+        // une colonne par attribut, toutes de la même taille
+        Colonne<uint32_t> m_pid;
+        Colonne<int32_t> m_arrivee;
+        Colonne<int32_t> m_duree;
+        Colonne<int32_t> m_priorite;
+        Colonne<uint8_t> m_type;
+        Colonne<int32_t> m_echeance;
+        // E/S : vides si aucun processus n'en a, sinon taille() + 1 positions dans m_rafales
+        Colonne<uint64_t> m_debutsRafales;
+        Colonne<int32_t> m_rafales;
+        vector<int32_t> m_restant;
+        vector<int32_t> m_attente;
+        vector<int32_t> m_fin;
+        vector<int32_t> m_premierDemarrage;
+        vector<uint32_t> m_nbTranches;
+        vector<uint32_t> m_rafaleCourante; // E/S commencées, vide si la table n'en a pas
+    };
+
+} // namespace TP
+
+#endif // TABLEPROCESSUS_H
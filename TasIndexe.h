@@ -0,0 +1,183 @@
+#include "ContratException.h"
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// TasIndexe.h
+#ifndef TASINDEXE_H
+#define TASINDEXE_H
+
+namespace TP {
+
+    /**
+     * @brief tas binaire adressable : chaque élément est un indice de processus dont la clé
+     * peut être modifiée en O(log n) sans reconstruire le tas.
+     *
+     * position(indice) donne la case de l'indice dans m_tas, ou AUCUNE s'il est absent. Les positions
+     * sont rangées par pages allouées seulement autour des indices présents, et recyclées quand elles
+     * se vident : un petit tas qui voit passer des indices quelconques (une file par processeur en
+     * multiprocesseur, des cases recyclées en mode flux) reste petit.
+     */
+    template<typename Cle, typename Compare = less<Cle>>
+    class TasIndexe {
+    public:
+        static constexpr size_t AUCUNE = static_cast<size_t>(-1);
+
+        explicit TasIndexe(size_t capacite = 0) {
+            m_tas.reserve(capacite);
+            m_pages.reserve((capacite >> BITS_PAGE) + 1);
+        }
+
+        bool estVide() const { return m_tas.empty(); }
+        size_t taille() const { return m_tas.size(); }
+
+        bool contient(size_t indice) const {
+            size_t page = indice >> BITS_PAGE;
+            return page < m_pages.size() && m_pages[page] != nullptr && position(indice) != AUCUNE;
+        }
+
+        const Cle& cle(size_t indice) const {
+            PRECONDITION(contient(indice));
+            return m_tas[position(indice)].cle;
+        }
+
+        // indice de plus petite clé
+        size_t sommet() const {
+            PRECONDITION(!m_tas.empty());
+            return m_tas.front().indice;
+        }
+
+        void inserer(size_t indice, const Cle& cle) {
+            PRECONDITION(!contient(indice));
+            occuperPage(indice >> BITS_PAGE);
+            m_tas.push_back({cle, indice});
+            position(indice) = m_tas.size() - 1;
+            monter(m_tas.size() - 1);
+        }
+
+        // remplace la clé d'un indice présent, dans un sens ou dans l'autre
+        void modifierCle(size_t indice, const Cle& cle) {
+            PRECONDITION(contient(indice));
+            size_t i = position(indice);
+            m_tas[i].cle = cle;
+            monter(i);
+            descendre(position(indice));
+        }
+
+        void retirer(size_t indice) {
+            PRECONDITION(contient(indice));
+            size_t i = position(indice);
+            echanger(i, m_tas.size() - 1);
+            m_tas.pop_back();
+            position(indice) = AUCUNE;
+            libererPage(indice >> BITS_PAGE);
+            if (i < m_tas.size()) {
+                monter(i);
+                descendre(position(m_tas[i].indice));
+            }
+        }
+
+        size_t extraire() {
+            size_t indice = sommet();
+            retirer(indice);
+            return indice;
+        }
+
+        // appelle f(indice, cle) dans l'ordre du tableau du tas : réinsérés dans cet ordre, les
+        // indices redonnent le même tas
+        template<typename Fonction>
+        void parcourir(Fonction f) const {
+            for (const Noeud& noeud : m_tas) {
+                f(noeud.indice, noeud.cle);
+            }
+        }
+
+    private:
+        struct Noeud {
+            Cle cle;
+            size_t indice;
+        };
+
+        static constexpr size_t BITS_PAGE = 10;
+
+        size_t& position(size_t indice) { return m_pages[indice >> BITS_PAGE][indice & ((1 << BITS_PAGE) - 1)]; }
+        size_t position(size_t indice) const {
+            return m_pages[indice >> BITS_PAGE][indice & ((1 << BITS_PAGE) - 1)];
+        }
+
+        // compte un indice de plus dans la page, en l'allouant (ou en reprenant une page libre) au besoin
+        void occuperPage(size_t page) {
+            if (page >= m_pages.size()) {
+                m_pages.resize(page + 1);
+                m_occupation.resize(page + 1, 0);
+            }
+            if (m_pages[page] == nullptr) {
+                if (m_pagesLibres.empty()) {
+                    m_pages[page].reset(new size_t[size_t(1) << BITS_PAGE]);
+                    fill_n(m_pages[page].get(), size_t(1) << BITS_PAGE, AUCUNE);
+                } else {
+                    m_pages[page] = std::move(m_pagesLibres.back());
+                    m_pagesLibres.pop_back();
+                }
+            }
+            ++m_occupation[page];
+        }
+
+        // une page vidée (toutes ses positions à AUCUNE) est gardée pour être réutilisée
+        void libererPage(size_t page) {
+            if (--m_occupation[page] == 0) {
+                m_pagesLibres.push_back(std::move(m_pages[page]));
+            }
+        }
+
+        void echanger(size_t i, size_t j) {
+            swap(m_tas[i], m_tas[j]);
+            position(m_tas[i].indice) = i;
+            position(m_tas[j].indice) = j;
+        }
+
+        void monter(size_t i) {
+            while (i > 0) {
+                size_t parent = (i - 1) / 2;
+                if (!m_compare(m_tas[i].cle, m_tas[parent].cle)) {
+                    break;
+                }
+                echanger(i, parent);
+                i = parent;
+            }
+        }
+
+        void descendre(size_t i) {
+            for (;;) {
+                size_t plusPetit = i;
+                size_t gauche = 2 * i + 1;
+                size_t droite = gauche + 1;
+                if (gauche < m_tas.size() && m_compare(m_tas[gauche].cle, m_tas[plusPetit].cle)) {
+                    plusPetit = gauche;
+                }
+                if (droite < m_tas.size() && m_compare(m_tas[droite].cle, m_tas[plusPetit].cle)) {
+                    plusPetit = droite;
+                }
+                if (plusPetit == i) {
+                    break;
+                }
+                echanger(i, plusPetit);
+                i = plusPetit;
+            }
+        }
+
+        vector<Noeud> m_tas;
+        vector<unique_ptr<size_t[]>> m_pages;  // pages de positions, nulles si aucun indice n'y est présent
+        vector<uint32_t> m_occupation;         // nombre d'indices présents dans chaque page
+        vector<unique_ptr<size_t[]>> m_pagesLibres;
+        Compare m_compare;
+    };
+
+} // namespace TP
+
+#endif // TASINDEXE_H
@@ -0,0 +1,405 @@
+#include "TraceBinaire.h"
+#include "FichierMappe.h"
+#include "ContratException.h"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include "ContratModule.h"
+
+namespace {
+
+    constexpr char MAGIE[4] = {'P', 'S', 'S', 'B'};
+
+    uint64_t aligner(uint64_t position) {
+        return (position + 7) & ~uint64_t(7);
+    }
+
+    // vrai si le bloc [position, position + octets) est dans le fichier et aligné pour T
+    template<typename T>
+    bool blocValide(uint64_t position, uint64_t nombre, size_t tailleFichier) {
+        return position % alignof(T) == 0 && position <= tailleFichier
+               && nombre <= (tailleFichier - position) / sizeof(T);
+    }
+
+    void ecrireBloc(ofstream& sortie, uint64_t position, const void* donnees, size_t octets) {
+        sortie.seekp(static_cast<streamoff>(position));
+        sortie.write(static_cast<const char*>(donnees), static_cast<streamsize>(octets));
+    }
+
+    // positions des blocs d'une trace de nbProcessus processus ayant chacun son pid ; le bloc des
+    // E/S, de taille encore inconnue, vient en dernier
+    TP::EnTeteTrace preparerEnTete(uint64_t nbProcessus, uint64_t nbNoms, uint64_t octetsNoms,
+                                   bool avecEntreesSorties) {
+        TP::EnTeteTrace entete{};
+        memcpy(entete.magie, MAGIE, sizeof(MAGIE));
+        entete.version = TP::VERSION_TRACE_BINAIRE;
+        entete.nbProcessus = nbProcessus;
+        entete.nbNoms = nbNoms;
+        entete.positionDebutsNoms = aligner(sizeof(TP::EnTeteTrace));
+        entete.positionOctetsNoms = entete.positionDebutsNoms + (nbNoms + 1) * sizeof(uint64_t);
+        entete.positionPid = aligner(entete.positionOctetsNoms + octetsNoms);
+        entete.positionArrivee = aligner(entete.positionPid + nbProcessus * sizeof(uint32_t));
+        entete.positionDuree = aligner(entete.positionArrivee + nbProcessus * sizeof(int32_t));
+        entete.positionPriorite = aligner(entete.positionDuree + nbProcessus * sizeof(int32_t));
+        entete.positionType = aligner(entete.positionPriorite + nbProcessus * sizeof(int32_t));
+        entete.positionEcheance = aligner(entete.positionType + nbProcessus * sizeof(uint8_t));
+        if (avecEntreesSorties) {
+            entete.positionDebutsRafales = aligner(entete.positionEcheance + nbProcessus * sizeof(int32_t));
+            entete.positionRafales = entete.positionDebutsRafales + (nbProcessus + 1) * sizeof(uint64_t);
+        }
+        return entete;
+    }
+
+    // valeurs accumulées par colonne avant chaque écriture
+    constexpr size_t TAILLE_TAMPON = 1 << 16;
+
+    /**
+     * vrai si le processus i forme un processus valide, vérifié comme une ligne de trace texte
+     * (voir analyserLigneTrace) ; ses E/S, rangées par paires (restant, durée), sont remises dans
+     * rafales en rafales alternées : (r1, d1), (r2, d2)... deviennent duree - r1, d1, r1 - r2, d2,
+     * ..., rk. Les positions des pids et des E/S sont déjà vérifiées par projeterTraceBinaire.
+     */
+    bool processusValide(const TP::ColonnesTrace& c, size_t i, vector<int32_t>& rafales) {
+        if (c.pid[i] >= c.nbNoms || c.arrivee[i] < 0 || c.duree[i] <= 0 || c.priorite[i] < 0 || c.type[i] > 3
+            || (c.echeance != nullptr && c.echeance[i] < 0)) {
+            return false;
+        }
+        rafales.clear();
+        if (c.debutsRafales != nullptr && c.debutsRafales[i] < c.debutsRafales[i + 1]) {
+            int64_t restant = c.duree[i];
+            for (uint64_t k = c.debutsRafales[i]; k < c.debutsRafales[i + 1]; k += 2) {
+                int64_t processeur = restant - c.rafales[k];
+                if (processeur <= 0 || processeur > INT32_MAX) {
+                    return false;
+                }
+                rafales.push_back(static_cast<int32_t>(processeur));
+                rafales.push_back(c.rafales[k + 1]);
+                restant = c.rafales[k];
+            }
+            rafales.push_back(static_cast<int32_t>(restant));
+        }
+        return TP::TableProcessus::rafalesValides(rafales, c.duree[i]);
+    }
+
+} // namespace
+
+bool TP::estTraceBinaire(const string& chemin) {
+    ifstream fichier(chemin, ios::binary);
+    char magie[4] = {};
+    return fichier.read(magie, sizeof(magie)) && memcmp(magie, MAGIE, sizeof(MAGIE)) == 0;
+}
+
+/**
+ * @brief écrit les colonnes d'entrée de la table dans une trace binaire.
+ * @param table table à écrire ; seuls pid, arrivee, duree, priorite, type, echeance et les E/S sont
+ * conservés.
+ * @param chemin chemin du fichier à créer.
+ * @return false si le fichier ne peut pas être écrit.
+ */
+bool TP::ecrireTraceBinaire(const TableProcessus& table, const string& chemin) {
+    static_assert(endian::native == endian::little, "le format de trace binaire est petit-boutiste");
+
+    ColonnesTrace c = table.colonnes();
+    EnTeteTrace entete = preparerEnTete(c.nbProcessus, c.nbNoms, c.debutsNoms[c.nbNoms], c.debutsRafales != nullptr);
+    entete.nbValeursRafales = c.nbValeursRafales;
+
+    ofstream sortie(chemin, ios::binary | ios::trunc);
+    if (!sortie) {
+        return false;
+    }
+    ecrireBloc(sortie, 0, &entete, sizeof(entete));
+    ecrireBloc(sortie, entete.positionDebutsNoms, c.debutsNoms, (c.nbNoms + 1) * sizeof(uint64_t));
+    ecrireBloc(sortie, entete.positionOctetsNoms, c.octetsNoms, c.debutsNoms[c.nbNoms]);
+    ecrireBloc(sortie, entete.positionPid, c.pid, c.nbProcessus * sizeof(uint32_t));
+    ecrireBloc(sortie, entete.positionArrivee, c.arrivee, c.nbProcessus * sizeof(int32_t));
+    ecrireBloc(sortie, entete.positionDuree, c.duree, c.nbProcessus * sizeof(int32_t));
+    ecrireBloc(sortie, entete.positionPriorite, c.priorite, c.nbProcessus * sizeof(int32_t));
+    ecrireBloc(sortie, entete.positionType, c.type, c.nbProcessus * sizeof(uint8_t));
+    ecrireBloc(sortie, entete.positionEcheance, c.echeance, c.nbProcessus * sizeof(int32_t));
+    if (c.debutsRafales != nullptr) {
+        ecrireBloc(sortie, entete.positionDebutsRafales, c.debutsRafales, (c.nbProcessus + 1) * sizeof(uint64_t));
+        ecrireBloc(sortie, entete.positionRafales, c.rafales, c.nbValeursRafales * sizeof(int32_t));
+    }
+    return static_cast<bool>(sortie.flush());
+}
+
+// EcrivainTraceBinaire
+
+/**
+ * @brief Constructeur de l'écrivain : crée le fichier et écrit l'en-tête.
+ * @param chemin chemin du fichier à créer.
+ * @param nbProcessus nombre exact de processus qui seront ajoutés.
+ * @param octetsNoms somme exacte des longueurs de leurs pids.
+ * @param avecEntreesSorties vrai si des processus peuvent avoir des E/S.
+ * \pre nbProcessus < UINT32_MAX
+ */
+TP::EcrivainTraceBinaire::EcrivainTraceBinaire(const string& chemin, uint64_t nbProcessus, uint64_t octetsNoms,
+                                               bool avecEntreesSorties)
+    : m_sortie(chemin, ios::binary | ios::trunc),
+      m_entete(preparerEnTete(nbProcessus, nbProcessus, octetsNoms, avecEntreesSorties)), m_nbEcrits(0),
+      m_octetsNoms(octetsNoms), m_finNoms(0), m_nbValeursRafales(0) {
+    static_assert(endian::native == endian::little, "le format de trace binaire est petit-boutiste");
+    PRECONDITION(nbProcessus < UINT32_MAX);
+
+    m_debutsNoms.position = m_entete.positionDebutsNoms;
+    m_noms.position = m_entete.positionOctetsNoms;
+    m_pid.position = m_entete.positionPid;
+    m_arrivee.position = m_entete.positionArrivee;
+    m_duree.position = m_entete.positionDuree;
+    m_priorite.position = m_entete.positionPriorite;
+    m_type.position = m_entete.positionType;
+    m_echeance.position = m_entete.positionEcheance;
+    m_debutsRafales.position = m_entete.positionDebutsRafales;
+    m_rafales.position = m_entete.positionRafales;
+    if (m_sortie) {
+        ecrireBloc(m_sortie, 0, &m_entete, sizeof(m_entete));
+    }
+    ajouterValeur(m_debutsNoms, uint64_t(0));
+    if (avecEntreesSorties) {
+        ajouterValeur(m_debutsRafales, uint64_t(0));
+    }
+}
+
+/**
+ * @brief ajoute le processus suivant.
+ * \pre moins de nbProcessus processus ont déjà été ajoutés
+ * \pre rafales est vide, ou l'écrivain a été créé avec ses E/S et TableProcessus::rafalesValides(rafales, duree)
+ */
+void TP::EcrivainTraceBinaire::ajouter(string_view pid, int arrivee, int duree, int priorite, TypeProcessus type,
+                                       int echeance, span<const int32_t> rafales) {
+    PRECONDITION(m_nbEcrits < m_entete.nbProcessus);
+    PRECONDITION(m_finNoms + pid.size() <= m_octetsNoms);
+    PRECONDITION(rafales.empty() || (m_entete.positionDebutsRafales != 0 && TableProcessus::rafalesValides(rafales, duree)));
+
+    for (char c : pid) {
+        ajouterValeur(m_noms, c);
+    }
+    m_finNoms += pid.size();
+    ajouterValeur(m_debutsNoms, m_finNoms);
+    ajouterValeur(m_pid, static_cast<uint32_t>(m_nbEcrits));
+    ajouterValeur(m_arrivee, static_cast<int32_t>(arrivee));
+    ajouterValeur(m_duree, static_cast<int32_t>(duree));
+    ajouterValeur(m_priorite, static_cast<int32_t>(priorite));
+    ajouterValeur(m_type, static_cast<uint8_t>(type));
+    ajouterValeur(m_echeance, static_cast<int32_t>(echeance));
+    if (m_entete.positionDebutsRafales != 0) {
+        m_entreesSorties.clear();
+        TableProcessus::convertirRafales(rafales, duree, m_entreesSorties);
+        for (int32_t valeur : m_entreesSorties) {
+            ajouterValeur(m_rafales, valeur);
+        }
+        m_nbValeursRafales += m_entreesSorties.size();
+        ajouterValeur(m_debutsRafales, m_nbValeursRafales);
+    }
+    ++m_nbEcrits;
+}
+
+bool TP::EcrivainTraceBinaire::terminer() {
+    vider(m_debutsNoms);
+    vider(m_noms);
+    vider(m_pid);
+    vider(m_arrivee);
+    vider(m_duree);
+    vider(m_priorite);
+    vider(m_type);
+    vider(m_echeance);
+    vider(m_debutsRafales);
+    vider(m_rafales);
+    m_entete.nbValeursRafales = m_nbValeursRafales;
+    if (m_sortie) {
+        ecrireBloc(m_sortie, 0, &m_entete, sizeof(m_entete));
+    }
+    return m_sortie.flush() && m_nbEcrits == m_entete.nbProcessus && m_finNoms == m_octetsNoms;
+}
+
+template<typename T>
+void TP::EcrivainTraceBinaire::ajouterValeur(Tampon<T>& tampon, const T& valeur) {
+    tampon.valeurs.push_back(valeur);
+    if (tampon.valeurs.size() == TAILLE_TAMPON) {
+        vider(tampon);
+    }
+}
+
+template<typename T>
+void TP::EcrivainTraceBinaire::vider(Tampon<T>& tampon) {
+    if (m_sortie && !tampon.valeurs.empty()) {
+        ecrireBloc(m_sortie, tampon.position, tampon.valeurs.data(), tampon.valeurs.size() * sizeof(T));
+    }
+    tampon.position += tampon.valeurs.size() * sizeof(T);
+    tampon.valeurs.clear();
+}
+
+/**
+ * @brief projette une trace binaire et vérifie que ses colonnes tiennent dans le fichier, et que
+ * les positions des pids et des E/S croissent ; les processus eux-mêmes ne sont pas vérifiés.
+ * @param chemin chemin de la trace binaire.
+ * @param fichier reçoit la projection, que les colonnes supposent vivante.
+ * @param c reçoit les colonnes, qui pointent dans la projection.
+ * @param erreur raison de l'échec, le cas échéant.
+ * @return false si le fichier est absent, tronqué ou d'une version inconnue.
+ */
+bool TP::projeterTraceBinaire(const string& chemin, shared_ptr<const FichierMappe>& fichier, ColonnesTrace& c,
+                              string& erreur) {
+    auto projection = make_shared<FichierMappe>(chemin);
+    fichier = projection;
+    if (!projection->estOuvert()) {
+        erreur = "impossible d'ouvrir le fichier";
+        return false;
+    }
+
+    size_t taille = projection->taille();
+    const char* base = projection->donnees();
+    EnTeteTrace entete{};
+    if (taille < TAILLE_EN_TETE_V1) {
+        erreur = "en-tete tronque";
+        return false;
+    }
+    memcpy(&entete, base, TAILLE_EN_TETE_V1);
+    if (memcmp(entete.magie, MAGIE, sizeof(MAGIE)) != 0) {
+        erreur = "signature invalide";
+        return false;
+    }
+    if (entete.version < 1 || entete.version > VERSION_TRACE_BINAIRE) {
+        erreur = "version " + to_string(entete.version) + " non prise en charge";
+        return false;
+    }
+    if (entete.version >= 2) {
+        size_t tailleEnTete = entete.version == 2 ? TAILLE_EN_TETE_V2 : sizeof(entete);
+        if (taille < tailleEnTete) {
+            erreur = "en-tete tronque";
+            return false;
+        }
+        memcpy(&entete, base, tailleEnTete);
+    }
+
+    uint64_t n = entete.nbProcessus;
+    if (n >= UINT32_MAX || entete.nbNoms >= UINT32_MAX
+        || !blocValide<uint64_t>(entete.positionDebutsNoms, entete.nbNoms + 1, taille)
+        || !blocValide<uint32_t>(entete.positionPid, n, taille)
+        || !blocValide<int32_t>(entete.positionArrivee, n, taille)
+        || !blocValide<int32_t>(entete.positionDuree, n, taille)
+        || !blocValide<int32_t>(entete.positionPriorite, n, taille)
+        || !blocValide<uint8_t>(entete.positionType, n, taille)
+        || (entete.version >= 2 && !blocValide<int32_t>(entete.positionEcheance, n, taille))
+        || (entete.positionDebutsRafales != 0
+            && (!blocValide<uint64_t>(entete.positionDebutsRafales, n + 1, taille)
+                || !blocValide<int32_t>(entete.positionRafales, entete.nbValeursRafales, taille)))) {
+        erreur = "colonnes hors du fichier ou mal alignees";
+        return false;
+    }
+
+    c = ColonnesTrace{};
+    c.nbProcessus = n;
+    c.nbNoms = entete.nbNoms;
+    c.debutsNoms = reinterpret_cast<const uint64_t*>(base + entete.positionDebutsNoms);
+    c.octetsNoms = base + entete.positionOctetsNoms;
+    c.pid = reinterpret_cast<const uint32_t*>(base + entete.positionPid);
+    c.arrivee = reinterpret_cast<const int32_t*>(base + entete.positionArrivee);
+    c.duree = reinterpret_cast<const int32_t*>(base + entete.positionDuree);
+    c.priorite = reinterpret_cast<const int32_t*>(base + entete.positionPriorite);
+    c.type = reinterpret_cast<const uint8_t*>(base + entete.positionType);
+    c.echeance = entete.version >= 2 ? reinterpret_cast<const int32_t*>(base + entete.positionEcheance) : nullptr;
+    bool nomsValides = c.debutsNoms[0] == 0 && blocValide<char>(entete.positionOctetsNoms, c.debutsNoms[c.nbNoms], taille);
+    for (uint64_t k = 0; k < c.nbNoms && nomsValides; ++k) {
+        nomsValides = c.debutsNoms[k] <= c.debutsNoms[k + 1];
+    }
+    if (!nomsValides) {
+        erreur = "table des pids invalide";
+        return false;
+    }
+    if (entete.positionDebutsRafales != 0) {
+        c.nbValeursRafales = entete.nbValeursRafales;
+        c.debutsRafales = reinterpret_cast<const uint64_t*>(base + entete.positionDebutsRafales);
+        c.rafales = reinterpret_cast<const int32_t*>(base + entete.positionRafales);
+        // chaque processus lit ses E/S entre deux positions : elles doivent croître par paires
+        bool valides = c.debutsRafales[0] == 0 && c.debutsRafales[n] == c.nbValeursRafales;
+        for (uint64_t i = 0; i < n && valides; ++i) {
+            valides = c.debutsRafales[i] <= c.debutsRafales[i + 1] && (c.debutsRafales[i + 1] - c.debutsRafales[i]) % 2 == 0;
+        }
+        if (!valides) {
+            erreur = "positions des entrees-sorties invalides";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TP::chargerTraceBinaire(const string& chemin, TableProcessus& table, string& erreur) {
+    shared_ptr<const FichierMappe> fichier;
+    ColonnesTrace c;
+    if (!projeterTraceBinaire(chemin, fichier, c, erreur)) {
+        return false;
+    }
+    // la table emprunte les colonnes telles quelles : un seul processus invalide rejette la trace
+    vector<int32_t> rafales;
+    for (size_t i = 0; i < c.nbProcessus; ++i) {
+        if (!processusValide(c, i, rafales)) {
+            erreur = "processus " + to_string(i) + " invalide";
+            return false;
+        }
+    }
+    table.emprunter(std::move(fichier), c);
+    return true;
+}
+
+// SourceTraceBinaire
+
+/**
+ * @brief Constructeur de la source binaire ; la trace est projetée, pas chargée.
+ * @param chemin chemin de la trace binaire.
+ * @param erreurs flux où sont rapportés les processus invalides.
+ */
+TP::SourceTraceBinaire::SourceTraceBinaire(const string& chemin, ostream& erreurs)
+    : m_erreurs(erreurs), m_colonnes{}, m_ouverte(false), m_suivant(0), m_nbErreurs(0), m_nbHorsOrdre(0), m_derniereArrivee(0) {
+    m_ouverte = projeterTraceBinaire(chemin, m_fichier, m_colonnes, m_erreur);
+}
+
+/**
+ * @brief lit le processus suivant dans l'ordre du fichier.
+ *
+ * ses E/S, rangées dans la trace par paires (restant, durée), sont remises en rafales alternées
+ * comme celles d'une ligne de trace texte, et vérifiées de la même façon.
+ * @param processus champs du processus ; le pid pointe dans la projection, les rafales dans le
+ * tampon de la source.
+ * @return false à la fin de la trace.
+ * \pre la trace est ouverte
+ */
+bool TP::SourceTraceBinaire::suivant(LigneTrace& processus) {
+    PRECONDITION(m_ouverte);
+
+    const ColonnesTrace& c = m_colonnes;
+    for (; m_suivant < c.nbProcessus; ++m_suivant) {
+        size_t i = m_suivant;
+        if (!lire(i, processus)) {
+            ++m_nbErreurs;
+            m_erreurs << "processus " << i << " ignore : champs invalides\n";
+        } else if (processus.arrivee < m_derniereArrivee) {
+            ++m_nbHorsOrdre;
+            m_erreurs << "processus " << i << " ignore : arrivee " << processus.arrivee << " avant "
+                      << m_derniereArrivee << " (la trace doit etre triee par arrivee)\n";
+        } else {
+            ++m_suivant;
+            m_derniereArrivee = processus.arrivee;
+            return true;
+        }
+    }
+    return false;
+}
+
+// champs du processus i, false s'ils ne forment pas un processus valide
+bool TP::SourceTraceBinaire::lire(size_t i, LigneTrace& processus) {
+    const ColonnesTrace& c = m_colonnes;
+    if (!processusValide(c, i, m_rafales)) {
+        return false;
+    }
+    uint32_t nom = c.pid[i];
+    processus.pid = string_view(c.octetsNoms + c.debutsNoms[nom], c.debutsNoms[nom + 1] - c.debutsNoms[nom]);
+    processus.arrivee = c.arrivee[i];
+    processus.duree = c.duree[i];
+    processus.priorite = c.priorite[i];
+    processus.type = static_cast<TypeProcessus>(c.type[i]);
+    processus.echeance = c.echeance != nullptr ? c.echeance[i] : 0;
+    processus.rafales = m_rafales;
+    return true;
+}
@@ -0,0 +1,181 @@
+#include "Flux.h"
+#include "TableProcessus.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+// TraceBinaire.h
+#ifndef TRACEBINAIRE_H
+#define TRACEBINAIRE_H
+
+namespace TP {
+
+    class FichierMappe;
+
+    /**
+     * @brief en-tête d'une trace binaire en colonnes (format petit-boutiste).
+     *
+     * <pre>
+     * EnTeteTrace
+     * uint64_t debutsNoms[nbNoms + 1]   positions des pids dans octetsNoms
+     * char     octetsNoms[...]          pids distincts mis bout à bout
+     * uint32_t pid[nbProcessus]         numéro du pid de chaque processus
+     * int32_t  arrivee[nbProcessus]
+     * int32_t  duree[nbProcessus]
+     * int32_t  priorite[nbProcessus]
+     * uint8_t  type[nbProcessus]        TypeProcessus, de 0 à 3
+     * int32_t  echeance[nbProcessus]    délai relatif à l'arrivée, 0 sans échéance (version 2)
+     * uint64_t debutsRafales[nbProcessus + 1]  positions dans rafales (version 3, trace avec E/S)
+     * int32_t  rafales[nbValeursRafales]       E/S de chaque processus (version 3, trace avec E/S)
+     * </pre>
+     * chaque bloc commence à une position alignée sur 8 octets, donnée dans l'en-tête. L'en-tête
+     * de la version 1 s'arrête avant positionEcheance ; ses processus n'ont pas d'échéance. Celui
+     * de la version 2 s'arrête avant nbValeursRafales ; ses processus n'ont pas d'E/S, comme ceux
+     * d'une version 3 dont positionDebutsRafales vaut 0. Chaque E/S tient en deux valeurs : le
+     * temps processeur restant quand elle commence, puis sa durée (TableProcessus::entreesSorties).
+     */
+    struct EnTeteTrace {
+        char magie[4];              // "PSSB"
+        uint32_t version;           // VERSION_TRACE_BINAIRE
+        uint64_t nbProcessus;
+        uint64_t nbNoms;
+        uint64_t positionDebutsNoms;
+        uint64_t positionOctetsNoms;
+        uint64_t positionPid;
+        uint64_t positionArrivee;
+        uint64_t positionDuree;
+        uint64_t positionPriorite;
+        uint64_t positionType;
+        uint64_t positionEcheance;
+        uint64_t nbValeursRafales;
+        uint64_t positionDebutsRafales; // 0 si la trace n'a pas d'E/S
+        uint64_t positionRafales;
+    };
+
+    constexpr uint32_t VERSION_TRACE_BINAIRE = 3;
+    constexpr size_t TAILLE_EN_TETE_V1 = offsetof(EnTeteTrace, positionEcheance);
+    constexpr size_t TAILLE_EN_TETE_V2 = offsetof(EnTeteTrace, nbValeursRafales);
+
+    // vrai si le fichier commence par la signature d'une trace binaire
+    bool estTraceBinaire(const string& chemin);
+
+    // écrit les colonnes d'entrée de la table dans une trace binaire
+    bool ecrireTraceBinaire(const TableProcessus& table, const string& chemin);
+
+    /**
+     * @brief écrit une trace binaire processus par processus, en mémoire constante.
+     *
+     * le nombre de processus et la longueur totale des pids sont donnés d'avance : la position
+     * de chaque colonne est alors connue et chacune est remplie par son propre tampon. Chaque
+     * pid doit être distinct (un nom par processus), comme ceux d'un générateur de charge. Les
+     * E/S, dont le nombre n'est pas connu d'avance, forment le dernier bloc ; l'en-tête est
+     * réécrit à la fin avec leur compte.
+     */
+    class EcrivainTraceBinaire {
+    public:
+        // avecEntreesSorties : réserve les blocs des E/S, sans quoi aucun processus ne peut en avoir
+        EcrivainTraceBinaire(const string& chemin, uint64_t nbProcessus, uint64_t octetsNoms,
+                             bool avecEntreesSorties = false);
+
+        bool estOuvert() const { return static_cast<bool>(m_sortie); }
+
+        // rafales : au format de TableProcessus::ajouter, vide pour une seule rafale
+        void ajouter(string_view pid, int arrivee, int duree, int priorite, TypeProcessus type, int echeance = 0,
+                     span<const int32_t> rafales = {});
+
+        // vide les tampons ; false si l'écriture a échoué ou si le compte annoncé n'est pas atteint
+        bool terminer();
+
+    private:
+        // tampon d'une colonne et position où il sera écrit dans le fichier
+        template<typename T>
+        struct Tampon {
+            vector<T> valeurs;
+            uint64_t position = 0;
+        };
+
+        template<typename T>
+        void ajouterValeur(Tampon<T>& tampon, const T& valeur);
+        template<typename T>
+        void vider(Tampon<T>& tampon);
+
+        ofstream m_sortie;
+        EnTeteTrace m_entete;
+        uint64_t m_nbEcrits;
+        uint64_t m_octetsNoms;       // longueur totale annoncée des pids
+        uint64_t m_finNoms;          // position de fin du dernier pid dans octetsNoms
+        Tampon<uint64_t> m_debutsNoms;
+        Tampon<char> m_noms;
+        Tampon<uint32_t> m_pid;
+        Tampon<int32_t> m_arrivee;
+        Tampon<int32_t> m_duree;
+        Tampon<int32_t> m_priorite;
+        Tampon<uint8_t> m_type;
+        Tampon<int32_t> m_echeance;
+        Tampon<uint64_t> m_debutsRafales;
+        Tampon<int32_t> m_rafales;
+        uint64_t m_nbValeursRafales;
+        vector<int32_t> m_entreesSorties;    // E/S du processus en cours d'ajout
+    };
+
+    /**
+     * @brief projette une trace binaire en mémoire et prête ses colonnes à la table, sans copie.
+     * les versions 1 à 3 sont lues.
+     * @param chemin chemin de la trace binaire.
+     * @param table table qui emprunte les colonnes ; elle garde la projection vivante.
+     * @param erreur raison de l'échec, le cas échéant.
+     * @return false si le fichier est absent, tronqué, d'une version inconnue ou si un processus
+     * est invalide.
+     */
+    bool chargerTraceBinaire(const string& chemin, TableProcessus& table, string& erreur);
+
+    // projette une trace binaire et en valide les blocs ; les colonnes pointent dans fichier
+    bool projeterTraceBinaire(const string& chemin, shared_ptr<const FichierMappe>& fichier, ColonnesTrace& colonnes,
+                              string& erreur);
+
+    /**
+     * @brief lit une trace binaire processus par processus pour le mode flux.
+     *
+     * la trace est projetée en mémoire sans être chargée dans une table : seules les pages des
+     * processus déjà lus sont touchées. Les processus invalides sont rapportés sur le flux
+     * d'erreurs avec leur rang dans la trace, puis ignorés, comme ceux dont l'arrivée précède
+     * celle du dernier processus gardé (voir SourceTexte).
+     */
+    class SourceTraceBinaire : public SourceProcessus {
+    public:
+        SourceTraceBinaire(const string& chemin, ostream& erreurs);
+
+        // faux si la trace n'a pas pu être projetée ; la cause est dans erreur()
+        bool estOuverte() const { return m_ouverte; }
+        const string& erreur() const { return m_erreur; }
+
+        bool suivant(LigneTrace& processus) override;
+
+        size_t nbErreurs() const { return m_nbErreurs; }
+        size_t nbHorsOrdre() const { return m_nbHorsOrdre; }
+
+    private:
+        bool lire(size_t i, LigneTrace& processus);
+
+        ostream& m_erreurs;
+        shared_ptr<const FichierMappe> m_fichier;  // garde la projection des colonnes vivante
+        ColonnesTrace m_colonnes;
+        bool m_ouverte;
+        string m_erreur;
+        vector<int32_t> m_rafales;  // tampon réutilisé d'un processus à l'autre
+        size_t m_suivant;           // rang du prochain processus à lire
+        size_t m_nbErreurs;
+        size_t m_nbHorsOrdre;
+        int m_derniereArrivee;
+    };
+
+} // namespace TP
+
+#endif // TRACEBINAIRE_H
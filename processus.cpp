@@ -1,5 +1,6 @@
 #include "processus.h"
 #include "ContratException.h"
+#include "ContratModule.h"
 
 /**
  * @brief Constructeur de la classe Processus.
@@ -40,7 +41,7 @@ Processus::Processus(const string& pid, int arrivee, int duree, int priorite, Ty
  * @brief Retourne l'identifiant du processus.
  * \return L'identifiant du processus.
  */
-string Processus::getPid() const {
+const string& Processus::getPid() const {
     return m_pid;
 }
 
@@ -21,7 +21,7 @@ private:
     int m_duree;        // durée d'exécution initiale du processus
     int m_restant;      // temps restant à exécuter
     int m_attente;      // temps d'attente cumulé
-    int m_fin;          // temps à la préhémption pour l'algorithme de tourniquet
+    int m_fin;          // instant de terminaison
     int m_priorite;     // priorité du processus
     TypeProcessus m_type; // type du processus pour multiniveaux
 
@@ -32,7 +32,7 @@ public:
     void verifieInvariant() const;
 
     // Accesseurs
-    string getPid() const;
+    const string& getPid() const;
     int getArrivee() const;
     int getDuree() const;
     int getRestant() const;